@@ -0,0 +1,651 @@
+#ifndef AGREGADOS_H
+#define AGREGADOS_H
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @file Agregados.h
+ * @brief Kernels de agregación sobre bloques contiguos de lecturas
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Suma, media, mínimo/máximo con índice, varianza y conteo sobre umbral
+ * para arreglos de float e int. En x86-64 se elige en tiempo de ejecución
+ * entre rutas AVX2, SSE2 y escalar; en otras arquitecturas solo existe la
+ * ruta escalar. Los bloques de menos de 8 valores (por ejemplo los nodos
+ * de ListaSensor, que entregan bloques de 1) se resuelven en línea sin
+ * pasar por el despacho.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SISTEMAIOT_SIMD_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SISTEMAIOT_OBJETIVO_AVX2
+#else
+#define SISTEMAIOT_OBJETIVO_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+/**
+ * @enum NivelSimd
+ * @brief Conjunto de instrucciones usado por los kernels
+ */
+enum NivelSimd {
+    SIMD_ESCALAR = 0, ///< Bucles escalares portables
+    SIMD_SSE2 = 1,    ///< Vectores de 128 bits (base de x86-64)
+    SIMD_AVX2 = 2     ///< Vectores de 256 bits
+};
+
+/**
+ * @struct ExtremoIndice
+ * @brief Valor extremo (mínimo o máximo) y su primera posición
+ * @tparam T Tipo de las lecturas
+ */
+template <typename T>
+struct ExtremoIndice {
+    T valor;     ///< Valor encontrado
+    int indice;  ///< Índice de la primera aparición (-1 si el bloque está vacío)
+};
+
+/**
+ * @struct Momentos
+ * @brief Conteo, media y suma de cuadrados de desviaciones (M2)
+ *
+ * Se combinan entre bloques con la fórmula de Chan, de modo que la
+ * varianza de un historial por bloques no necesita una segunda pasada.
+ */
+struct Momentos {
+    long long cantidad; ///< Número de valores
+    double media;       ///< Media de los valores
+    double m2;          ///< Suma de (x - media)^2
+
+    /**
+     * @brief Incorpora los momentos de otro bloque
+     * @param otro Momentos del bloque a combinar
+     */
+    void combinar(const Momentos& otro) {
+        if (otro.cantidad == 0) return;
+        if (cantidad == 0) { *this = otro; return; }
+        long long total = cantidad + otro.cantidad;
+        double delta = otro.media - media;
+        media += delta * otro.cantidad / total;
+        m2 += otro.m2 + delta * delta * (static_cast<double>(cantidad) * otro.cantidad / total);
+        cantidad = total;
+    }
+
+    /**
+     * @brief Varianza poblacional
+     * @return M2 / n, o 0 si no hay valores
+     */
+    double varianza() const { return cantidad > 0 ? m2 / cantidad : 0.0; }
+};
+
+namespace agregados_detalle {
+
+    // ---------------------------------------------------------------
+    // Rutas escalares
+    // ---------------------------------------------------------------
+
+    template <typename T, typename Acumulador>
+    inline Acumulador sumaEscalar(const T* datos, int n) {
+        Acumulador suma = 0;
+        for (int i = 0; i < n; i++) suma += datos[i];
+        return suma;
+    }
+
+    template <typename T>
+    inline T minimoEscalar(const T* datos, int n) {
+        T minimo = datos[0];
+        for (int i = 1; i < n; i++) if (datos[i] < minimo) minimo = datos[i];
+        return minimo;
+    }
+
+    template <typename T>
+    inline T maximoEscalar(const T* datos, int n) {
+        T maximo = datos[0];
+        for (int i = 1; i < n; i++) if (datos[i] > maximo) maximo = datos[i];
+        return maximo;
+    }
+
+    template <typename T>
+    inline int contarMayoresEscalar(const T* datos, int n, T umbral) {
+        int cuenta = 0;
+        for (int i = 0; i < n; i++) cuenta += datos[i] > umbral ? 1 : 0;
+        return cuenta;
+    }
+
+    template <typename T>
+    inline double desviacionesEscalar(const T* datos, int n, double media) {
+        double m2 = 0.0;
+        for (int i = 0; i < n; i++) {
+            double d = static_cast<double>(datos[i]) - media;
+            m2 += d * d;
+        }
+        return m2;
+    }
+
+    inline double sumaFloatEscalar(const float* d, int n) { return sumaEscalar<float, double>(d, n); }
+    inline long long sumaIntEscalar(const int* d, int n) { return sumaEscalar<int, long long>(d, n); }
+    inline float minFloatEscalar(const float* d, int n) { return minimoEscalar(d, n); }
+    inline int minIntEscalar(const int* d, int n) { return minimoEscalar(d, n); }
+    inline float maxFloatEscalar(const float* d, int n) { return maximoEscalar(d, n); }
+    inline int maxIntEscalar(const int* d, int n) { return maximoEscalar(d, n); }
+    inline int contarFloatEscalar(const float* d, int n, float u) { return contarMayoresEscalar(d, n, u); }
+    inline int contarIntEscalar(const int* d, int n, int u) { return contarMayoresEscalar(d, n, u); }
+    inline double desvFloatEscalar(const float* d, int n, double m) { return desviacionesEscalar(d, n, m); }
+    inline double desvIntEscalar(const int* d, int n, double m) { return desviacionesEscalar(d, n, m); }
+
+    /**
+     * @brief Cuenta los bits encendidos de una máscara de comparación
+     */
+    inline int contarBits(unsigned int mascara) {
+        int cuenta = 0;
+        while (mascara != 0) {
+            mascara &= mascara - 1;
+            cuenta++;
+        }
+        return cuenta;
+    }
+
+#ifdef SISTEMAIOT_SIMD_X86
+
+    // ---------------------------------------------------------------
+    // Rutas SSE2 (siempre disponibles en x86-64)
+    // ---------------------------------------------------------------
+
+    inline double sumaHorizontal(__m128d v) {
+        double partes[2];
+        _mm_storeu_pd(partes, v);
+        return partes[0] + partes[1];
+    }
+
+    inline double sumaFloatSse2(const float* d, int n) {
+        __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(d + i);
+            a0 = _mm_add_pd(a0, _mm_cvtps_pd(v));
+            a1 = _mm_add_pd(a1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+        return sumaHorizontal(_mm_add_pd(a0, a1)) + sumaFloatEscalar(d + i, n - i);
+    }
+
+    inline long long sumaIntSse2(const int* d, int n) {
+        __m128i acumulado = _mm_setzero_si128();
+        const __m128i cero = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+            __m128i signo = _mm_cmpgt_epi32(cero, v);
+            acumulado = _mm_add_epi64(acumulado, _mm_unpacklo_epi32(v, signo));
+            acumulado = _mm_add_epi64(acumulado, _mm_unpackhi_epi32(v, signo));
+        }
+        long long partes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(partes), acumulado);
+        return partes[0] + partes[1] + sumaIntEscalar(d + i, n - i);
+    }
+
+    inline float minFloatSse2(const float* d, int n) {
+        if (n < 4) return minFloatEscalar(d, n);
+        __m128 m = _mm_loadu_ps(d);
+        int i = 4;
+        for (; i + 4 <= n; i += 4) m = _mm_min_ps(m, _mm_loadu_ps(d + i));
+        float partes[4];
+        _mm_storeu_ps(partes, m);
+        float r = minFloatEscalar(partes, 4);
+        if (i < n) { float resto = minFloatEscalar(d + i, n - i); if (resto < r) r = resto; }
+        return r;
+    }
+
+    inline float maxFloatSse2(const float* d, int n) {
+        if (n < 4) return maxFloatEscalar(d, n);
+        __m128 m = _mm_loadu_ps(d);
+        int i = 4;
+        for (; i + 4 <= n; i += 4) m = _mm_max_ps(m, _mm_loadu_ps(d + i));
+        float partes[4];
+        _mm_storeu_ps(partes, m);
+        float r = maxFloatEscalar(partes, 4);
+        if (i < n) { float resto = maxFloatEscalar(d + i, n - i); if (resto > r) r = resto; }
+        return r;
+    }
+
+    inline __m128i seleccionarSse2(__m128i mascara, __m128i si, __m128i no) {
+        return _mm_or_si128(_mm_and_si128(mascara, si), _mm_andnot_si128(mascara, no));
+    }
+
+    inline int minIntSse2(const int* d, int n) {
+        if (n < 4) return minIntEscalar(d, n);
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+        int i = 4;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+            m = seleccionarSse2(_mm_cmplt_epi32(v, m), v, m);
+        }
+        int partes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(partes), m);
+        int r = minIntEscalar(partes, 4);
+        if (i < n) { int resto = minIntEscalar(d + i, n - i); if (resto < r) r = resto; }
+        return r;
+    }
+
+    inline int maxIntSse2(const int* d, int n) {
+        if (n < 4) return maxIntEscalar(d, n);
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+        int i = 4;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+            m = seleccionarSse2(_mm_cmpgt_epi32(v, m), v, m);
+        }
+        int partes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(partes), m);
+        int r = maxIntEscalar(partes, 4);
+        if (i < n) { int resto = maxIntEscalar(d + i, n - i); if (resto > r) r = resto; }
+        return r;
+    }
+
+    inline int contarFloatSse2(const float* d, int n, float u) {
+        __m128 umbral = _mm_set1_ps(u);
+        int cuenta = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            cuenta += contarBits(static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(d + i), umbral))));
+        }
+        return cuenta + contarFloatEscalar(d + i, n - i, u);
+    }
+
+    inline int contarIntSse2(const int* d, int n, int u) {
+        __m128i umbral = _mm_set1_epi32(u);
+        int cuenta = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+            cuenta += contarBits(static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, umbral)))));
+        }
+        return cuenta + contarIntEscalar(d + i, n - i, u);
+    }
+
+    inline double desvFloatSse2(const float* d, int n, double media) {
+        __m128d m = _mm_set1_pd(media), a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(d + i);
+            __m128d x0 = _mm_sub_pd(_mm_cvtps_pd(v), m);
+            __m128d x1 = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), m);
+            a0 = _mm_add_pd(a0, _mm_mul_pd(x0, x0));
+            a1 = _mm_add_pd(a1, _mm_mul_pd(x1, x1));
+        }
+        return sumaHorizontal(_mm_add_pd(a0, a1)) + desvFloatEscalar(d + i, n - i, media);
+    }
+
+    inline double desvIntSse2(const int* d, int n, double media) {
+        __m128d m = _mm_set1_pd(media), a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+            __m128d x0 = _mm_sub_pd(_mm_cvtepi32_pd(v), m);
+            __m128d x1 = _mm_sub_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))), m);
+            a0 = _mm_add_pd(a0, _mm_mul_pd(x0, x0));
+            a1 = _mm_add_pd(a1, _mm_mul_pd(x1, x1));
+        }
+        return sumaHorizontal(_mm_add_pd(a0, a1)) + desvIntEscalar(d + i, n - i, media);
+    }
+
+    // ---------------------------------------------------------------
+    // Rutas AVX2 (se usan solo si la CPU las soporta)
+    // ---------------------------------------------------------------
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline double sumaHorizontalAvx(__m256d v) {
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        double partes[2];
+        _mm_storeu_pd(partes, s);
+        return partes[0] + partes[1];
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline double sumaFloatAvx2(const float* d, int n) {
+        __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            a0 = _mm256_add_pd(a0, _mm256_cvtps_pd(_mm_loadu_ps(d + i)));
+            a1 = _mm256_add_pd(a1, _mm256_cvtps_pd(_mm_loadu_ps(d + i + 4)));
+        }
+        return sumaHorizontalAvx(_mm256_add_pd(a0, a1)) + sumaFloatEscalar(d + i, n - i);
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline long long sumaIntAvx2(const int* d, int n) {
+        __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i))));
+            a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i + 4))));
+        }
+        long long partes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(partes), _mm256_add_epi64(a0, a1));
+        return partes[0] + partes[1] + partes[2] + partes[3] + sumaIntEscalar(d + i, n - i);
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline float minFloatAvx2(const float* d, int n) {
+        if (n < 8) return minFloatEscalar(d, n);
+        __m256 m = _mm256_loadu_ps(d);
+        int i = 8;
+        for (; i + 8 <= n; i += 8) m = _mm256_min_ps(m, _mm256_loadu_ps(d + i));
+        float partes[8];
+        _mm256_storeu_ps(partes, m);
+        float r = minFloatEscalar(partes, 8);
+        if (i < n) { float resto = minFloatEscalar(d + i, n - i); if (resto < r) r = resto; }
+        return r;
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline float maxFloatAvx2(const float* d, int n) {
+        if (n < 8) return maxFloatEscalar(d, n);
+        __m256 m = _mm256_loadu_ps(d);
+        int i = 8;
+        for (; i + 8 <= n; i += 8) m = _mm256_max_ps(m, _mm256_loadu_ps(d + i));
+        float partes[8];
+        _mm256_storeu_ps(partes, m);
+        float r = maxFloatEscalar(partes, 8);
+        if (i < n) { float resto = maxFloatEscalar(d + i, n - i); if (resto > r) r = resto; }
+        return r;
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline int minIntAvx2(const int* d, int n) {
+        if (n < 8) return minIntEscalar(d, n);
+        __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d));
+        int i = 8;
+        for (; i + 8 <= n; i += 8) m = _mm256_min_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i)));
+        int partes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(partes), m);
+        int r = minIntEscalar(partes, 8);
+        if (i < n) { int resto = minIntEscalar(d + i, n - i); if (resto < r) r = resto; }
+        return r;
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline int maxIntAvx2(const int* d, int n) {
+        if (n < 8) return maxIntEscalar(d, n);
+        __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d));
+        int i = 8;
+        for (; i + 8 <= n; i += 8) m = _mm256_max_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i)));
+        int partes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(partes), m);
+        int r = maxIntEscalar(partes, 8);
+        if (i < n) { int resto = maxIntEscalar(d + i, n - i); if (resto > r) r = resto; }
+        return r;
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline int contarFloatAvx2(const float* d, int n, float u) {
+        __m256 umbral = _mm256_set1_ps(u);
+        int cuenta = 0, i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 mayor = _mm256_cmp_ps(_mm256_loadu_ps(d + i), umbral, _CMP_GT_OQ);
+            cuenta += contarBits(static_cast<unsigned int>(_mm256_movemask_ps(mayor)));
+        }
+        return cuenta + contarFloatEscalar(d + i, n - i, u);
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline int contarIntAvx2(const int* d, int n, int u) {
+        __m256i umbral = _mm256_set1_epi32(u);
+        int cuenta = 0, i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i mayor = _mm256_cmpgt_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i)), umbral);
+            cuenta += contarBits(static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(mayor))));
+        }
+        return cuenta + contarIntEscalar(d + i, n - i, u);
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline double desvFloatAvx2(const float* d, int n, double media) {
+        __m256d m = _mm256_set1_pd(media), a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256d x0 = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(d + i)), m);
+            __m256d x1 = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(d + i + 4)), m);
+            a0 = _mm256_add_pd(a0, _mm256_mul_pd(x0, x0));
+            a1 = _mm256_add_pd(a1, _mm256_mul_pd(x1, x1));
+        }
+        return sumaHorizontalAvx(_mm256_add_pd(a0, a1)) + desvFloatEscalar(d + i, n - i, media);
+    }
+
+    SISTEMAIOT_OBJETIVO_AVX2 inline double desvIntAvx2(const int* d, int n, double media) {
+        __m256d m = _mm256_set1_pd(media), a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256d x0 = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i))), m);
+            __m256d x1 = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i + 4))), m);
+            a0 = _mm256_add_pd(a0, _mm256_mul_pd(x0, x0));
+            a1 = _mm256_add_pd(a1, _mm256_mul_pd(x1, x1));
+        }
+        return sumaHorizontalAvx(_mm256_add_pd(a0, a1)) + desvIntEscalar(d + i, n - i, media);
+    }
+
+    /**
+     * @brief Detecta si la CPU y el sistema operativo soportan AVX2
+     */
+    inline bool cpuSoportaAvx2() {
+#if defined(_MSC_VER)
+        int registros[4];
+        __cpuid(registros, 1);
+        bool osxsave = (registros[2] & (1 << 27)) != 0;
+        bool avx = (registros[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) return false;
+        if ((_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(registros, 7, 0);
+        return (registros[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+#endif // SISTEMAIOT_SIMD_X86
+
+    /**
+     * @struct TablaKernels
+     * @brief Punteros a los kernels del nivel SIMD activo
+     */
+    struct TablaKernels {
+        NivelSimd nivel;
+        double (*sumaFloat)(const float*, int);
+        long long (*sumaInt)(const int*, int);
+        float (*minFloat)(const float*, int);
+        int (*minInt)(const int*, int);
+        float (*maxFloat)(const float*, int);
+        int (*maxInt)(const int*, int);
+        int (*contarFloat)(const float*, int, float);
+        int (*contarInt)(const int*, int, int);
+        double (*desvFloat)(const float*, int, double);
+        double (*desvInt)(const int*, int, double);
+    };
+
+    /**
+     * @brief Nivel más alto soportado por la máquina actual
+     */
+    inline NivelSimd nivelSoportado() {
+#ifdef SISTEMAIOT_SIMD_X86
+        static const NivelSimd nivel = cpuSoportaAvx2() ? SIMD_AVX2 : SIMD_SSE2;
+        return nivel;
+#else
+        return SIMD_ESCALAR;
+#endif
+    }
+
+    /**
+     * @brief Construye la tabla de kernels para un nivel
+     */
+    inline TablaKernels tablaPara(NivelSimd nivel) {
+        TablaKernels t = { SIMD_ESCALAR,
+                           sumaFloatEscalar, sumaIntEscalar, minFloatEscalar, minIntEscalar,
+                           maxFloatEscalar, maxIntEscalar, contarFloatEscalar, contarIntEscalar,
+                           desvFloatEscalar, desvIntEscalar };
+#ifdef SISTEMAIOT_SIMD_X86
+        if (nivel >= SIMD_AVX2 && nivelSoportado() >= SIMD_AVX2) {
+            TablaKernels avx = { SIMD_AVX2,
+                                 sumaFloatAvx2, sumaIntAvx2, minFloatAvx2, minIntAvx2,
+                                 maxFloatAvx2, maxIntAvx2, contarFloatAvx2, contarIntAvx2,
+                                 desvFloatAvx2, desvIntAvx2 };
+            t = avx;
+        } else if (nivel >= SIMD_SSE2) {
+            TablaKernels sse = { SIMD_SSE2,
+                                 sumaFloatSse2, sumaIntSse2, minFloatSse2, minIntSse2,
+                                 maxFloatSse2, maxIntSse2, contarFloatSse2, contarIntSse2,
+                                 desvFloatSse2, desvIntSse2 };
+            t = sse;
+        }
+#else
+        (void)nivel;
+#endif
+        return t;
+    }
+
+    /**
+     * @brief Tabla activa (se inicializa con el mejor nivel disponible)
+     */
+    inline TablaKernels& tablaActiva() {
+        static TablaKernels tabla = tablaPara(nivelSoportado());
+        return tabla;
+    }
+
+    // Sobrecargas para que Agregados sea genérica sobre float/int
+    inline double sumar(const float* d, int n) { return tablaActiva().sumaFloat(d, n); }
+    inline long long sumar(const int* d, int n) { return tablaActiva().sumaInt(d, n); }
+    inline float minimo(const float* d, int n) { return tablaActiva().minFloat(d, n); }
+    inline int minimo(const int* d, int n) { return tablaActiva().minInt(d, n); }
+    inline float maximo(const float* d, int n) { return tablaActiva().maxFloat(d, n); }
+    inline int maximo(const int* d, int n) { return tablaActiva().maxInt(d, n); }
+    inline int contarMayores(const float* d, int n, float u) { return tablaActiva().contarFloat(d, n, u); }
+    inline int contarMayores(const int* d, int n, int u) { return tablaActiva().contarInt(d, n, u); }
+    inline double desviaciones(const float* d, int n, double m) { return tablaActiva().desvFloat(d, n, m); }
+    inline double desviaciones(const int* d, int n, double m) { return tablaActiva().desvInt(d, n, m); }
+
+    /**
+     * @brief Tipo de acumulador de la suma: double para float, 64 bits para int
+     */
+    template <typename T> struct Acumulador { typedef double tipo; };
+    template <> struct Acumulador<int> { typedef long long tipo; };
+
+} // namespace agregados_detalle
+
+/**
+ * @class Agregados
+ * @brief Interfaz pública de los kernels de agregación
+ *
+ * Todas las funciones aceptan float o int. Los bloques pequeños (menos de
+ * 8 valores) se procesan con el bucle escalar en línea.
+ */
+class Agregados {
+    private:
+        static const int umbralVectorial = 8; ///< Tamaño mínimo para usar el despacho SIMD
+
+    public:
+        /**
+         * @brief Suma de un bloque
+         * @return Suma en double (float) o en 64 bits (int), sin desbordes
+         */
+        template <typename T>
+        static typename agregados_detalle::Acumulador<T>::tipo suma(const T* datos, int n) {
+            if (n < umbralVectorial) {
+                return agregados_detalle::sumaEscalar<T, typename agregados_detalle::Acumulador<T>::tipo>(datos, n);
+            }
+            return agregados_detalle::sumar(datos, n);
+        }
+
+        /**
+         * @brief Media de un bloque
+         * @return Media aritmética, o 0 si n == 0
+         */
+        template <typename T>
+        static double media(const T* datos, int n) {
+            return n > 0 ? static_cast<double>(suma(datos, n)) / n : 0.0;
+        }
+
+        /**
+         * @brief Mínimo de un bloque
+         * @pre n > 0
+         */
+        template <typename T>
+        static T minimo(const T* datos, int n) {
+            return n < umbralVectorial ? agregados_detalle::minimoEscalar(datos, n)
+                                       : agregados_detalle::minimo(datos, n);
+        }
+
+        /**
+         * @brief Máximo de un bloque
+         * @pre n > 0
+         */
+        template <typename T>
+        static T maximo(const T* datos, int n) {
+            return n < umbralVectorial ? agregados_detalle::maximoEscalar(datos, n)
+                                       : agregados_detalle::maximo(datos, n);
+        }
+
+        /**
+         * @brief Mínimo de un bloque y su primera posición
+         * @pre n > 0 para obtener un índice válido
+         */
+        template <typename T>
+        static ExtremoIndice<T> minimoConIndice(const T* datos, int n) {
+            ExtremoIndice<T> r = { T(), -1 };
+            if (n <= 0) return r;
+            r.valor = n < umbralVectorial ? agregados_detalle::minimoEscalar(datos, n)
+                                          : agregados_detalle::minimo(datos, n);
+            for (r.indice = 0; r.indice < n - 1 && datos[r.indice] != r.valor; r.indice++) {}
+            return r;
+        }
+
+        /**
+         * @brief Máximo de un bloque y su primera posición
+         * @pre n > 0 para obtener un índice válido
+         */
+        template <typename T>
+        static ExtremoIndice<T> maximoConIndice(const T* datos, int n) {
+            ExtremoIndice<T> r = { T(), -1 };
+            if (n <= 0) return r;
+            r.valor = n < umbralVectorial ? agregados_detalle::maximoEscalar(datos, n)
+                                          : agregados_detalle::maximo(datos, n);
+            for (r.indice = 0; r.indice < n - 1 && datos[r.indice] != r.valor; r.indice++) {}
+            return r;
+        }
+
+        /**
+         * @brief Conteo de valores estrictamente mayores que un umbral
+         */
+        template <typename T>
+        static int contarMayoresQue(const T* datos, int n, T umbral) {
+            if (n < umbralVectorial) return agregados_detalle::contarMayoresEscalar(datos, n, umbral);
+            return agregados_detalle::contarMayores(datos, n, umbral);
+        }
+
+        /**
+         * @brief Momentos (n, media, M2) de un bloque, combinables entre bloques
+         */
+        template <typename T>
+        static Momentos momentos(const T* datos, int n) {
+            Momentos m = { n, media(datos, n), 0.0 };
+            if (n == 0) return m;
+            m.m2 = n < umbralVectorial ? agregados_detalle::desviacionesEscalar(datos, n, m.media)
+                                       : agregados_detalle::desviaciones(datos, n, m.media);
+            return m;
+        }
+
+        /**
+         * @brief Varianza poblacional de un bloque
+         */
+        template <typename T>
+        static double varianza(const T* datos, int n) { return momentos(datos, n).varianza(); }
+
+        /**
+         * @brief Nivel SIMD que están usando los kernels
+         */
+        static NivelSimd nivelActivo() { return agregados_detalle::tablaActiva().nivel; }
+
+        /**
+         * @brief Fuerza un nivel SIMD (limitado a lo que soporta la CPU)
+         * @param nivel Nivel deseado; útil para comparar rutas en benchmarks
+         * @return Nivel que quedó activo
+         */
+        static NivelSimd forzarNivel(NivelSimd nivel) {
+            agregados_detalle::tablaActiva() = agregados_detalle::tablaPara(nivel);
+            return nivelActivo();
+        }
+};
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef ARCHIVOMAPEADO_H
+#define ARCHIVOMAPEADO_H
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file ArchivoMapeado.h
+ * @brief Archivo proyectado en memoria de solo lectura
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Win32 (CreateFileMapping/MapViewOfFile) y POSIX (mmap). El sistema
+ * carga las páginas al primer acceso, así que abrir un archivo grande
+ * cuesta lo mismo que uno pequeño.
+ *
+ * También reúne lo necesario para reemplazar un archivo sin que una
+ * caída lo deje a medias: forzar a disco su contenido y el directorio
+ * que lo contiene, y renombrar encima del anterior.
+ */
+
+/**
+ * @class ArchivoMapeado
+ * @brief Proyección de solo lectura de un archivo completo
+ *
+ * No se puede copiar: quienes lean de la proyección la comparten con
+ * std::shared_ptr para que siga viva mientras alguien la use.
+ */
+class ArchivoMapeado {
+    private:
+        const unsigned char* datos; ///< Inicio de la proyección (nullptr si no está abierta)
+        std::size_t tamanio;        ///< Bytes proyectados
+#ifdef _WIN32
+        HANDLE archivo;             ///< Archivo abierto
+        HANDLE proyeccion;          ///< Objeto de proyección
+#endif
+
+        ArchivoMapeado(const ArchivoMapeado&);
+        ArchivoMapeado& operator=(const ArchivoMapeado&);
+
+    public:
+        /**
+         * @brief Constructor, sin archivo proyectado
+         */
+#ifdef _WIN32
+        ArchivoMapeado() : datos(nullptr), tamanio(0), archivo(INVALID_HANDLE_VALUE), proyeccion(nullptr) {}
+#else
+        ArchivoMapeado() : datos(nullptr), tamanio(0) {}
+#endif
+
+        /**
+         * @brief Destructor, libera la proyección
+         */
+        ~ArchivoMapeado() { cerrar(); }
+
+        /**
+         * @brief Proyecta un archivo completo
+         * @param ruta Ruta del archivo
+         * @return true si quedó proyectado (un archivo vacío no se puede proyectar)
+         */
+        bool abrir(const char* ruta) {
+            cerrar();
+#ifdef _WIN32
+            archivo = CreateFileA(ruta, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (archivo == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER bytes;
+            if (!GetFileSizeEx(archivo, &bytes) || bytes.QuadPart == 0) {
+                cerrar();
+                return false;
+            }
+            proyeccion = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (proyeccion == nullptr) {
+                cerrar();
+                return false;
+            }
+            void* vista = MapViewOfFile(proyeccion, FILE_MAP_READ, 0, 0, 0);
+            if (vista == nullptr) {
+                cerrar();
+                return false;
+            }
+            datos = static_cast<const unsigned char*>(vista);
+            tamanio = static_cast<std::size_t>(bytes.QuadPart);
+#else
+            int fd = ::open(ruta, O_RDONLY);
+            if (fd < 0) return false;
+            struct stat info;
+            if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+                ::close(fd);
+                return false;
+            }
+            void* vista = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // la proyección sigue vigente sin el descriptor
+            if (vista == MAP_FAILED) return false;
+            datos = static_cast<const unsigned char*>(vista);
+            tamanio = static_cast<std::size_t>(info.st_size);
+#endif
+            return true;
+        }
+
+        /**
+         * @brief Libera la proyección
+         */
+        void cerrar() {
+#ifdef _WIN32
+            if (datos != nullptr) UnmapViewOfFile(datos);
+            if (proyeccion != nullptr) CloseHandle(proyeccion);
+            if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+            proyeccion = nullptr;
+            archivo = INVALID_HANDLE_VALUE;
+#else
+            if (datos != nullptr) munmap(const_cast<unsigned char*>(datos), tamanio);
+#endif
+            datos = nullptr;
+            tamanio = 0;
+        }
+
+        /**
+         * @brief Inicio de los bytes proyectados
+         */
+        const unsigned char* obtenerDatos() const { return datos; }
+
+        /**
+         * @brief Número de bytes proyectados
+         */
+        std::size_t obtenerTamanio() const { return tamanio; }
+};
+
+/**
+ * @brief Fuerza a disco el contenido de un archivo ya escrito
+ * @param ruta Ruta del archivo
+ * @return true si el sistema confirmó la escritura
+ *
+ * Se usa con archivos escritos con std::ofstream, que no expone su
+ * descriptor: el archivo se vuelve a abrir solo para sincronizarlo.
+ */
+inline bool sincronizarArchivo(const char* ruta) {
+#ifdef _WIN32
+    HANDLE archivo = CreateFileA(ruta, GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (archivo == INVALID_HANDLE_VALUE) return false;
+    bool sincronizado = FlushFileBuffers(archivo) != 0;
+    CloseHandle(archivo);
+    return sincronizado;
+#else
+    int fd = ::open(ruta, O_WRONLY);
+    if (fd < 0) return false;
+    bool sincronizado = ::fsync(fd) == 0;
+    ::close(fd);
+    return sincronizado;
+#endif
+}
+
+/**
+ * @brief Fuerza a disco el directorio que contiene un archivo
+ * @param ruta Ruta del archivo recién creado o renombrado
+ * @return true si el sistema confirmó la escritura
+ *
+ * En POSIX crear o renombrar un archivo solo modifica el directorio; sin
+ * esto el archivo puede desaparecer tras una caída aunque su contenido ya
+ * esté en disco. Windows no permite sincronizar un directorio y no hace
+ * nada (ver reemplazarArchivo()).
+ */
+inline bool sincronizarDirectorioDe(const char* ruta) {
+#ifdef _WIN32
+    (void)ruta;
+    return true;
+#else
+    std::string directorio(ruta);
+    std::string::size_type barra = directorio.find_last_of('/');
+    if (barra == std::string::npos) {
+        directorio = ".";
+    } else {
+        directorio.erase(barra == 0 ? 1 : barra);
+    }
+    int fd = ::open(directorio.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool sincronizado = ::fsync(fd) == 0;
+    ::close(fd);
+    return sincronizado;
+#endif
+}
+
+#ifdef _WIN32
+const bool REEMPLAZO_EXIGE_SOLTAR = true;  ///< Windows no reemplaza un archivo que sigue proyectado
+#else
+const bool REEMPLAZO_EXIGE_SOLTAR = false; ///< POSIX renombra encima aunque siga proyectado
+#endif
+
+/**
+ * @brief Reemplaza un archivo por otro ya escrito y sincronizado
+ * @param temporal Archivo nuevo, ya forzado a disco con sincronizarArchivo()
+ * @param ruta Archivo a reemplazar (puede no existir)
+ * @return true si el reemplazo quedó en disco
+ * @pre Si REEMPLAZO_EXIGE_SOLTAR, ruta no está proyectado en ningún ArchivoMapeado
+ *
+ * POSIX renombra (atómico) y sincroniza el directorio; las proyecciones
+ * del archivo anterior siguen leyendo el contenido viejo. Windows usa
+ * MoveFileEx con MOVEFILE_WRITE_THROUGH, que no vuelve hasta que el
+ * renombrado está en disco, pero falla si el destino sigue proyectado.
+ */
+inline bool reemplazarArchivo(const char* temporal, const char* ruta) {
+#ifdef _WIN32
+    return MoveFileExA(temporal, ruta, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return ::rename(temporal, ruta) == 0 && sincronizarDirectorioDe(ruta);
+#endif
+}
+
+#endif
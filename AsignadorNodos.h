@@ -0,0 +1,238 @@
+#ifndef ASIGNADORNODOS_H
+#define ASIGNADORNODOS_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * @file AsignadorNodos.h
+ * @brief Políticas de asignación de memoria para los nodos de las listas
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Una política de asignación expone:
+ * - `N* reservar()`: entrega un nodo construido por valor
+ * - `void liberar(N*)`: destruye y devuelve un nodo individual
+ * - `void liberarTodo()`: devuelve de golpe toda la memoria restante
+ * - `liberacionMasiva`: true si liberarTodo() libera también los nodos
+ *   que no se devolvieron con liberar()
+ * - `void intercambiar(A&)`: intercambia toda la memoria con otro asignador
+ * - `void absorber(A&)`: se queda con la memoria de otro asignador, de
+ *   modo que los nodos que este entregó pasan a ser de aquel
+ */
+
+/**
+ * @class AsignadorHeap
+ * @brief Política que usa new/delete por cada nodo (comportamiento original)
+ * @tparam N Tipo de nodo a asignar
+ */
+template <typename N>
+class AsignadorHeap {
+    public:
+        static const bool liberacionMasiva = false; ///< Cada nodo debe liberarse por separado
+
+        /**
+         * @brief Reserva un nodo nuevo en el heap
+         * @return Puntero al nodo inicializado por valor
+         */
+        N* reservar() { return new N(); }
+
+        /**
+         * @brief Libera un nodo individual
+         * @param nodo Nodo a liberar
+         */
+        void liberar(N* nodo) { delete nodo; }
+
+        /**
+         * @brief No hace nada: los nodos se liberaron uno a uno
+         */
+        void liberarTodo() {}
+
+        /**
+         * @brief Intercambia el estado con otro asignador (sin estado)
+         */
+        void intercambiar(AsignadorHeap<N>&) {}
+
+        /**
+         * @brief No hace nada: cada nodo es dueño de su propia memoria
+         */
+        void absorber(AsignadorHeap<N>&) {}
+};
+
+/**
+ * @class AsignadorPool
+ * @brief Pool de nodos que reparte memoria desde losas (slabs) grandes
+ * @tparam N Tipo de nodo a asignar
+ *
+ * Los nodos se toman de losas contiguas cuyo tamaño crece al doble
+ * (de 16 hasta 4096 nodos), de modo que una lista corta no desperdicia
+ * memoria y una larga hace pocas llamadas a malloc. Los nodos liberados
+ * se reciclan mediante una lista libre y al destruir el pool se
+ * devuelven las losas completas, sin recorrer nodo por nodo.
+ *
+ * Copiar un pool produce un pool vacío: cada lista es dueña de sus losas.
+ */
+template <typename N>
+class AsignadorPool {
+    private:
+        /**
+         * @brief Ranura de una losa: almacena un nodo o un enlace libre
+         */
+        union Ranura {
+            Ranura* siguiente; ///< Siguiente ranura libre o losa anterior
+            typename std::aligned_storage<sizeof(N), std::alignment_of<N>::value>::type espacio; ///< Memoria para el nodo
+        };
+
+        static const std::size_t capacidadInicial = 16;   ///< Nodos de la primera losa
+        static const std::size_t capacidadMaxima = 4096;  ///< Tope de nodos por losa
+
+        Ranura* losas;          ///< Última losa reservada (la ranura 0 enlaza con la anterior)
+        Ranura* primeraLosa;    ///< Losa más antigua, final de la cadena de losas
+        Ranura* libres;         ///< Lista de ranuras recicladas
+        Ranura* cursor;         ///< Siguiente ranura sin usar de la losa actual
+        Ranura* fin;            ///< Fin de la losa actual
+        std::size_t siguienteCapacidad; ///< Capacidad de la próxima losa
+
+        /**
+         * @brief Reserva una losa nueva y la deja como losa actual
+         */
+        void nuevaLosa() {
+            Ranura* losa = new Ranura[siguienteCapacidad + 1];
+            losa[0].siguiente = losas;
+            if (losas == nullptr) primeraLosa = losa;
+            losas = losa;
+            cursor = losa + 1;
+            fin = losa + 1 + siguienteCapacidad;
+            if (siguienteCapacidad < capacidadMaxima) {
+                siguienteCapacidad *= 2;
+            }
+        }
+
+    public:
+        static const bool liberacionMasiva = std::is_trivially_destructible<N>::value; ///< liberarTodo() basta si N no tiene destructor
+
+        /**
+         * @brief Constructor por defecto
+         * @post Pool vacío, sin losas reservadas
+         */
+        AsignadorPool()
+            : losas(nullptr), primeraLosa(nullptr), libres(nullptr), cursor(nullptr), fin(nullptr),
+              siguienteCapacidad(capacidadInicial) {}
+
+        /**
+         * @brief Constructor de copia
+         * @post Crea un pool vacío e independiente
+         */
+        AsignadorPool(const AsignadorPool<N>&)
+            : losas(nullptr), primeraLosa(nullptr), libres(nullptr), cursor(nullptr), fin(nullptr),
+              siguienteCapacidad(capacidadInicial) {}
+
+        /**
+         * @brief Operador de asignación
+         * @return Referencia a este pool, que conserva sus propias losas
+         */
+        AsignadorPool<N>& operator=(const AsignadorPool<N>&) { return *this; }
+
+        /**
+         * @brief Destructor, devuelve todas las losas
+         */
+        ~AsignadorPool() { liberarTodo(); }
+
+        /**
+         * @brief Entrega un nodo inicializado por valor
+         * @return Puntero al nodo
+         *
+         * Reutiliza primero las ranuras recicladas y después las de la losa
+         * actual; solo llama a new cuando ambas se agotan.
+         */
+        N* reservar() {
+            Ranura* ranura;
+            if (libres != nullptr) {
+                ranura = libres;
+                libres = libres->siguiente;
+            } else {
+                if (cursor == fin) {
+                    nuevaLosa();
+                }
+                ranura = cursor++;
+            }
+            return new (&ranura->espacio) N();
+        }
+
+        /**
+         * @brief Devuelve un nodo a la lista libre
+         * @param nodo Nodo previamente entregado por reservar()
+         */
+        void liberar(N* nodo) {
+            nodo->~N();
+            Ranura* ranura = reinterpret_cast<Ranura*>(nodo);
+            ranura->siguiente = libres;
+            libres = ranura;
+        }
+
+        /**
+         * @brief Libera todas las losas de una sola vez
+         * @post El pool queda vacío; los nodos entregados dejan de ser válidos
+         */
+        void liberarTodo() {
+            while (losas != nullptr) {
+                Ranura* anterior = losas[0].siguiente;
+                delete[] losas;
+                losas = anterior;
+            }
+            primeraLosa = nullptr;
+            libres = nullptr;
+            cursor = nullptr;
+            fin = nullptr;
+            siguienteCapacidad = capacidadInicial;
+        }
+
+        /**
+         * @brief Intercambia todas las losas con otro pool
+         * @param otro Pool con el que se intercambia el estado
+         */
+        void intercambiar(AsignadorPool<N>& otro) {
+            Ranura* r;
+            r = losas; losas = otro.losas; otro.losas = r;
+            r = primeraLosa; primeraLosa = otro.primeraLosa; otro.primeraLosa = r;
+            r = libres; libres = otro.libres; otro.libres = r;
+            r = cursor; cursor = otro.cursor; otro.cursor = r;
+            r = fin; fin = otro.fin; otro.fin = r;
+            std::size_t c = siguienteCapacidad;
+            siguienteCapacidad = otro.siguienteCapacidad;
+            otro.siguienteCapacidad = c;
+        }
+
+        /**
+         * @brief Toma las losas de otro pool sin copiar ni mover nodos
+         * @param otro Pool cuyas losas pasan a este
+         * @post otro queda vacío; sus nodos siguen válidos y ahora los
+         *       libera este pool
+         *
+         * Es O(1): la cadena de losas de otro se engancha delante de la
+         * propia. Las ranuras libres y el resto de la losa actual de otro
+         * se aprovechan solo si este pool no tiene las suyas; si no,
+         * quedan sin usar hasta liberarTodo().
+         */
+        void absorber(AsignadorPool<N>& otro) {
+            if (this == &otro || otro.losas == nullptr) return;
+            otro.primeraLosa[0].siguiente = losas;
+            if (losas == nullptr) primeraLosa = otro.primeraLosa;
+            losas = otro.losas;
+            if (libres == nullptr) libres = otro.libres;
+            if (cursor == fin) {
+                cursor = otro.cursor;
+                fin = otro.fin;
+            }
+            if (otro.siguienteCapacidad > siguienteCapacidad) siguienteCapacidad = otro.siguienteCapacidad;
+            otro.losas = nullptr;
+            otro.primeraLosa = nullptr;
+            otro.libres = nullptr;
+            otro.cursor = nullptr;
+            otro.fin = nullptr;
+            otro.siguienteCapacidad = capacidadInicial;
+        }
+};
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef BITACORA_H
+#define BITACORA_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+/**
+ * @file Bitacora.h
+ * @brief Mensajes de diagnóstico con niveles y destino intercambiable
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Los contenedores y sensores no escriben en std::cout: emiten mensajes
+ * con las macros IOT_DEPURACION, IOT_INFO, IOT_ADVERTENCIA e IOT_ERROR.
+ *
+ * - En compilación, SISTEMAIOT_NIVEL_BITACORA (0 = depuración ... 4 =
+ *   apagada) elimina por completo las llamadas de nivel inferior.
+ * - En ejecución, Bitacora::establecerNivel() filtra los mensajes
+ *   restantes antes de formatearlos.
+ * - El destino es un SumideroBitacora: SumideroConsola escribe en el
+ *   momento y SumideroAsincrono acumula en memoria y escribe desde un
+ *   hilo propio.
+ *
+ * Ejemplo: IOT_DEPURACION("Nodo insertado: " << valor);
+ */
+
+#define IOT_NIVEL_DEPURACION 0
+#define IOT_NIVEL_INFO 1
+#define IOT_NIVEL_ADVERTENCIA 2
+#define IOT_NIVEL_ERROR 3
+#define IOT_NIVEL_APAGADA 4
+
+#ifndef SISTEMAIOT_NIVEL_BITACORA
+#define SISTEMAIOT_NIVEL_BITACORA IOT_NIVEL_DEPURACION
+#endif
+
+/**
+ * @enum NivelBitacora
+ * @brief Severidad de un mensaje (mismos valores que las macros IOT_NIVEL_*)
+ */
+enum NivelBitacora {
+    BITACORA_DEPURACION = IOT_NIVEL_DEPURACION,   ///< Detalle por nodo o por lectura
+    BITACORA_INFO = IOT_NIVEL_INFO,               ///< Eventos de sensores y conexiones
+    BITACORA_ADVERTENCIA = IOT_NIVEL_ADVERTENCIA, ///< Situaciones recuperables
+    BITACORA_ERROR = IOT_NIVEL_ERROR,             ///< Fallos
+    BITACORA_APAGADA = IOT_NIVEL_APAGADA          ///< No se emite nada
+};
+
+/**
+ * @class SumideroBitacora
+ * @brief Destino de los mensajes ya formateados
+ *
+ * escribir() puede llamarse desde varios hilos a la vez; cada
+ * implementación se encarga de su propia sincronización.
+ */
+class SumideroBitacora {
+    public:
+        virtual ~SumideroBitacora() {}
+
+        /**
+         * @brief Recibe un mensaje completo
+         * @param nivel Severidad
+         * @param texto Caracteres del mensaje (sin salto de línea)
+         * @param longitud Número de caracteres
+         */
+        virtual void escribir(NivelBitacora nivel, const char* texto, std::size_t longitud) = 0;
+
+        /**
+         * @brief Espera a que todo lo recibido esté escrito en su destino
+         */
+        virtual void vaciar() {}
+};
+
+/**
+ * @class SumideroConsola
+ * @brief Escribe cada mensaje en un ostream (std::cout por defecto)
+ *
+ * Termina cada mensaje con '\n' sin forzar el vaciado; std::cin está
+ * ligado a std::cout, así que todo se muestra antes de pedir entrada.
+ */
+class SumideroConsola : public SumideroBitacora {
+    private:
+        std::ostream& salida; ///< Stream destino
+        std::mutex candado;   ///< Evita mezclar mensajes de distintos hilos
+
+    public:
+        /**
+         * @brief Constructor
+         * @param destino Stream donde se escriben los mensajes
+         */
+        explicit SumideroConsola(std::ostream& destino = std::cout) : salida(destino) {}
+
+        void escribir(NivelBitacora, const char* texto, std::size_t longitud) override {
+            std::lock_guard<std::mutex> guarda(candado);
+            salida.write(texto, static_cast<std::streamsize>(longitud));
+            salida.put('\n');
+        }
+
+        void vaciar() override {
+            std::lock_guard<std::mutex> guarda(candado);
+            salida.flush();
+        }
+};
+
+/**
+ * @class SumideroAsincrono
+ * @brief Acumula mensajes en memoria y los escribe desde un hilo propio
+ *
+ * El hilo que emite solo copia el texto a un buffer bajo un mutex; el
+ * hilo escritor intercambia ese buffer por uno vacío y lo escribe de una
+ * sola vez. El escritor despierta cuando el buffer pasa de UMBRAL_BYTES,
+ * cada 50 ms si hay algo pendiente, o cuando alguien llama a vaciar().
+ * Si el buffer supera limiteBytes los mensajes se descartan y se
+ * cuentan, para que un destino lento no haga crecer la memoria.
+ */
+class SumideroAsincrono : public SumideroBitacora {
+    public:
+        static const std::size_t UMBRAL_BYTES = 32 * 1024; ///< Pendiente que despierta al escritor
+
+    private:
+        std::ostream& salida;          ///< Stream destino (solo lo usa el hilo escritor)
+        std::size_t limiteBytes;       ///< Tamaño máximo del buffer pendiente
+        std::mutex candado;            ///< Protege pendiente, escribiendo y terminar
+        std::condition_variable hayDatos;  ///< Despierta al hilo escritor
+        std::condition_variable vaciado;   ///< Avisa que el buffer quedó escrito
+        std::string pendiente;         ///< Mensajes aún no escritos
+        bool escribiendo;              ///< El hilo escritor tiene un lote en curso
+        bool urgente;                  ///< vaciar() espera: escribir aunque no se llegue al umbral
+        bool terminar;                 ///< Solicitud de paro
+        std::atomic<long> descartados; ///< Mensajes perdidos por buffer lleno
+        std::thread hilo;              ///< Hilo escritor
+
+        SumideroAsincrono(const SumideroAsincrono&);            ///< No copiable
+        SumideroAsincrono& operator=(const SumideroAsincrono&); ///< No asignable
+
+        /**
+         * @brief Cuerpo del hilo escritor
+         */
+        void escribirPendientes() {
+            std::string lote;
+            std::unique_lock<std::mutex> guarda(candado);
+            while (true) {
+                hayDatos.wait_for(guarda, std::chrono::milliseconds(50), [this]() {
+                    return terminar || urgente || pendiente.size() >= UMBRAL_BYTES;
+                });
+                urgente = false;
+                if (pendiente.empty()) {
+                    if (terminar) break;
+                    continue;
+                }
+                lote.swap(pendiente);
+                escribiendo = true;
+                guarda.unlock();
+                salida.write(lote.data(), static_cast<std::streamsize>(lote.size()));
+                salida.flush();
+                lote.clear();
+                guarda.lock();
+                escribiendo = false;
+                vaciado.notify_all();
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructor, arranca el hilo escritor
+         * @param destino Stream donde se escriben los mensajes
+         * @param limite Bytes pendientes a partir de los cuales se descarta
+         */
+        explicit SumideroAsincrono(std::ostream& destino = std::cout, std::size_t limite = 8u * 1024u * 1024u)
+            : salida(destino), limiteBytes(limite), escribiendo(false), urgente(false), terminar(false), descartados(0) {
+            pendiente.reserve(2 * UMBRAL_BYTES);
+            hilo = std::thread(&SumideroAsincrono::escribirPendientes, this);
+        }
+
+        /**
+         * @brief Destructor, escribe lo pendiente y detiene el hilo
+         */
+        ~SumideroAsincrono() {
+            {
+                std::lock_guard<std::mutex> guarda(candado);
+                terminar = true;
+            }
+            hayDatos.notify_one();
+            hilo.join();
+        }
+
+        void escribir(NivelBitacora, const char* texto, std::size_t longitud) override {
+            std::lock_guard<std::mutex> guarda(candado);
+            if (pendiente.size() + longitud + 1 > limiteBytes) {
+                descartados.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            bool bajoUmbral = pendiente.size() < UMBRAL_BYTES;
+            pendiente.append(texto, longitud);
+            pendiente.push_back('\n');
+            if (bajoUmbral && pendiente.size() >= UMBRAL_BYTES) hayDatos.notify_one();
+        }
+
+        void vaciar() override {
+            std::unique_lock<std::mutex> guarda(candado);
+            urgente = true;
+            hayDatos.notify_one();
+            vaciado.wait(guarda, [this]() { return pendiente.empty() && !escribiendo; });
+        }
+
+        /**
+         * @brief Mensajes descartados por buffer lleno
+         */
+        long obtenerDescartados() const { return descartados.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @class BufferMensaje
+ * @brief streambuf sobre un arreglo fijo; lo que no cabe se recorta
+ *
+ * Permite formatear con operator<< sin asignar memoria por mensaje.
+ */
+class BufferMensaje : public std::streambuf {
+    private:
+        char datos[512]; ///< Texto del mensaje en curso
+
+    public:
+        BufferMensaje() { reiniciar(); }
+
+        /**
+         * @brief Descarta el mensaje en curso
+         */
+        void reiniciar() { setp(datos, datos + sizeof(datos)); }
+
+        /**
+         * @brief Primer carácter del mensaje
+         */
+        const char* texto() const { return pbase(); }
+
+        /**
+         * @brief Caracteres escritos en el mensaje
+         */
+        std::size_t longitud() const { return static_cast<std::size_t>(pptr() - pbase()); }
+
+    protected:
+        int_type overflow(int_type c) override {
+            return traits_type::not_eof(c); // buffer lleno: se ignora el resto
+        }
+};
+
+/**
+ * @class Bitacora
+ * @brief Estado global de la bitácora: nivel en ejecución y sumidero activo
+ */
+class Bitacora {
+    private:
+        static std::atomic<int>& nivelActual() {
+            static std::atomic<int> nivel(BITACORA_DEPURACION);
+            return nivel;
+        }
+
+        static SumideroConsola& consolaPorDefecto() {
+            static SumideroConsola consola;
+            return consola;
+        }
+
+        static std::atomic<SumideroBitacora*>& sumideroActual() {
+            static std::atomic<SumideroBitacora*> sumidero(&consolaPorDefecto());
+            return sumidero;
+        }
+
+        static SumideroBitacora*& sumideroDelHilo() {
+            static thread_local SumideroBitacora* sumidero = nullptr;
+            return sumidero;
+        }
+
+    public:
+        /**
+         * @brief Cambia el nivel mínimo que se emite en ejecución
+         * @param nivel Nivel mínimo (BITACORA_APAGADA silencia todo)
+         */
+        static void establecerNivel(NivelBitacora nivel) { nivelActual().store(nivel, std::memory_order_relaxed); }
+
+        /**
+         * @brief Obtiene el nivel mínimo en ejecución
+         */
+        static NivelBitacora obtenerNivel() { return static_cast<NivelBitacora>(nivelActual().load(std::memory_order_relaxed)); }
+
+        /**
+         * @brief Indica si un mensaje de ese nivel se emitiría
+         * @param nivel Severidad del mensaje
+         */
+        static bool habilitado(NivelBitacora nivel) { return nivel >= nivelActual().load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Cambia el destino de los mensajes
+         * @param sumidero Nuevo destino, o nullptr para volver a la consola
+         * @return Sumidero anterior (se vacía antes de reemplazarlo)
+         * @warning Quien llama conserva la propiedad del sumidero y debe
+         *          mantenerlo vivo mientras esté instalado
+         */
+        static SumideroBitacora* establecerSumidero(SumideroBitacora* sumidero) {
+            SumideroBitacora* anterior = sumideroActual().exchange(sumidero != nullptr ? sumidero : &consolaPorDefecto());
+            anterior->vaciar();
+            return anterior;
+        }
+
+        /**
+         * @brief Desvía los mensajes del hilo actual a otro sumidero
+         * @param sumidero Destino de los mensajes de este hilo, o nullptr
+         *        para volver al sumidero global
+         * @return Sumidero del hilo anterior (nullptr si usaba el global)
+         *
+         * Lo usa el procesamiento en paralelo para capturar los mensajes
+         * de cada sensor y mostrarlos después en el orden de la lista.
+         */
+        static SumideroBitacora* establecerSumideroDelHilo(SumideroBitacora* sumidero) {
+            SumideroBitacora* anterior = sumideroDelHilo();
+            sumideroDelHilo() = sumidero;
+            return anterior;
+        }
+
+        /**
+         * @brief Espera a que el sumidero activo escriba todo lo recibido
+         */
+        static void vaciar() { sumideroActual().load()->vaciar(); }
+
+        /**
+         * @brief Stream del hilo actual para formatear un mensaje
+         * @return Stream vacío, con el formato por defecto
+         */
+        static std::ostream& iniciarMensaje() {
+            static thread_local BufferMensaje buffer;
+            static thread_local std::ostream flujo(&buffer);
+            buffer.reiniciar();
+            flujo.flags(std::ios::dec | std::ios::skipws);
+            flujo.precision(6);
+            return flujo;
+        }
+
+        /**
+         * @brief Envía al sumidero el mensaje formateado en el hilo actual
+         * @param nivel Severidad del mensaje
+         * @param flujo Stream devuelto por iniciarMensaje()
+         */
+        static void emitir(NivelBitacora nivel, std::ostream& flujo) {
+            BufferMensaje* buffer = static_cast<BufferMensaje*>(flujo.rdbuf());
+            SumideroBitacora* propio = sumideroDelHilo();
+            SumideroBitacora* sumidero = propio != nullptr ? propio : sumideroActual().load();
+            sumidero->escribir(nivel, buffer->texto(), buffer->longitud());
+        }
+};
+
+/**
+ * @class SumideroInstalado
+ * @brief Instala un sumidero mientras el objeto exista (RAII)
+ *
+ * Al destruirse vacía el sumidero y restaura el anterior, de modo que el
+ * sumidero puede destruirse después sin quedar instalado.
+ */
+class SumideroInstalado {
+    private:
+        SumideroBitacora* anterior; ///< Sumidero a restaurar
+
+        SumideroInstalado(const SumideroInstalado&);            ///< No copiable
+        SumideroInstalado& operator=(const SumideroInstalado&); ///< No asignable
+
+    public:
+        /**
+         * @param sumidero Sumidero a instalar (nullptr = consola)
+         */
+        explicit SumideroInstalado(SumideroBitacora* sumidero) : anterior(Bitacora::establecerSumidero(sumidero)) {}
+
+        ~SumideroInstalado() { Bitacora::establecerSumidero(anterior); }
+};
+
+#define IOT_BITACORA(nivel, mensaje)                          \
+    do {                                                      \
+        if (Bitacora::habilitado(nivel)) {                    \
+            std::ostream& flujoBitacora_ = Bitacora::iniciarMensaje(); \
+            flujoBitacora_ << mensaje;                        \
+            Bitacora::emitir(nivel, flujoBitacora_);          \
+        }                                                     \
+    } while (0)
+
+#define IOT_DESCARTAR_BITACORA() do { } while (0)
+
+#if SISTEMAIOT_NIVEL_BITACORA <= IOT_NIVEL_DEPURACION
+#define IOT_DEPURACION(mensaje) IOT_BITACORA(BITACORA_DEPURACION, mensaje)
+#else
+#define IOT_DEPURACION(mensaje) IOT_DESCARTAR_BITACORA()
+#endif
+
+#if SISTEMAIOT_NIVEL_BITACORA <= IOT_NIVEL_INFO
+#define IOT_INFO(mensaje) IOT_BITACORA(BITACORA_INFO, mensaje)
+#else
+#define IOT_INFO(mensaje) IOT_DESCARTAR_BITACORA()
+#endif
+
+#if SISTEMAIOT_NIVEL_BITACORA <= IOT_NIVEL_ADVERTENCIA
+#define IOT_ADVERTENCIA(mensaje) IOT_BITACORA(BITACORA_ADVERTENCIA, mensaje)
+#else
+#define IOT_ADVERTENCIA(mensaje) IOT_DESCARTAR_BITACORA()
+#endif
+
+#if SISTEMAIOT_NIVEL_BITACORA <= IOT_NIVEL_ERROR
+#define IOT_ERROR(mensaje) IOT_BITACORA(BITACORA_ERROR, mensaje)
+#else
+#define IOT_ERROR(mensaje) IOT_DESCARTAR_BITACORA()
+#endif
+
+#endif
@@ -0,0 +1,409 @@
+#ifndef CODIFICACIONSERIE_H
+#define CODIFICACIONSERIE_H
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file CodificacionSerie.h
+ * @brief Codificación compacta de series de lecturas (XOR para float, delta para int,
+ *        delta de deltas para marcas de tiempo)
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Ceros a la izquierda de un valor de 32 bits distinto de 0
+ */
+inline int cerosIzquierda32(unsigned int x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clz(x);
+#else
+    int n = 0;
+    while ((x & 0x80000000u) == 0) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+/**
+ * @brief Ceros a la derecha de un valor de 32 bits distinto de 0
+ */
+inline int cerosDerecha32(unsigned int x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    int n = 0;
+    while ((x & 1u) == 0) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+/**
+ * @brief Agrega un entero con signo en zig-zag y grupos de 7 bits (varint)
+ * @param valor Valor a escribir
+ * @param salida Arreglo al que se agregan los bytes
+ *
+ * Zig-zag lleva 0, -1, 1, -2, ... a 0, 1, 2, 3, ..., así que los valores
+ * pequeños de cualquier signo ocupan un byte.
+ */
+inline void escribirVarintZigzag(long long valor, std::vector<unsigned char>& salida) {
+    unsigned long long u = static_cast<unsigned long long>(valor);
+    unsigned long long z = (u << 1) ^ (0ULL - (u >> 63));
+    while (z >= 0x80) {
+        salida.push_back(static_cast<unsigned char>(z | 0x80));
+        z >>= 7;
+    }
+    salida.push_back(static_cast<unsigned char>(z));
+}
+
+/**
+ * @brief Lee un entero escrito con escribirVarintZigzag()
+ * @param actual Siguiente byte; avanza hasta después del valor
+ * @param fin Fin de los datos
+ * @return Valor leído
+ */
+inline long long leerVarintZigzag(const unsigned char*& actual, const unsigned char* fin) {
+    unsigned long long z = 0;
+    int desplazamiento = 0;
+    while (actual < fin) {
+        unsigned char byte = *actual++;
+        z |= static_cast<unsigned long long>(byte & 0x7F) << desplazamiento;
+        if ((byte & 0x80) == 0) break;
+        desplazamiento += 7;
+    }
+    return static_cast<long long>((z >> 1) ^ (0ULL - (z & 1)));
+}
+
+/**
+ * @class EscritorBits
+ * @brief Agrega campos de 1 a 32 bits al final de un arreglo de bytes
+ */
+class EscritorBits {
+    private:
+        std::vector<unsigned char>& salida; ///< Destino
+        unsigned long long acumulado;       ///< Bits pendientes en la parte baja
+        int pendientes;                     ///< Bits pendientes (menos de 8 entre llamadas)
+
+    public:
+        /**
+         * @brief Constructor
+         * @param destino Arreglo al que se agregan los bytes
+         */
+        explicit EscritorBits(std::vector<unsigned char>& destino) : salida(destino), acumulado(0), pendientes(0) {}
+
+        /**
+         * @brief Escribe los bits bajos de un valor, el más significativo primero
+         * @param valor Valor a escribir
+         * @param bits Cantidad de bits (1 a 32)
+         */
+        void escribir(unsigned int valor, int bits) {
+            unsigned long long mascara = (1ULL << bits) - 1;
+            acumulado = (acumulado << bits) | (valor & mascara);
+            pendientes += bits;
+            while (pendientes >= 8) {
+                pendientes -= 8;
+                salida.push_back(static_cast<unsigned char>(acumulado >> pendientes));
+            }
+        }
+
+        /**
+         * @brief Completa el último byte con ceros
+         */
+        void terminar() {
+            if (pendientes > 0) {
+                salida.push_back(static_cast<unsigned char>(acumulado << (8 - pendientes)));
+                pendientes = 0;
+            }
+        }
+};
+
+/**
+ * @class LectorBits
+ * @brief Lee campos de 1 a 32 bits escritos por EscritorBits
+ */
+class LectorBits {
+    private:
+        const unsigned char* actual; ///< Siguiente byte a cargar
+        const unsigned char* fin;    ///< Fin de los datos
+        unsigned long long acumulado; ///< Bits cargados en la parte baja
+        int disponibles;             ///< Bits cargados sin leer
+
+    public:
+        /**
+         * @brief Constructor
+         * @param datos Bytes codificados
+         * @param longitud Número de bytes
+         */
+        LectorBits(const unsigned char* datos, std::size_t longitud)
+            : actual(datos), fin(datos + longitud), acumulado(0), disponibles(0) {}
+
+        /**
+         * @brief Lee un campo
+         * @param bits Cantidad de bits (1 a 32)
+         * @return Valor leído (los bits más allá del final se leen como 0)
+         */
+        unsigned int leer(int bits) {
+            while (disponibles < bits) {
+                acumulado = (acumulado << 8) | (actual < fin ? *actual++ : 0u);
+                disponibles += 8;
+            }
+            disponibles -= bits;
+            return static_cast<unsigned int>((acumulado >> disponibles) & ((1ULL << bits) - 1));
+        }
+};
+
+/**
+ * @struct CodificadorSerie
+ * @brief Codificador de bloques de lecturas según su tipo
+ * @tparam T Tipo de las lecturas (float o int)
+ *
+ * Cada especialización ofrece codificar(datos, n, salida) y un
+ * Decodificador que entrega las lecturas una por una con siguiente(),
+ * sin descomprimir el bloque completo.
+ */
+template <typename T>
+struct CodificadorSerie;
+
+/**
+ * @brief Codificación XOR tipo Gorilla para float
+ *
+ * La primera lectura se guarda completa (32 bits). Para cada una de las
+ * siguientes se hace XOR con la anterior: si es 0 (lectura repetida) se
+ * escribe un bit 0; si los bits distintos caben en la ventana de ceros
+ * de la anterior se escribe 10 y solo esos bits; si no, 11, los ceros a
+ * la izquierda (5 bits), la longitud - 1 (5 bits) y los bits distintos.
+ * Las temperaturas del ESP32 cambian poco entre lecturas, así que la
+ * mayoría ocupa de 1 a 15 bits.
+ */
+template <>
+struct CodificadorSerie<float> {
+    /**
+     * @brief Patrón de bits de un float
+     */
+    static unsigned int bitsDe(float valor) {
+        unsigned int bits;
+        std::memcpy(&bits, &valor, sizeof(bits));
+        return bits;
+    }
+
+    /**
+     * @brief Codifica un bloque de lecturas
+     * @param datos Lecturas
+     * @param n Número de lecturas (al menos 1)
+     * @param salida Arreglo al que se agregan los bytes
+     */
+    static void codificar(const float* datos, int n, std::vector<unsigned char>& salida) {
+        EscritorBits escritor(salida);
+        unsigned int anterior = bitsDe(datos[0]);
+        escritor.escribir(anterior, 32);
+        int ceroIzquierda = -1;
+        int ceroDerecha = 0;
+        for (int i = 1; i < n; i++) {
+            unsigned int actual = bitsDe(datos[i]);
+            unsigned int x = actual ^ anterior;
+            anterior = actual;
+            if (x == 0) {
+                escritor.escribir(0, 1);
+                continue;
+            }
+            int izquierda = cerosIzquierda32(x);
+            int derecha = cerosDerecha32(x);
+            if (ceroIzquierda >= 0 && izquierda >= ceroIzquierda && derecha >= ceroDerecha) {
+                escritor.escribir(2, 2);
+                escritor.escribir(x >> ceroDerecha, 32 - ceroIzquierda - ceroDerecha);
+            } else {
+                int significativos = 32 - izquierda - derecha;
+                escritor.escribir(3, 2);
+                escritor.escribir(static_cast<unsigned int>(izquierda), 5);
+                escritor.escribir(static_cast<unsigned int>(significativos - 1), 5);
+                escritor.escribir(x >> derecha, significativos);
+                ceroIzquierda = izquierda;
+                ceroDerecha = derecha;
+            }
+        }
+        escritor.terminar();
+    }
+
+    /**
+     * @class Decodificador
+     * @brief Recorre un bloque codificado lectura por lectura
+     */
+    class Decodificador {
+        private:
+            LectorBits lector;     ///< Bits del bloque
+            int restantes;         ///< Lecturas por entregar
+            bool primera;          ///< La siguiente es la primera del bloque
+            unsigned int anterior; ///< Bits de la lectura anterior
+            int ceroIzquierda;     ///< Ventana vigente: ceros a la izquierda
+            int ceroDerecha;       ///< Ventana vigente: ceros a la derecha
+
+        public:
+            /**
+             * @brief Constructor
+             * @param datos Bytes del bloque
+             * @param longitud Número de bytes
+             * @param cantidad Lecturas codificadas
+             */
+            Decodificador(const unsigned char* datos, std::size_t longitud, int cantidad)
+                : lector(datos, longitud), restantes(cantidad), primera(true), anterior(0),
+                  ceroIzquierda(0), ceroDerecha(0) {}
+
+            /**
+             * @brief Entrega la siguiente lectura
+             * @param valor Lectura decodificada
+             * @return false si ya no quedan lecturas
+             */
+            bool siguiente(float& valor) {
+                if (restantes == 0) return false;
+                restantes--;
+                if (primera) {
+                    primera = false;
+                    anterior = lector.leer(32);
+                } else if (lector.leer(1) != 0) {
+                    if (lector.leer(1) != 0) {
+                        ceroIzquierda = static_cast<int>(lector.leer(5));
+                        int significativos = static_cast<int>(lector.leer(5)) + 1;
+                        ceroDerecha = 32 - ceroIzquierda - significativos;
+                    }
+                    anterior ^= lector.leer(32 - ceroIzquierda - ceroDerecha) << ceroDerecha;
+                }
+                std::memcpy(&valor, &anterior, sizeof(valor));
+                return true;
+            }
+    };
+};
+
+/**
+ * @brief Codificación delta + zig-zag + varint para int
+ *
+ * Cada lectura se guarda como la diferencia con la anterior (la primera
+ * contra 0) con escribirVarintZigzag(). Las presiones del firmware (80 a
+ * 120 hPa) ocupan 1 byte por lectura.
+ */
+template <>
+struct CodificadorSerie<int> {
+    /**
+     * @brief Codifica un bloque de lecturas
+     * @param datos Lecturas
+     * @param n Número de lecturas
+     * @param salida Arreglo al que se agregan los bytes
+     */
+    static void codificar(const int* datos, int n, std::vector<unsigned char>& salida) {
+        long long anterior = 0;
+        for (int i = 0; i < n; i++) {
+            escribirVarintZigzag(datos[i] - anterior, salida);
+            anterior = datos[i];
+        }
+    }
+
+    /**
+     * @class Decodificador
+     * @brief Recorre un bloque codificado lectura por lectura
+     */
+    class Decodificador {
+        private:
+            const unsigned char* actual; ///< Siguiente byte
+            const unsigned char* fin;    ///< Fin del bloque
+            int restantes;               ///< Lecturas por entregar
+            long long anterior;          ///< Lectura anterior
+
+        public:
+            /**
+             * @brief Constructor
+             * @param datos Bytes del bloque
+             * @param longitud Número de bytes
+             * @param cantidad Lecturas codificadas
+             */
+            Decodificador(const unsigned char* datos, std::size_t longitud, int cantidad)
+                : actual(datos), fin(datos + longitud), restantes(cantidad), anterior(0) {}
+
+            /**
+             * @brief Entrega la siguiente lectura
+             * @param valor Lectura decodificada
+             * @return false si ya no quedan lecturas
+             */
+            bool siguiente(int& valor) {
+                if (restantes == 0) return false;
+                restantes--;
+                anterior += leerVarintZigzag(actual, fin);
+                valor = static_cast<int>(anterior);
+                return true;
+            }
+    };
+};
+
+/**
+ * @struct CodificadorMarcas
+ * @brief Delta de deltas + zig-zag + varint para marcas de tiempo en ns
+ *
+ * La primera marca se guarda completa, la segunda como diferencia con la
+ * primera y las demás como la diferencia entre su delta y el anterior.
+ * Con lecturas a ritmo constante el delta de deltas solo lleva la
+ * variación del intervalo: unos microsegundos (2 a 3 bytes) con el
+ * reloj del puerto, y 1 byte para las líneas que llegaron en la misma
+ * lectura del puerto y comparten la marca.
+ */
+struct CodificadorMarcas {
+    /**
+     * @brief Codifica un bloque de marcas
+     * @param marcas Marcas no decrecientes
+     * @param n Número de marcas
+     * @param salida Arreglo al que se agregan los bytes
+     */
+    static void codificar(const long long* marcas, int n, std::vector<unsigned char>& salida) {
+        long long anterior = 0;
+        long long deltaAnterior = 0;
+        for (int i = 0; i < n; i++) {
+            long long delta = marcas[i] - anterior;
+            escribirVarintZigzag(i == 0 ? marcas[0] : delta - deltaAnterior, salida);
+            deltaAnterior = i == 0 ? 0 : delta;
+            anterior = marcas[i];
+        }
+    }
+
+    /**
+     * @class Decodificador
+     * @brief Recorre un bloque de marcas una por una
+     */
+    class Decodificador {
+        private:
+            const unsigned char* actual; ///< Siguiente byte
+            const unsigned char* fin;    ///< Fin del bloque
+            int restantes;               ///< Marcas por entregar
+            bool primera;                ///< La siguiente es la primera del bloque
+            long long anterior;          ///< Marca anterior
+            long long deltaAnterior;     ///< Diferencia entre las dos marcas anteriores
+
+        public:
+            /**
+             * @brief Constructor
+             * @param datos Bytes del bloque
+             * @param longitud Número de bytes
+             * @param cantidad Marcas codificadas
+             */
+            Decodificador(const unsigned char* datos, std::size_t longitud, int cantidad)
+                : actual(datos), fin(datos + longitud), restantes(cantidad), primera(true), anterior(0), deltaAnterior(0) {}
+
+            /**
+             * @brief Entrega la siguiente marca
+             * @param marca Marca decodificada
+             * @return false si ya no quedan marcas
+             */
+            bool siguiente(long long& marca) {
+                if (restantes == 0) return false;
+                restantes--;
+                if (primera) {
+                    primera = false;
+                    anterior = leerVarintZigzag(actual, fin);
+                } else {
+                    deltaAnterior += leerVarintZigzag(actual, fin);
+                    anterior += deltaAnterior;
+                }
+                marca = anterior;
+                return true;
+            }
+    };
+};
+
+#endif
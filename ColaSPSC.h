@@ -0,0 +1,113 @@
+#ifndef COLASPSC_H
+#define COLASPSC_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular sin bloqueos de un productor y un consumidor
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class ColaSPSC
+ * @brief Anillo acotado para pasar elementos de un hilo a otro sin mutex
+ * @tparam T Tipo de elemento (se copia por valor; conviene que sea trivial)
+ *
+ * Solo un hilo puede llamar a intentarEncolar() y solo otro puede llamar
+ * a extraerLote(). Los índices son contadores que solo crecen y se
+ * enmascaran al acceder; cada uno vive en su propia línea de caché junto
+ * con la copia que el otro lado guarda del índice ajeno, de modo que en
+ * el caso común ninguno de los dos hilos lee la línea del otro.
+ */
+template <typename T>
+class ColaSPSC {
+    private:
+        T* elementos;           ///< Arreglo circular
+        std::size_t capacidad;  ///< Número de ranuras (potencia de 2)
+        std::size_t mascara;    ///< capacidad - 1
+
+        alignas(64) std::atomic<std::size_t> escritura; ///< Siguiente ranura a escribir (productor)
+        std::size_t lecturaVista;                       ///< Última lectura observada por el productor
+
+        alignas(64) std::atomic<std::size_t> lectura;   ///< Siguiente ranura a leer (consumidor)
+        std::size_t escrituraVista;                     ///< Última escritura observada por el consumidor
+
+        ColaSPSC(const ColaSPSC&);            ///< No copiable
+        ColaSPSC& operator=(const ColaSPSC&); ///< No asignable
+
+    public:
+        /**
+         * @brief Constructor
+         * @param capacidadMinima Elementos que debe poder contener (se redondea a potencia de 2)
+         */
+        explicit ColaSPSC(std::size_t capacidadMinima)
+            : escritura(0), lecturaVista(0), lectura(0), escrituraVista(0) {
+            capacidad = 2;
+            while (capacidad < capacidadMinima) capacidad *= 2;
+            mascara = capacidad - 1;
+            elementos = new T[capacidad];
+        }
+
+        /**
+         * @brief Destructor, libera el arreglo
+         */
+        ~ColaSPSC() { delete[] elementos; }
+
+        /**
+         * @brief Agrega un elemento (solo el hilo productor)
+         * @param elemento Elemento a copiar en la cola
+         * @return false si la cola está llena; el elemento no se agrega
+         */
+        bool intentarEncolar(const T& elemento) {
+            std::size_t e = escritura.load(std::memory_order_relaxed);
+            if (e - lecturaVista == capacidad) {
+                lecturaVista = lectura.load(std::memory_order_acquire);
+                if (e - lecturaVista == capacidad) return false;
+            }
+            elementos[e & mascara] = elemento;
+            escritura.store(e + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Extrae hasta maximo elementos (solo el hilo consumidor)
+         * @param destino Arreglo donde se copian los elementos
+         * @param maximo Capacidad de destino
+         * @return Elementos extraídos (0 si la cola está vacía)
+         */
+        std::size_t extraerLote(T* destino, std::size_t maximo) {
+            std::size_t l = lectura.load(std::memory_order_relaxed);
+            if (escrituraVista == l) {
+                escrituraVista = escritura.load(std::memory_order_acquire);
+                if (escrituraVista == l) return 0;
+            }
+            std::size_t n = escrituraVista - l;
+            if (n > maximo) n = maximo;
+            for (std::size_t i = 0; i < n; i++) {
+                destino[i] = elementos[(l + i) & mascara];
+            }
+            lectura.store(l + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         * @brief Elementos en la cola en este momento (aproximado si hay concurrencia)
+         * @return Profundidad de la cola
+         */
+        std::size_t profundidad() const {
+            std::size_t l = lectura.load(std::memory_order_acquire);
+            std::size_t e = escritura.load(std::memory_order_acquire);
+            return e - l;
+        }
+
+        /**
+         * @brief Obtiene la capacidad de la cola
+         * @return Número de ranuras
+         */
+        std::size_t obtenerCapacidad() const { return capacidad; }
+};
+
+#endif
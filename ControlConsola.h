@@ -0,0 +1,103 @@
+#ifndef CONTROLCONSOLA_H
+#define CONTROLCONSOLA_H
+
+#include <csignal>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <conio.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file ControlConsola.h
+ * @brief Detener una tarea larga con Enter o Ctrl+C sin bloquear el hilo que espera
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class InterrupcionConsola
+ * @brief Anota Ctrl+C (SIGINT) y SIGTERM mientras el objeto exista (RAII)
+ *
+ * En lugar de terminar el programa, la señal solo enciende una bandera
+ * que quien espera consulta con recibida(); así los sensores y el diario
+ * se cierran de forma ordenada. El destructor restaura los manejadores
+ * anteriores. Solo debe existir un objeto a la vez.
+ */
+class InterrupcionConsola {
+    private:
+        void (*anteriorInt)(int);  ///< Manejador de SIGINT a restaurar
+        void (*anteriorTerm)(int); ///< Manejador de SIGTERM a restaurar
+
+        InterrupcionConsola(const InterrupcionConsola&);            ///< No copiable
+        InterrupcionConsola& operator=(const InterrupcionConsola&); ///< No asignable
+
+        /**
+         * @brief Bandera compartida con el manejador de señales
+         */
+        static volatile std::sig_atomic_t& bandera() {
+            static volatile std::sig_atomic_t solicitada = 0;
+            return solicitada;
+        }
+
+        /**
+         * @brief Manejador de señales: solo enciende la bandera
+         */
+        static void anotar(int) { bandera() = 1; }
+
+    public:
+        /**
+         * @brief Instala los manejadores y apaga la bandera
+         */
+        InterrupcionConsola() {
+            bandera() = 0;
+            anteriorInt = std::signal(SIGINT, &InterrupcionConsola::anotar);
+            anteriorTerm = std::signal(SIGTERM, &InterrupcionConsola::anotar);
+        }
+
+        /**
+         * @brief Restaura los manejadores anteriores
+         */
+        ~InterrupcionConsola() {
+            std::signal(SIGINT, anteriorInt != SIG_ERR ? anteriorInt : SIG_DFL);
+            std::signal(SIGTERM, anteriorTerm != SIG_ERR ? anteriorTerm : SIG_DFL);
+        }
+
+        /**
+         * @brief Indica si llegó Ctrl+C o SIGTERM desde la construcción
+         */
+        bool recibida() const { return bandera() != 0; }
+};
+
+/**
+ * @brief Espera a que haya algo que leer en la entrada estándar
+ * @param esperaMs Tiempo máximo de espera
+ * @return true si std::cin se puede leer sin bloquear (hay una línea,
+ *         o la entrada terminó y la lectura fallará de inmediato)
+ *
+ * POSIX usa poll() sobre el descriptor 0; Windows consulta el teclado de
+ * la consola con _kbhit(). No ve lo que std::cin ya tenga en su búfer.
+ */
+inline bool hayEntradaConsola(int esperaMs) {
+#ifdef _WIN32
+    for (int esperado = 0; ; esperado += 10) {
+        if (_kbhit()) return true;
+        if (esperado >= esperaMs) return false;
+        Sleep(10);
+    }
+#else
+    struct pollfd entrada;
+    entrada.fd = STDIN_FILENO;
+    entrada.events = POLLIN;
+    entrada.revents = 0;
+    return ::poll(&entrada, 1, esperaMs) > 0;
+#endif
+}
+
+#endif
@@ -0,0 +1,571 @@
+#ifndef DIARIOLECTURAS_H
+#define DIARIOLECTURAS_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ArchivoMapeado.h"
+#include "ProtocoloESP32.h"
+#include "EnrutadorESP32.h"
+#include "RelojMonotonico.h"
+#include "Bitacora.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+/**
+ * @file DiarioLecturas.h
+ * @brief Diario de escritura anticipada (solo se agrega) de las lecturas aceptadas
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Cada lectura que la ingesta registra en un sensor se anota también en
+ * el diario, un directorio de segmentos segmento-NNNNNNNN.wal que solo
+ * crecen. Al arrancar, reproducirDiario() vuelve a registrar en la lista
+ * todas las lecturas anotadas, así que una caída solo pierde las que aún
+ * no se habían confirmado en disco.
+ *
+ * Formato de cada registro (orden de bytes de la máquina):
+ *
+ *   crc32 (4) | tipo (1) | longitudId (1) | paredNs (8) | valor (4) | id
+ *
+ * paredNs son nanosegundos desde la época Unix. Los sensores usan el
+ * reloj monotónico, que vuelve a empezar en cada arranque del equipo;
+ * por eso el diario guarda la marca en tiempo de pared y la reproducción
+ * la convierte al reloj monotónico actual.
+ *
+ * El CRC cubre todo lo que le sigue; la reproducción de un segmento se
+ * detiene en el primer registro incompleto o con CRC distinto (la
+ * escritura que estaba en curso durante la caída).
+ */
+
+/**
+ * @enum ModoDiario
+ * @brief Cuándo se fuerzan a disco las lecturas anotadas
+ */
+enum ModoDiario {
+    DIARIO_POR_REGISTRO, ///< write + fdatasync por cada lectura, en el hilo que anota
+    DIARIO_AGRUPADO      ///< Un hilo propio escribe y sincroniza lo acumulado cada intervalo
+};
+
+/**
+ * @brief CRC-32 (polinomio 0xEDB88320) de un bloque de bytes
+ * @param datos Bytes
+ * @param n Número de bytes
+ * @return CRC del bloque
+ */
+inline unsigned int crc32Diario(const unsigned char* datos, std::size_t n) {
+    struct Tabla {
+        unsigned int valores[256];
+        Tabla() {
+            for (unsigned int i = 0; i < 256; i++) {
+                unsigned int c = i;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                valores[i] = c;
+            }
+        }
+    };
+    static const Tabla tabla;
+    unsigned int crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < n; i++) crc = tabla.valores[(crc ^ datos[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Diferencia entre el reloj de pared y el monotónico
+ * @return Nanosegundos que, sumados a una marca de instanteActualNs(), dan
+ *         nanosegundos desde la época Unix
+ */
+inline long long desfaseRelojParedNs() {
+    long long pared = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return pared - instanteActualNs();
+}
+
+/**
+ * @class ArchivoDiario
+ * @brief Archivo de solo agregar con sincronización de datos a disco
+ */
+class ArchivoDiario {
+    private:
+#ifdef _WIN32
+        HANDLE archivo; ///< Archivo abierto
+#else
+        int fd;         ///< Descriptor abierto
+#endif
+
+        ArchivoDiario(const ArchivoDiario&);
+        ArchivoDiario& operator=(const ArchivoDiario&);
+
+    public:
+#ifdef _WIN32
+        ArchivoDiario() : archivo(INVALID_HANDLE_VALUE) {}
+#else
+        ArchivoDiario() : fd(-1) {}
+#endif
+        ~ArchivoDiario() { cerrar(); }
+
+        /**
+         * @brief Crea el archivo (o lo abre para agregar al final)
+         * @param ruta Ruta del archivo
+         * @return true si quedó abierto
+         */
+        bool abrir(const char* ruta) {
+            cerrar();
+#ifdef _WIN32
+            archivo = CreateFileA(ruta, FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            return archivo != INVALID_HANDLE_VALUE;
+#else
+            fd = ::open(ruta, O_WRONLY | O_CREAT | O_APPEND, 0644);
+            return fd >= 0;
+#endif
+        }
+
+        /**
+         * @brief Agrega bytes al final
+         * @return true si se escribieron todos
+         */
+        bool escribir(const unsigned char* datos, std::size_t n) {
+#ifdef _WIN32
+            while (n > 0) {
+                DWORD escritos = 0;
+                DWORD parte = n > 0x40000000u ? 0x40000000u : static_cast<DWORD>(n);
+                if (!WriteFile(archivo, datos, parte, &escritos, nullptr)) return false;
+                datos += escritos;
+                n -= escritos;
+            }
+#else
+            while (n > 0) {
+                ssize_t escritos = ::write(fd, datos, n);
+                if (escritos < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                datos += escritos;
+                n -= static_cast<std::size_t>(escritos);
+            }
+#endif
+            return true;
+        }
+
+        /**
+         * @brief Fuerza a disco los datos escritos
+         * @return true si el sistema confirmó la escritura
+         */
+        bool sincronizar() {
+#ifdef _WIN32
+            return FlushFileBuffers(archivo) != 0;
+#elif defined(__APPLE__)
+            return ::fsync(fd) == 0;
+#else
+            return ::fdatasync(fd) == 0;
+#endif
+        }
+
+        /**
+         * @brief Cierra el archivo
+         */
+        void cerrar() {
+#ifdef _WIN32
+            if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+            archivo = INVALID_HANDLE_VALUE;
+#else
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+#endif
+        }
+};
+
+/**
+ * @brief Crea un directorio si no existe
+ * @return true si existe al terminar
+ */
+inline bool crearDirectorioDiario(const char* directorio) {
+#ifdef _WIN32
+    return CreateDirectoryA(directorio, nullptr) != 0 || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+    return ::mkdir(directorio, 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+/**
+ * @brief Números de los segmentos de un directorio de diario, en orden
+ * @param directorio Directorio del diario
+ * @return Números encontrados (vacío si el directorio no existe)
+ */
+inline std::vector<unsigned long> listarSegmentosDiario(const char* directorio) {
+    std::vector<unsigned long> numeros;
+    unsigned long numero;
+    char resto;
+#ifdef _WIN32
+    WIN32_FIND_DATAA datos;
+    HANDLE busqueda = FindFirstFileA((std::string(directorio) + "\\segmento-*.wal").c_str(), &datos);
+    if (busqueda == INVALID_HANDLE_VALUE) return numeros;
+    do {
+        if (std::sscanf(datos.cFileName, "segmento-%lu.wa%c", &numero, &resto) == 2 && resto == 'l') numeros.push_back(numero);
+    } while (FindNextFileA(busqueda, &datos));
+    FindClose(busqueda);
+#else
+    DIR* dir = opendir(directorio);
+    if (dir == nullptr) return numeros;
+    while (struct dirent* entrada = readdir(dir)) {
+        if (std::sscanf(entrada->d_name, "segmento-%lu.wa%c", &numero, &resto) == 2 && resto == 'l') numeros.push_back(numero);
+    }
+    closedir(dir);
+#endif
+    std::sort(numeros.begin(), numeros.end());
+    return numeros;
+}
+
+/**
+ * @brief Ruta de un segmento
+ */
+inline std::string rutaSegmentoDiario(const char* directorio, unsigned long numero) {
+    char nombre[32];
+    std::snprintf(nombre, sizeof(nombre), "segmento-%08lu.wal", numero);
+    return std::string(directorio) + "/" + nombre;
+}
+
+/**
+ * @class DiarioLecturas
+ * @brief Anota lecturas en segmentos y las fuerza a disco por registro o en grupo
+ *
+ * En modo DIARIO_AGRUPADO anotar() solo copia el registro a un búfer
+ * protegido por un mutex; un hilo escritor intercambia el búfer cada
+ * intervaloMs (o antes si pasa de LIMITE_PENDIENTE bytes) y hace un solo
+ * write + fdatasync por grupo, fuera del mutex. Así el hilo de la
+ * ingesta no espera al disco. Una caída pierde a lo más el último
+ * intervalo.
+ *
+ * Cada apertura empieza un segmento nuevo; un segmento se cierra cuando
+ * pasa de tamanioSegmento bytes.
+ */
+class DiarioLecturas {
+    public:
+        static const std::size_t LIMITE_PENDIENTE = 256 * 1024; ///< Bytes acumulados que adelantan la escritura
+        static const std::size_t TAMANIO_MAXIMO_REGISTRO = 18 + 49; ///< Cabecera + identificador más largo
+
+    private:
+        std::string directorio;         ///< Directorio de los segmentos
+        ModoDiario modo;                ///< Política de sincronización
+        int intervaloMs;                ///< Espera máxima de un grupo (modo agrupado)
+        std::size_t tamanioSegmento;    ///< Tamaño a partir del cual se abre otro segmento
+        ArchivoDiario archivo;          ///< Segmento actual
+        unsigned long numeroSegmento;   ///< Número del segmento actual
+        std::size_t bytesSegmento;      ///< Bytes escritos en el segmento actual
+        bool abierto;                   ///< Hay un segmento abierto
+        bool fallido;                   ///< Una escritura falló (ya se informó)
+        long long desfasePared;         ///< desfaseRelojParedNs() al abrir; se suma a cada marca
+
+        std::mutex mutex;                   ///< Protege pendiente y detener
+        std::condition_variable hayTrabajo; ///< Despierta al escritor antes del intervalo
+        std::vector<unsigned char> pendiente; ///< Registros anotados sin escribir
+        bool detener;                       ///< Solicitud de paro al escritor
+        std::thread escritor;               ///< Hilo del modo agrupado
+
+        long registros;        ///< Lecturas anotadas
+        long sincronizaciones; ///< Llamadas a fdatasync
+        long long bytes;       ///< Bytes escritos
+
+        DiarioLecturas(const DiarioLecturas&);
+        DiarioLecturas& operator=(const DiarioLecturas&);
+
+        /**
+         * @brief Abre el segmento siguiente
+         */
+        bool abrirSegmento() {
+            numeroSegmento++;
+            bytesSegmento = 0;
+            std::string ruta = rutaSegmentoDiario(directorio.c_str(), numeroSegmento);
+            if (!archivo.abrir(ruta.c_str())) {
+                IOT_ERROR("No se pudo crear el segmento " << ruta);
+                return false;
+            }
+            // Sin esto el segmento nuevo puede desaparecer tras una caída aunque sus registros ya estén en disco
+            if (!sincronizarDirectorioDe(ruta.c_str())) {
+                IOT_ERROR("No se pudo forzar a disco el directorio del segmento " << ruta);
+                archivo.cerrar();
+                return false;
+            }
+            IOT_DEPURACION("Segmento de diario " << ruta << " abierto");
+            return true;
+        }
+
+        /**
+         * @brief Escribe un grupo de registros y lo fuerza a disco
+         * @param datos Registros completos
+         * @param n Bytes
+         */
+        void escribirGrupo(const unsigned char* datos, std::size_t n) {
+            if (fallido) return;
+            if (bytesSegmento >= tamanioSegmento && !abrirSegmento()) {
+                fallido = true;
+                return;
+            }
+            if (!archivo.escribir(datos, n) || !archivo.sincronizar()) {
+                IOT_ERROR("No se pudo escribir el diario en " << directorio << "; se deja de anotar");
+                fallido = true;
+                return;
+            }
+            bytesSegmento += n;
+            bytes += static_cast<long long>(n);
+            sincronizaciones++;
+        }
+
+        /**
+         * @brief Cuerpo del hilo escritor del modo agrupado
+         */
+        void escribirGrupos() {
+            std::vector<unsigned char> grupo;
+            grupo.reserve(LIMITE_PENDIENTE);
+            while (true) {
+                bool salir;
+                {
+                    std::unique_lock<std::mutex> bloqueo(mutex);
+                    hayTrabajo.wait_for(bloqueo, std::chrono::milliseconds(intervaloMs), [this] {
+                        return detener || pendiente.size() >= LIMITE_PENDIENTE;
+                    });
+                    grupo.swap(pendiente);
+                    salir = detener;
+                }
+                if (!grupo.empty()) {
+                    escribirGrupo(grupo.data(), grupo.size());
+                    grupo.clear();
+                }
+                if (salir) break;
+            }
+        }
+
+        /**
+         * @brief Codifica un registro
+         * @param destino Al menos TAMANIO_MAXIMO_REGISTRO bytes
+         * @param paredNs Marca de la lectura en nanosegundos desde la época Unix
+         * @return Bytes del registro
+         */
+        static std::size_t codificar(unsigned char* destino, TipoLectura tipo, const char* id, std::size_t longitudId,
+                                     float temperatura, int presion, long long paredNs) {
+            destino[4] = static_cast<unsigned char>(tipo);
+            destino[5] = static_cast<unsigned char>(longitudId);
+            std::memcpy(destino + 6, &paredNs, 8);
+            if (tipo == LECTURA_TEMPERATURA) {
+                std::memcpy(destino + 14, &temperatura, 4);
+            } else {
+                std::memcpy(destino + 14, &presion, 4);
+            }
+            std::memcpy(destino + 18, id, longitudId);
+            std::size_t n = 18 + longitudId;
+            unsigned int crc = crc32Diario(destino + 4, n - 4);
+            std::memcpy(destino, &crc, 4);
+            return n;
+        }
+
+    public:
+        /**
+         * @brief Constructor, diario cerrado
+         */
+        DiarioLecturas()
+            : modo(DIARIO_AGRUPADO), intervaloMs(10), tamanioSegmento(16 * 1024 * 1024), numeroSegmento(0),
+              bytesSegmento(0), abierto(false), fallido(false), desfasePared(0), detener(false), registros(0),
+              sincronizaciones(0), bytes(0) {}
+
+        /**
+         * @brief Destructor, escribe lo pendiente y cierra
+         */
+        ~DiarioLecturas() { cerrar(); }
+
+        /**
+         * @brief Abre el diario en un segmento nuevo
+         * @param dir Directorio (se crea si no existe)
+         * @param modoSincronizacion Por registro o agrupado
+         * @param intervalo Espera máxima de un grupo en ms (modo agrupado)
+         * @param bytesPorSegmento Tamaño a partir del cual se abre otro segmento
+         * @return true si quedó listo para anotar
+         */
+        bool abrir(const char* dir, ModoDiario modoSincronizacion, int intervalo = 10,
+                   std::size_t bytesPorSegmento = 16 * 1024 * 1024) {
+            cerrar();
+            directorio = dir;
+            modo = modoSincronizacion;
+            intervaloMs = intervalo > 0 ? intervalo : 1;
+            tamanioSegmento = bytesPorSegmento;
+            fallido = false;
+            desfasePared = desfaseRelojParedNs();
+            if (!crearDirectorioDiario(dir)) {
+                IOT_ERROR("No se pudo crear el directorio del diario " << dir);
+                return false;
+            }
+            std::vector<unsigned long> existentes = listarSegmentosDiario(dir);
+            numeroSegmento = existentes.empty() ? 0 : existentes.back();
+            if (!abrirSegmento()) return false;
+            abierto = true;
+            detener = false;
+            if (modo == DIARIO_AGRUPADO) {
+                pendiente.reserve(LIMITE_PENDIENTE);
+                escritor = std::thread(&DiarioLecturas::escribirGrupos, this);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Anota una lectura aceptada
+         * @param tipo Tipo de la lectura
+         * @param id Identificador del sensor (máximo 49 caracteres)
+         * @param longitudId Caracteres del identificador
+         * @param temperatura Valor si es de temperatura
+         * @param presion Valor si es de presión
+         * @param marcaNs Instante de la lectura (reloj monotónico, instanteActualNs())
+         *
+         * Debe llamarse desde un solo hilo (el consumidor de la ingesta).
+         */
+        void anotar(TipoLectura tipo, const char* id, std::size_t longitudId, float temperatura, int presion, long long marcaNs) {
+            if (!abierto || longitudId > 49) return;
+            unsigned char registro[TAMANIO_MAXIMO_REGISTRO];
+            std::size_t n = codificar(registro, tipo, id, longitudId, temperatura, presion, marcaNs + desfasePared);
+            registros++;
+            if (modo == DIARIO_POR_REGISTRO) {
+                escribirGrupo(registro, n);
+                return;
+            }
+            bool lleno;
+            {
+                std::lock_guard<std::mutex> bloqueo(mutex);
+                pendiente.insert(pendiente.end(), registro, registro + n);
+                lleno = pendiente.size() >= LIMITE_PENDIENTE;
+            }
+            if (lleno) hayTrabajo.notify_one();
+        }
+
+        /**
+         * @brief Escribe lo pendiente, detiene el escritor y cierra el segmento
+         * @post Si el segmento actual quedó vacío, se borra
+         */
+        void cerrar() {
+            if (!abierto) return;
+            if (escritor.joinable()) {
+                {
+                    std::lock_guard<std::mutex> bloqueo(mutex);
+                    detener = true;
+                }
+                hayTrabajo.notify_one();
+                escritor.join();
+            }
+            archivo.cerrar();
+            // Un segmento sin lecturas solo estorbaría en la siguiente reproducción
+            if (bytesSegmento == 0) std::remove(rutaSegmentoDiario(directorio.c_str(), numeroSegmento).c_str());
+            abierto = false;
+        }
+
+        /**
+         * @brief Lecturas anotadas desde que se abrió
+         */
+        long obtenerRegistros() const { return registros; }
+
+        /**
+         * @brief Llamadas a fdatasync desde que se abrió (válido tras cerrar en modo agrupado)
+         */
+        long obtenerSincronizaciones() const { return sincronizaciones; }
+
+        /**
+         * @brief Bytes escritos desde que se abrió (válido tras cerrar en modo agrupado)
+         */
+        long long obtenerBytes() const { return bytes; }
+};
+
+/**
+ * @brief Vuelve a registrar en sus sensores todas las lecturas del diario
+ * @param directorio Directorio del diario
+ * @param enrutador Enrutador de la lista destino (crea los sensores que falten)
+ * @return Lecturas reproducidas
+ *
+ * Los segmentos se leen en orden. Si uno termina en un registro
+ * incompleto o dañado, se descarta el resto de ese segmento y se sigue
+ * con el siguiente.
+ *
+ * Cada marca de pared se lleva al reloj monotónico de este arranque
+ * conservando su antigüedad. Una marca en el futuro (el reloj de pared se
+ * atrasó desde que se anotó) se toma como el instante actual, para que
+ * SerieTemporal no fije en ella a las lecturas nuevas.
+ */
+inline long reproducirDiario(const char* directorio, EnrutadorESP32& enrutador) {
+    long reproducidas = 0;
+    std::vector<unsigned long> segmentos = listarSegmentosDiario(directorio);
+    std::vector<char> contenido;
+    const long long desfase = desfaseRelojParedNs();
+    const long long ahora = instanteActualNs();
+    for (std::size_t s = 0; s < segmentos.size(); s++) {
+        std::string ruta = rutaSegmentoDiario(directorio, segmentos[s]);
+        std::ifstream entrada(ruta.c_str(), std::ios::binary);
+        contenido.assign(std::istreambuf_iterator<char>(entrada), std::istreambuf_iterator<char>());
+        const unsigned char* datos = reinterpret_cast<const unsigned char*>(contenido.data());
+        std::size_t n = contenido.size();
+        std::size_t pos = 0;
+        while (pos + 18 <= n) {
+            std::size_t longitudId = datos[pos + 5];
+            unsigned int crc;
+            std::memcpy(&crc, datos + pos, 4);
+            if (datos[pos + 4] > LECTURA_PRESION || longitudId > 49 || pos + 18 + longitudId > n ||
+                crc32Diario(datos + pos + 4, 14 + longitudId) != crc) {
+                break;
+            }
+            LecturaESP32 lectura;
+            long long paredNs;
+            lectura.tipo = static_cast<TipoLectura>(datos[pos + 4]);
+            std::memcpy(&paredNs, datos + pos + 6, 8);
+            long long marcaNs = paredNs - desfase;
+            if (marcaNs > ahora) marcaNs = ahora;
+            lectura.temperatura = 0.0f;
+            lectura.presion = 0;
+            if (lectura.tipo == LECTURA_TEMPERATURA) {
+                std::memcpy(&lectura.temperatura, datos + pos + 14, 4);
+            } else {
+                std::memcpy(&lectura.presion, datos + pos + 14, 4);
+            }
+            lectura.id.datos = reinterpret_cast<const char*>(datos + pos + 18);
+            lectura.id.longitud = longitudId;
+            lectura.valorTexto = vistaDe("");
+            if (enrutador.registrar(lectura, marcaNs) == RUTA_REGISTRADA) reproducidas++;
+            pos += 18 + longitudId;
+        }
+        if (pos != n) {
+            IOT_ADVERTENCIA("Segmento " << ruta << " con " << (n - pos) << " bytes finales incompletos, se ignoran");
+        }
+    }
+    return reproducidas;
+}
+
+/**
+ * @brief Borra todos los segmentos del diario
+ * @param directorio Directorio del diario
+ * @return true si se borraron todos
+ *
+ * Se usa después de guardar una instantánea que ya contiene todas las
+ * lecturas anotadas. El diario debe estar cerrado.
+ */
+inline bool descartarDiario(const char* directorio) {
+    std::vector<unsigned long> segmentos = listarSegmentosDiario(directorio);
+    bool todos = true;
+    for (std::size_t s = 0; s < segmentos.size(); s++) {
+        if (std::remove(rutaSegmentoDiario(directorio, segmentos[s]).c_str()) != 0) todos = false;
+    }
+    return todos;
+}
+
+#endif
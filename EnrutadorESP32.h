@@ -0,0 +1,231 @@
+#ifndef ENRUTADORESP32_H
+#define ENRUTADORESP32_H
+
+#include <cstddef>
+#include <cstring>
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "PoliticaRetencion.h"
+#include "ProtocoloESP32.h"
+#include "IndiceHash.h"
+#include "Bitacora.h"
+
+/**
+ * @file EnrutadorESP32.h
+ * @brief Entrega cada lectura del ESP32 al sensor indicado por su identificador
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Registra una lectura en un sensor de tipo concreto conocido
+ * @tparam Sensor Tipo concreto (SensorTemperatura, SensorPresionCircular, ...)
+ * @tparam Valor Tipo de la lectura
+ */
+template <typename Sensor, typename Valor>
+void registrarEnSensor(SensorBase* sensor, Valor valor, long long marcaNs) {
+    static_cast<Sensor*>(sensor)->registrarLectura(valor, marcaNs);
+}
+
+/**
+ * @struct RutaSensor
+ * @brief Manejador tipado de un sensor ya resuelto
+ *
+ * Guarda el sensor junto con la función que registra lecturas en su tipo
+ * concreto, así el historial (lista o circular) se resuelve una sola vez.
+ * Solo una de las dos funciones es distinta de nullptr; si ambas lo son,
+ * el nombre pertenece a un sensor de otro tipo y sus lecturas se rechazan.
+ */
+struct RutaSensor {
+    SensorBase* sensor;                                ///< Sensor destino
+    void (*registrarTemperatura)(SensorBase*, float, long long); ///< Registro si el sensor es de temperatura
+    void (*registrarPresion)(SensorBase*, int, long long);       ///< Registro si el sensor es de presión
+};
+
+/**
+ * @brief Construye la ruta de un sensor según su tipo concreto
+ * @param sensor Sensor de la lista
+ * @return Ruta con la función de registro que corresponde (ninguna si el
+ *         tipo no es uno de los sensores conocidos)
+ */
+inline RutaSensor rutaDeSensor(SensorBase* sensor) {
+    RutaSensor ruta = { sensor, nullptr, nullptr };
+    if (dynamic_cast<SensorTemperatura*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperatura, float>;
+    } else if (dynamic_cast<SensorTemperaturaCircular*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperaturaCircular, float>;
+    } else if (dynamic_cast<SensorTemperaturaTemporal*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperaturaTemporal, float>;
+    } else if (dynamic_cast<SensorTemperaturaComprimido*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperaturaComprimido, float>;
+    } else if (dynamic_cast<SensorTemperaturaInstantanea*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperaturaInstantanea, float>;
+    } else if (dynamic_cast<SensorTemperaturaIndexado*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperaturaIndexado, float>;
+    } else if (dynamic_cast<SensorTemperaturaDesenrollado*>(sensor) != nullptr) {
+        ruta.registrarTemperatura = &registrarEnSensor<SensorTemperaturaDesenrollado, float>;
+    } else if (dynamic_cast<SensorPresion*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresion, int>;
+    } else if (dynamic_cast<SensorPresionCircular*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresionCircular, int>;
+    } else if (dynamic_cast<SensorPresionTemporal*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresionTemporal, int>;
+    } else if (dynamic_cast<SensorPresionComprimido*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresionComprimido, int>;
+    } else if (dynamic_cast<SensorPresionInstantanea*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresionInstantanea, int>;
+    } else if (dynamic_cast<SensorPresionIndexado*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresionIndexado, int>;
+    } else if (dynamic_cast<SensorPresionDesenrollado*>(sensor) != nullptr) {
+        ruta.registrarPresion = &registrarEnSensor<SensorPresionDesenrollado, int>;
+    }
+    return ruta;
+}
+
+/**
+ * @brief Busca un sensor por nombre en un almacén de tipo conocido
+ * @tparam Almacen ListaGeneral o RegistroSensores
+ */
+template <typename Almacen>
+SensorBase* buscarEnAlmacen(void* almacen, const char* nombre, std::size_t longitud, unsigned int hash) {
+    return static_cast<Almacen*>(almacen)->buscarSensor(nombre, longitud, hash);
+}
+
+/**
+ * @brief Crea en un almacén de tipo conocido el sensor de una línea
+ * @tparam Almacen ListaGeneral o RegistroSensores
+ */
+template <typename Almacen>
+SensorBase* crearEnAlmacen(void* almacen, TipoLectura tipo, const char* nombre, const PoliticaRetencion& politica) {
+    Almacen& destino = *static_cast<Almacen*>(almacen);
+    if (tipo == LECTURA_TEMPERATURA) return &crearSensorTemperaturaEn(destino, nombre, politica);
+    return &crearSensorPresionEn(destino, nombre, politica);
+}
+
+/**
+ * @enum ResultadoRuta
+ * @brief Resultado de entregar una lectura
+ */
+enum ResultadoRuta {
+    RUTA_REGISTRADA,     ///< La lectura se registró en su sensor
+    RUTA_TIPO_DISTINTO,  ///< El identificador pertenece a un sensor de otro tipo
+    RUTA_ID_INVALIDO     ///< El identificador no cabe en el nombre de un sensor
+};
+
+/**
+ * @class EnrutadorESP32
+ * @brief Resuelve identificador -> sensor una sola vez por identificador
+ *
+ * La primera lectura de un identificador lo busca en el almacén (o
+ * crea el sensor del tipo de la línea si no existe) y guarda el manejador
+ * tipado en un índice propio. Las lecturas siguientes cuestan un hash y
+ * una consulta al índice, sin buscarSensor ni dynamic_cast. La clave del
+ * índice es el nombre guardado en el sensor, por lo que el enrutador no
+ * debe sobrevivir al almacén (los sensores nunca se eliminan de él).
+ *
+ * Las líneas sin identificador (firmware antiguo: TEMP,23.4) se envían a
+ * T-001 / P-001. Los sensores que crea el enrutador usan la política de
+ * retención indicada en el constructor.
+ *
+ * El almacén puede ser una ListaGeneral o un RegistroSensores; su tipo se
+ * fija en el constructor con dos funciones, igual que RutaSensor, para que
+ * la ingesta y el diario no dependan de él.
+ */
+class EnrutadorESP32 {
+    private:
+        void* almacen;                  ///< Contenedor dueño de los sensores
+        SensorBase* (*buscarEn)(void*, const char*, std::size_t, unsigned int);              ///< Búsqueda en el almacén
+        SensorBase* (*crearEn)(void*, TipoLectura, const char*, const PoliticaRetencion&);   ///< Creación en el almacén
+        IndiceHash<RutaSensor> rutas;   ///< Identificador -> manejador tipado
+        PoliticaRetencion retencion;    ///< Historial de los sensores nuevos
+
+        EnrutadorESP32(const EnrutadorESP32&);            ///< No copiable
+        EnrutadorESP32& operator=(const EnrutadorESP32&); ///< No asignable
+
+        /**
+         * @brief Resuelve un identificador que aún no está en el índice
+         * @param tipo Tipo de la línea (se usa si hay que crear el sensor)
+         * @param id Identificador (máximo 49 caracteres)
+         * @param hash Hash del identificador
+         * @return Ruta recién guardada en el índice
+         */
+        RutaSensor* resolver(TipoLectura tipo, VistaCadena id, unsigned int hash) {
+            SensorBase* sensor = buscarEn(almacen, id.datos, id.longitud, hash);
+            if (sensor == nullptr) {
+                char nombre[50];
+                std::memcpy(nombre, id.datos, id.longitud);
+                nombre[id.longitud] = '\0';
+                sensor = crearEn(almacen, tipo, nombre, retencion);
+                IOT_INFO("Sensor " << nombre << (tipo == LECTURA_TEMPERATURA ? " (Temperatura)" : " (Presion)") << " creado");
+            }
+            rutas.insertar(sensor->obtenerNombre(), hash, rutaDeSensor(sensor));
+            return rutas.buscar(id.datos, id.longitud, hash);
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @tparam Almacen ListaGeneral o un RegistroSensores que admita los tipos de la política
+         * @param sensores Almacén en el que se buscan y crean los sensores
+         * @param politica Retención de los sensores que se creen (por defecto sin límite)
+         */
+        template <typename Almacen>
+        explicit EnrutadorESP32(Almacen& sensores, const PoliticaRetencion& politica = PoliticaRetencion())
+            : almacen(&sensores), buscarEn(&buscarEnAlmacen<Almacen>), crearEn(&crearEnAlmacen<Almacen>),
+              retencion(politica) {}
+
+        /**
+         * @brief Identificador al que se envía una lectura
+         * @param tipo Tipo de la línea
+         * @param id Identificador recibido
+         * @return id, o T-001 / P-001 si llegó vacío
+         */
+        static VistaCadena identificadorDestino(TipoLectura tipo, VistaCadena id) {
+            if (!id.vacia()) return id;
+            return vistaDe(tipo == LECTURA_TEMPERATURA ? "T-001" : "P-001");
+        }
+
+        /**
+         * @brief Obtiene el manejador del sensor de un identificador
+         * @param tipo Tipo de la línea
+         * @param id Identificador recibido (vacío = sensor por defecto del tipo)
+         * @return Ruta del sensor, o nullptr si el identificador es inválido
+         *         (más de 49 caracteres o con '\0')
+         * @post Si el sensor no existía se crea del tipo indicado
+         */
+        RutaSensor* obtenerRuta(TipoLectura tipo, VistaCadena id) {
+            id = identificadorDestino(tipo, id);
+            if (id.longitud > 49 || std::memchr(id.datos, '\0', id.longitud) != nullptr) return nullptr;
+            unsigned int hash = hashCadena(id.datos, id.longitud);
+            RutaSensor* ruta = rutas.buscar(id.datos, id.longitud, hash);
+            return ruta != nullptr ? ruta : resolver(tipo, id, hash);
+        }
+
+        /**
+         * @brief Registra una lectura ya interpretada en su sensor
+         * @param lectura Lectura con resultado PARSEO_OK
+         * @param marcaNs Instante en que se recibió (0 = instante actual)
+         * @return RUTA_REGISTRADA, RUTA_TIPO_DISTINTO o RUTA_ID_INVALIDO
+         */
+        ResultadoRuta registrar(const LecturaESP32& lectura, long long marcaNs = 0) {
+            RutaSensor* ruta = obtenerRuta(lectura.tipo, lectura.id);
+            if (ruta == nullptr) return RUTA_ID_INVALIDO;
+            if (lectura.tipo == LECTURA_TEMPERATURA) {
+                if (ruta->registrarTemperatura == nullptr) return RUTA_TIPO_DISTINTO;
+                ruta->registrarTemperatura(ruta->sensor, lectura.temperatura, marcaNs);
+            } else {
+                if (ruta->registrarPresion == nullptr) return RUTA_TIPO_DISTINTO;
+                ruta->registrarPresion(ruta->sensor, lectura.presion, marcaNs);
+            }
+            return RUTA_REGISTRADA;
+        }
+
+        /**
+         * @brief Obtiene la cantidad de identificadores resueltos
+         * @return Número de rutas en el índice
+         */
+        std::size_t obtenerTamanio() const { return rutas.obtenerTamanio(); }
+};
+
+#endif
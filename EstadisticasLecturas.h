@@ -0,0 +1,112 @@
+#ifndef ESTADISTICASLECTURAS_H
+#define ESTADISTICASLECTURAS_H
+
+/**
+ * @file EstadisticasLecturas.h
+ * @brief Estadísticas incrementales de las lecturas de un sensor
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct EstadisticasLecturas
+ * @brief Conteo, suma, mínimo, máximo, media y varianza mantenidos en O(1)
+ *
+ * La media y la varianza usan el algoritmo de Welford, que también se
+ * puede revertir al quitar una lectura. Quitar un valor que era el mínimo
+ * o el máximo invalida los extremos: quien los necesite debe recalcularlos
+ * (o usar quitarMinimo() si ya conoce el siguiente mínimo).
+ */
+struct EstadisticasLecturas {
+    long long cantidad;    ///< Número de lecturas
+    double suma;           ///< Suma de las lecturas
+    double minimo;         ///< Lectura más baja
+    double maximo;         ///< Lectura más alta
+    double media;          ///< Media (Welford)
+    double m2;             ///< Suma de cuadrados de desviaciones (Welford)
+    bool extremosValidos;  ///< false si minimo/maximo deben recalcularse
+
+    /**
+     * @brief Constructor por defecto
+     * @post Estadísticas vacías
+     */
+    EstadisticasLecturas() { reiniciar(); }
+
+    /**
+     * @brief Vacía las estadísticas
+     */
+    void reiniciar() {
+        cantidad = 0;
+        suma = 0.0;
+        minimo = 0.0;
+        maximo = 0.0;
+        media = 0.0;
+        m2 = 0.0;
+        extremosValidos = true;
+    }
+
+    /**
+     * @brief Incorpora una lectura nueva
+     * @param x Valor de la lectura
+     */
+    void agregar(double x) {
+        if (cantidad == 0) {
+            minimo = x;
+            maximo = x;
+        } else {
+            if (x < minimo) minimo = x;
+            if (x > maximo) maximo = x;
+        }
+        cantidad++;
+        suma += x;
+        double delta = x - media;
+        media += delta / cantidad;
+        m2 += delta * (x - media);
+    }
+
+    /**
+     * @brief Quita una lectura que formaba parte de las estadísticas
+     * @param x Valor de la lectura eliminada
+     * @post Si x era un extremo, extremosValidos queda en false
+     */
+    void quitar(double x) {
+        if (cantidad <= 1) {
+            reiniciar();
+            return;
+        }
+        double mediaAnterior = media;
+        cantidad--;
+        suma -= x;
+        media = (mediaAnterior * (cantidad + 1) - x) / cantidad;
+        m2 -= (x - mediaAnterior) * (x - media);
+        if (m2 < 0.0) m2 = 0.0;
+        if (x <= minimo || x >= maximo) {
+            extremosValidos = false;
+        }
+    }
+
+    /**
+     * @brief Quita la lectura mínima conociendo el nuevo mínimo
+     * @param x Valor eliminado (el mínimo actual)
+     * @param siguienteMinimo Mínimo de las lecturas restantes
+     *
+     * El máximo no cambia: si x también era el máximo, todas las lecturas
+     * eran iguales y el máximo restante sigue siendo x.
+     */
+    void quitarMinimo(double x, double siguienteMinimo) {
+        bool validos = extremosValidos;
+        quitar(x);
+        if (cantidad > 0) {
+            minimo = siguienteMinimo;
+            extremosValidos = validos;
+        }
+    }
+
+    /**
+     * @brief Varianza poblacional
+     * @return m2 / n, o 0 sin lecturas
+     */
+    double varianza() const { return cantidad > 0 ? m2 / cantidad : 0.0; }
+};
+
+#endif
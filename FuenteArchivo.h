@@ -0,0 +1,130 @@
+#ifndef FUENTEARCHIVO_H
+#define FUENTEARCHIVO_H
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "ArchivoMapeado.h"
+#include "FuenteSerial.h"
+
+/**
+ * @file FuenteArchivo.h
+ * @brief Fuente que reproduce una captura de líneas del ESP32 guardada en archivo
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * La captura es lo que el ESP32 envió por el puerto (TEMP,T-001,23.4 /
+ * PRES,P-001,97, una por línea). Cada línea puede llevar al inicio los
+ * milisegundos transcurridos desde el comienzo de la grabación seguidos
+ * de un tabulador ("1530\tTEMP,T-001,23.4"); ese prefijo se quita antes
+ * de entregar la línea.
+ */
+
+/**
+ * @class FuenteArchivo
+ * @brief FuenteSerial que entrega una captura lo más rápido posible o a su ritmo grabado
+ *
+ * El archivo se proyecta en memoria y se entrega por líneas completas.
+ * Sin ritmo, cada leer() llena el búfer del lector. Con ritmo, una línea
+ * se entrega cuando llega su instante: el de su prefijo de milisegundos
+ * o, si no lo tiene, el que tardaría en llegar por un puerto a los
+ * baudios indicados (10 bits por byte).
+ */
+class FuenteArchivo : public FuenteSerial {
+    private:
+        std::string ruta;         ///< Archivo de la captura
+        bool ritmo;               ///< Respetar los instantes de la captura
+        int baudios;              ///< Velocidad supuesta para líneas sin instante
+        ArchivoMapeado archivo;   ///< Captura proyectada
+        std::size_t posicion;     ///< Siguiente byte de la captura por entregar
+        long long bytesEntregados; ///< Bytes entregados (sin prefijos)
+        bool mitadDeLinea;        ///< La última entrega cortó una línea más larga que el búfer
+        std::chrono::steady_clock::time_point inicio; ///< Comienzo de la reproducción
+
+        /**
+         * @brief Lee el prefijo de milisegundos de la línea que empieza en posicion
+         * @param ms Milisegundos del prefijo
+         * @return Bytes del prefijo con el tabulador (0 si la línea no lo tiene)
+         */
+        std::size_t prefijoInstante(long long& ms) const {
+            const char* datos = reinterpret_cast<const char*>(archivo.obtenerDatos());
+            std::size_t fin = archivo.obtenerTamanio();
+            std::size_t i = posicion;
+            ms = 0;
+            while (i < fin && datos[i] >= '0' && datos[i] <= '9' && i - posicion < 18) {
+                ms = ms * 10 + (datos[i] - '0');
+                i++;
+            }
+            if (i == posicion || i >= fin || datos[i] != '\t') return 0;
+            return i + 1 - posicion;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param rutaCaptura Archivo de la captura
+         * @param respetarRitmo true para entregar cada línea en su instante grabado
+         * @param velocidad Baudios supuestos para las líneas sin instante
+         */
+        FuenteArchivo(const char* rutaCaptura, bool respetarRitmo, int velocidad)
+            : ruta(rutaCaptura), ritmo(respetarRitmo), baudios(velocidad > 0 ? velocidad : 115200),
+              posicion(0), bytesEntregados(0), mitadDeLinea(false) {}
+
+        bool abrir() override {
+            if (!archivo.abrir(ruta.c_str())) return false;
+            posicion = 0;
+            bytesEntregados = 0;
+            mitadDeLinea = false;
+            inicio = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        long leer(char* buffer, std::size_t capacidad, int esperaMs) override {
+            const char* datos = reinterpret_cast<const char*>(archivo.obtenerDatos());
+            std::size_t fin = archivo.obtenerTamanio();
+            if (datos == nullptr || posicion >= fin) return -1;
+
+            std::size_t copiados = 0;
+            while (posicion < fin && copiados < capacidad) {
+                long long ms = 0;
+                std::size_t prefijo = mitadDeLinea ? 0 : prefijoInstante(ms);
+                if (ritmo && !mitadDeLinea) {
+                    long long instanteNs = prefijo > 0 ? ms * 1000000LL : bytesEntregados * 10LL * 1000000000LL / baudios;
+                    std::chrono::nanoseconds falta = std::chrono::nanoseconds(instanteNs) - (std::chrono::steady_clock::now() - inicio);
+                    if (falta.count() > 0) {
+                        if (copiados > 0) break;
+                        std::chrono::nanoseconds espera = std::chrono::milliseconds(esperaMs);
+                        std::this_thread::sleep_for(falta < espera ? falta : espera);
+                        if (falta > espera) return 0;
+                    }
+                }
+                const char* linea = datos + posicion + prefijo;
+                const void* salto = std::memchr(linea, '\n', fin - posicion - prefijo);
+                std::size_t longitud = salto != nullptr ? static_cast<const char*>(salto) - linea + 1 : fin - posicion - prefijo;
+                mitadDeLinea = false;
+                if (longitud > capacidad - copiados) {
+                    // Una línea que no cabe completa se entrega por partes, solo con el búfer vacío
+                    if (copiados > 0) break;
+                    longitud = capacidad;
+                    mitadDeLinea = true;
+                }
+                std::memcpy(buffer + copiados, linea, longitud);
+                copiados += longitud;
+                posicion += prefijo + longitud;
+                bytesEntregados += static_cast<long long>(longitud);
+            }
+            return static_cast<long>(copiados);
+        }
+
+        void cerrar() override { archivo.cerrar(); }
+
+        const char* obtenerRuta() const override { return ruta.c_str(); }
+
+        /**
+         * @brief Bytes de la captura (con prefijos)
+         */
+        std::size_t obtenerTamanio() const { return archivo.obtenerTamanio(); }
+};
+
+#endif
@@ -0,0 +1,300 @@
+#ifndef FUENTESERIAL_H
+#define FUENTESERIAL_H
+
+#include <cstddef>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+/**
+ * @file FuenteSerial.h
+ * @brief Abstracción de la fuente de bytes del dispositivo ESP32
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Define la interfaz FuenteSerial y sus implementaciones por plataforma:
+ * Win32 (CreateFile/ReadFile) y POSIX (termios + poll). La versión POSIX
+ * acepta también pseudoterminales (pty) y FIFOs, de modo que la lectura
+ * se puede probar sin hardware.
+ */
+
+/**
+ * @class FuenteSerial
+ * @brief Interfaz para leer bytes de un puerto serial
+ */
+class FuenteSerial {
+    public:
+        /**
+         * @brief Destructor virtual
+         */
+        virtual ~FuenteSerial() {}
+
+        /**
+         * @brief Abre y configura el dispositivo
+         * @return true si quedó listo para leer
+         */
+        virtual bool abrir() = 0;
+
+        /**
+         * @brief Espera a que haya datos y los lee
+         * @param buffer Destino de los bytes leídos
+         * @param capacidad Tamaño máximo a leer
+         * @param esperaMs Tiempo máximo de espera si no hay datos
+         * @return Bytes leídos (>0), 0 si venció la espera, -1 si el flujo terminó o hubo error
+         *
+         * Regresa en cuanto llegan datos; no duerme un tiempo fijo.
+         */
+        virtual long leer(char* buffer, std::size_t capacidad, int esperaMs) = 0;
+
+        /**
+         * @brief Cierra el dispositivo
+         */
+        virtual void cerrar() = 0;
+
+        /**
+         * @brief Obtiene la ruta del dispositivo
+         * @return Ruta configurada
+         */
+        virtual const char* obtenerRuta() const = 0;
+
+        /**
+         * @brief Obtiene el descriptor para esperar datos con epoll o poll
+         * @return Descriptor abierto, o -1 si la fuente no tiene uno (Win32, archivo en memoria)
+         */
+        virtual int obtenerDescriptor() const { return -1; }
+};
+
+#ifdef _WIN32
+
+/**
+ * @class FuenteSerialWindows
+ * @brief Puerto COM de Windows leído con ReadFile
+ *
+ * Los timeouts se configuran para que ReadFile regrese en cuanto llega
+ * el primer byte, o al vencer la espera si no llega ninguno.
+ */
+class FuenteSerialWindows : public FuenteSerial {
+    private:
+        char ruta[64];   ///< Ruta del puerto (por ejemplo \\.\COM6)
+        int baudios;     ///< Velocidad del puerto
+        HANDLE manejador; ///< Manejador del puerto abierto
+        int esperaConfigurada; ///< Espera (ms) programada en los timeouts actuales
+
+        bool configurarEspera(int esperaMs) {
+            COMMTIMEOUTS timeouts = {0};
+            timeouts.ReadIntervalTimeout = MAXDWORD;
+            timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+            timeouts.ReadTotalTimeoutConstant = esperaMs > 0 ? esperaMs : 1;
+            esperaConfigurada = esperaMs;
+            return SetCommTimeouts(manejador, &timeouts) != 0;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param rutaPuerto Ruta del puerto COM
+         * @param velocidad Velocidad en baudios
+         */
+        FuenteSerialWindows(const char* rutaPuerto, int velocidad)
+            : baudios(velocidad), manejador(INVALID_HANDLE_VALUE), esperaConfigurada(-1) {
+            std::strncpy(ruta, rutaPuerto, sizeof(ruta) - 1);
+            ruta[sizeof(ruta) - 1] = '\0';
+        }
+
+        ~FuenteSerialWindows() { cerrar(); }
+
+        bool abrir() override {
+            manejador = CreateFileA(ruta, GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (manejador == INVALID_HANDLE_VALUE) return false;
+
+            DCB dcbSerialParams = {0};
+            dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+            if (!GetCommState(manejador, &dcbSerialParams)) {
+                cerrar();
+                return false;
+            }
+            dcbSerialParams.BaudRate = baudios;
+            dcbSerialParams.ByteSize = 8;
+            dcbSerialParams.StopBits = ONESTOPBIT;
+            dcbSerialParams.Parity = NOPARITY;
+            if (!SetCommState(manejador, &dcbSerialParams) || !configurarEspera(100)) {
+                cerrar();
+                return false;
+            }
+            return true;
+        }
+
+        long leer(char* buffer, std::size_t capacidad, int esperaMs) override {
+            if (esperaMs != esperaConfigurada) configurarEspera(esperaMs);
+            DWORD bytesRead = 0;
+            if (!ReadFile(manejador, buffer, static_cast<DWORD>(capacidad), &bytesRead, NULL)) {
+                return -1;
+            }
+            return static_cast<long>(bytesRead);
+        }
+
+        void cerrar() override {
+            if (manejador != INVALID_HANDLE_VALUE) {
+                CloseHandle(manejador);
+                manejador = INVALID_HANDLE_VALUE;
+            }
+        }
+
+        const char* obtenerRuta() const override { return ruta; }
+};
+
+#else
+
+/**
+ * @class FuenteSerialPosix
+ * @brief Dispositivo serial POSIX leído con poll() y read()
+ *
+ * Si la ruta es una terminal (puerto USB o pty) se configura en modo
+ * crudo 8N1 con la velocidad indicada; si es un FIFO o archivo se lee
+ * tal cual. El descriptor se abre no bloqueante y la espera se hace con
+ * poll(), que despierta en cuanto hay bytes disponibles.
+ */
+class FuenteSerialPosix : public FuenteSerial {
+    private:
+        char ruta[256];  ///< Ruta del dispositivo (por ejemplo /dev/ttyUSB0)
+        int baudios;     ///< Velocidad del puerto
+        int descriptor;  ///< Descriptor abierto (-1 si está cerrado)
+
+        /**
+         * @brief Traduce baudios a la constante de termios
+         * @return Constante speed_t, o B0 si la velocidad no es soportada
+         */
+        static speed_t velocidadTermios(int velocidad) {
+            switch (velocidad) {
+                case 9600: return B9600;
+                case 19200: return B19200;
+                case 38400: return B38400;
+                case 57600: return B57600;
+                case 115200: return B115200;
+                case 230400: return B230400;
+#ifdef B460800
+                case 460800: return B460800;
+#endif
+#ifdef B921600
+                case 921600: return B921600;
+#endif
+                default: return B0;
+            }
+        }
+
+        /**
+         * @brief Configura la terminal en modo crudo 8N1
+         * @return true si la configuración se aplicó
+         */
+        bool configurarTerminal() {
+            speed_t velocidad = velocidadTermios(baudios);
+            if (velocidad == B0) return false;
+
+            struct termios opciones;
+            if (tcgetattr(descriptor, &opciones) != 0) return false;
+            cfmakeraw(&opciones);
+            cfsetispeed(&opciones, velocidad);
+            cfsetospeed(&opciones, velocidad);
+            opciones.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
+            opciones.c_cflag |= CS8 | CLOCAL | CREAD;
+            opciones.c_cc[VMIN] = 0;
+            opciones.c_cc[VTIME] = 0;
+            return tcsetattr(descriptor, TCSANOW, &opciones) == 0;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param rutaDispositivo Ruta del dispositivo, pty o FIFO
+         * @param velocidad Velocidad en baudios (solo aplica a terminales)
+         */
+        FuenteSerialPosix(const char* rutaDispositivo, int velocidad)
+            : baudios(velocidad), descriptor(-1) {
+            std::strncpy(ruta, rutaDispositivo, sizeof(ruta) - 1);
+            ruta[sizeof(ruta) - 1] = '\0';
+        }
+
+        ~FuenteSerialPosix() { cerrar(); }
+
+        bool abrir() override {
+            descriptor = ::open(ruta, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+            if (descriptor < 0) return false;
+            if (isatty(descriptor) && !configurarTerminal()) {
+                cerrar();
+                return false;
+            }
+            return true;
+        }
+
+        long leer(char* buffer, std::size_t capacidad, int esperaMs) override {
+            if (descriptor < 0) return -1;
+
+            // Con esperaMs 0 el descriptor ya se esperó (epoll o poll): un solo read()
+            if (esperaMs > 0) {
+                struct pollfd evento;
+                evento.fd = descriptor;
+                evento.events = POLLIN;
+                evento.revents = 0;
+                int listo = ::poll(&evento, 1, esperaMs);
+                if (listo < 0) return errno == EINTR ? 0 : -1;
+                if (listo == 0) return 0;
+            }
+
+            ssize_t leidos = ::read(descriptor, buffer, capacidad);
+            if (leidos > 0) return static_cast<long>(leidos);
+            if (leidos < 0 && (errno == EAGAIN || errno == EINTR)) return 0;
+            return -1; // EOF (escritor cerrado) o error (por ejemplo EIO en una pty sin maestro)
+        }
+
+        void cerrar() override {
+            if (descriptor >= 0) {
+                ::close(descriptor);
+                descriptor = -1;
+            }
+        }
+
+        const char* obtenerRuta() const override { return ruta; }
+
+        int obtenerDescriptor() const override { return descriptor; }
+};
+
+#endif
+
+/**
+ * @brief Crea la fuente serial de la plataforma actual
+ * @param ruta Ruta del puerto (COMx en Windows, /dev/tty* o FIFO en POSIX)
+ * @param baudios Velocidad del puerto
+ * @return Fuente sin abrir; quien llama es dueño del puntero
+ */
+inline FuenteSerial* crearFuenteSerial(const char* ruta, int baudios) {
+#ifdef _WIN32
+    return new FuenteSerialWindows(ruta, baudios);
+#else
+    return new FuenteSerialPosix(ruta, baudios);
+#endif
+}
+
+/**
+ * @brief Ruta por defecto del puerto del ESP32 en la plataforma actual
+ * @return Ruta del puerto
+ */
+inline const char* puertoSerialPorDefecto() {
+#ifdef _WIN32
+    return "\\\\.\\COM6";
+#else
+    return "/dev/ttyUSB0";
+#endif
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef HISTOGRAMALATENCIA_H
+#define HISTOGRAMALATENCIA_H
+
+#include <cstring>
+
+/**
+ * @file HistogramaLatencia.h
+ * @brief Histograma logarítmico de latencias para calcular percentiles
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class HistogramaLatencia
+ * @brief Cuenta latencias en cubetas de ancho proporcional a su valor
+ *
+ * Cada potencia de dos se divide en SUBCUBETAS cubetas iguales, así que
+ * un percentil se reporta con un error relativo menor a 1/SUBCUBETAS
+ * (6 %) sin guardar las muestras. Registrar es O(1) y no asigna memoria.
+ * No es seguro para varios hilos: lo escribe uno solo y se lee cuando
+ * ese hilo terminó.
+ */
+class HistogramaLatencia {
+    public:
+        static const int SUBCUBETAS = 16;                 ///< Cubetas por potencia de dos
+        static const int CUBETAS = (64 - 3) * 16;         ///< Cubre cualquier valor de 63 bits
+
+    private:
+        long long cubetas[CUBETAS]; ///< Muestras por cubeta
+        long long total;            ///< Muestras registradas
+        long long mayor;            ///< Mayor muestra registrada
+
+        /**
+         * @brief Cubeta de un valor
+         */
+        static int indice(unsigned long long valor) {
+            if (valor < static_cast<unsigned long long>(SUBCUBETAS)) return static_cast<int>(valor);
+            int exponente = 63;
+            while ((valor >> exponente) == 0) exponente--;
+            int sub = static_cast<int>((valor >> (exponente - 4)) & (SUBCUBETAS - 1));
+            return (exponente - 3) * SUBCUBETAS + sub;
+        }
+
+        /**
+         * @brief Mayor valor que cae en una cubeta
+         */
+        static long long limiteSuperior(int i) {
+            if (i < SUBCUBETAS) return i;
+            int exponente = i / SUBCUBETAS + 3;
+            int sub = i % SUBCUBETAS;
+            unsigned long long base = (static_cast<unsigned long long>(SUBCUBETAS + sub)) << (exponente - 4);
+            return static_cast<long long>(base + (1ULL << (exponente - 4)) - 1);
+        }
+
+    public:
+        /**
+         * @brief Constructor, histograma vacío
+         */
+        HistogramaLatencia() { reiniciar(); }
+
+        /**
+         * @brief Descarta todas las muestras
+         */
+        void reiniciar() {
+            std::memset(cubetas, 0, sizeof(cubetas));
+            total = 0;
+            mayor = 0;
+        }
+
+        /**
+         * @brief Registra una muestra
+         * @param valor Latencia (los valores negativos cuentan como 0)
+         */
+        void registrar(long long valor) {
+            if (valor < 0) valor = 0;
+            cubetas[indice(static_cast<unsigned long long>(valor))]++;
+            total++;
+            if (valor > mayor) mayor = valor;
+        }
+
+        /**
+         * @brief Número de muestras registradas
+         */
+        long long cantidad() const { return total; }
+
+        /**
+         * @brief Mayor muestra registrada
+         */
+        long long maximo() const { return mayor; }
+
+        /**
+         * @brief Valor bajo el cual queda una fracción de las muestras
+         * @param fraccion Entre 0 y 1 (0.99 = percentil 99)
+         * @return Límite superior de la cubeta del percentil (0 si no hay muestras)
+         */
+        long long percentil(double fraccion) const {
+            if (total == 0) return 0;
+            long long objetivo = static_cast<long long>(fraccion * static_cast<double>(total) + 0.5);
+            if (objetivo < 1) objetivo = 1;
+            long long acumulado = 0;
+            for (int i = 0; i < CUBETAS; i++) {
+                acumulado += cubetas[i];
+                if (acumulado >= objetivo) {
+                    long long limite = limiteSuperior(i);
+                    return limite < mayor ? limite : mayor;
+                }
+            }
+            return mayor;
+        }
+};
+
+#endif
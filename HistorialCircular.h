@@ -0,0 +1,306 @@
+#ifndef HISTORIALCIRCULAR_H
+#define HISTORIALCIRCULAR_H
+
+#include <cstddef>
+#include <utility>
+#include "RasgosHistorial.h"
+#include "RelojMonotonico.h"
+#include "Bitacora.h"
+
+/**
+ * @file HistorialCircular.h
+ * @brief Historial de capacidad fija con retención por cantidad o por tiempo
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class HistorialCircular
+ * @brief Buffer circular preasignado con las últimas lecturas de un sensor
+ * @tparam T Tipo de dato almacenado (int, float, etc.)
+ *
+ * Guarda como máximo capacidad lecturas en un arreglo contiguo reservado
+ * en el constructor; después no vuelve a asignar memoria. Al insertar en
+ * un historial lleno se desaloja la lectura más antigua. Si se indica una
+ * ventana de tiempo, al insertar también se desalojan las lecturas más
+ * viejas que la ventana (las marcas de tiempo se guardan en un segundo
+ * arreglo del mismo tamaño); como un sensor puede dejar de reportar,
+ * quien lo consulta llama antes a expirarVencidas(). Cada lectura
+ * desalojada se informa a quien inserta o consulta, para que mantenga
+ * sus estadísticas.
+ *
+ * Ofrece la misma interfaz que ListaSensor (insertar, busqueda,
+ * eliminarValor, obtenerTamanio, paraCadaBloque).
+ */
+template <typename T>
+class HistorialCircular {
+    public:
+        typedef T TipoValor; ///< Tipo de las lecturas
+
+    private:
+        T* datos;              ///< Lecturas (capacidad ranuras)
+        long long* marcas;     ///< Instante de cada lectura en ns (nullptr sin ventana)
+        int capacidad;         ///< Lecturas que caben
+        int inicio;            ///< Ranura de la lectura más antigua
+        int tamanio;           ///< Lecturas almacenadas
+        long long ventanaNs;   ///< Antigüedad máxima en ns (0 = sin límite de tiempo)
+
+        /**
+         * @brief Ranura física de la i-ésima lectura (0 = la más antigua)
+         */
+        int ranura(int i) const {
+            int r = inicio + i;
+            return r >= capacidad ? r - capacidad : r;
+        }
+
+        /**
+         * @brief Quita la lectura más antigua
+         * @return Valor desalojado
+         */
+        T desalojarAntigua() {
+            T valor = datos[inicio];
+            inicio = inicio + 1 == capacidad ? 0 : inicio + 1;
+            tamanio--;
+            return valor;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param capacidadMaxima Lecturas a conservar (al menos 1)
+         * @param ventanaSegundos Antigüedad máxima de una lectura (0 = sin límite)
+         * @post Memoria reservada para todas las lecturas; historial vacío
+         */
+        explicit HistorialCircular(int capacidadMaxima = 1024, double ventanaSegundos = 0.0)
+            : marcas(nullptr), capacidad(capacidadMaxima > 0 ? capacidadMaxima : 1), inicio(0), tamanio(0),
+              ventanaNs(static_cast<long long>(ventanaSegundos * 1e9)) {
+            datos = new T[capacidad];
+            if (ventanaNs > 0) {
+                marcas = new long long[capacidad];
+            }
+        }
+
+        /**
+         * @brief Constructor de copia
+         * @param otro Historial a copiar (misma capacidad, ventana y lecturas)
+         */
+        HistorialCircular(const HistorialCircular& otro)
+            : marcas(nullptr), capacidad(otro.capacidad), inicio(0), tamanio(otro.tamanio), ventanaNs(otro.ventanaNs) {
+            datos = new T[capacidad];
+            if (otro.marcas != nullptr) {
+                marcas = new long long[capacidad];
+            }
+            for (int i = 0; i < tamanio; i++) {
+                datos[i] = otro.datos[otro.ranura(i)];
+                if (marcas != nullptr) marcas[i] = otro.marcas[otro.ranura(i)];
+            }
+        }
+
+        /**
+         * @brief Operador de asignación
+         * @param otro Historial a copiar
+         * @return Referencia a este historial
+         */
+        HistorialCircular& operator=(const HistorialCircular& otro) {
+            if (this != &otro) {
+                HistorialCircular copia(otro);
+                std::swap(datos, copia.datos);
+                std::swap(marcas, copia.marcas);
+                std::swap(capacidad, copia.capacidad);
+                std::swap(inicio, copia.inicio);
+                std::swap(tamanio, copia.tamanio);
+                std::swap(ventanaNs, copia.ventanaNs);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor, libera los arreglos
+         */
+        ~HistorialCircular() {
+            IOT_DEPURACION("Historial circular con " << tamanio << " valores destruido");
+            delete[] datos;
+            delete[] marcas;
+        }
+
+        /**
+         * @brief Desaloja las lecturas más viejas que la ventana
+         * @param ahoraNs Instante de referencia
+         * @param alDesalojar Función llamada con cada valor desalojado
+         */
+        template <typename F>
+        void expirar(long long ahoraNs, F alDesalojar) {
+            if (marcas == nullptr) return;
+            while (tamanio > 0 && ahoraNs - marcas[inicio] > ventanaNs) {
+                alDesalojar(desalojarAntigua());
+            }
+        }
+
+        /**
+         * @brief Desaloja las lecturas que ya salieron de la ventana al instante actual
+         * @param alDesalojar Función llamada con cada valor desalojado
+         * @post Sin ventana de tiempo no hace nada (ni consulta el reloj)
+         */
+        template <typename F>
+        void expirarVencidas(F alDesalojar) {
+            if (marcas == nullptr || tamanio == 0) return;
+            expirar(instanteActualNs(), alDesalojar);
+        }
+
+        /**
+         * @brief Inserta una lectura con marca de tiempo explícita
+         * @param valor Valor a insertar
+         * @param marcaNs Instante de la lectura (no decreciente entre llamadas;
+         *        0 = instante actual)
+         * @param alDesalojar Función llamada con cada valor desalojado
+         * @post La lectura queda como la más reciente; O(1) más los desalojos por tiempo
+         */
+        template <typename F>
+        void insertarEn(T valor, long long marcaNs, F alDesalojar) {
+            if (marcas == nullptr) {
+                marcaNs = 0;
+            } else if (marcaNs == 0) {
+                marcaNs = instanteActualNs();
+            }
+            expirar(marcaNs, alDesalojar);
+            if (tamanio == capacidad) {
+                alDesalojar(desalojarAntigua());
+            }
+            int r = ranura(tamanio);
+            datos[r] = valor;
+            if (marcas != nullptr) marcas[r] = marcaNs;
+            tamanio++;
+            IOT_DEPURACION("Valor insertado: " << valor);
+        }
+
+        /**
+         * @brief Inserta una lectura con el instante actual
+         * @param valor Valor a insertar
+         * @param alDesalojar Función llamada con cada valor desalojado
+         */
+        template <typename F>
+        void insertar(T valor, F alDesalojar) {
+            insertarEn(valor, 0, alDesalojar);
+        }
+
+        /**
+         * @brief Inserta una lectura descartando lo desalojado
+         * @param valor Valor a insertar
+         */
+        void insertar(T valor) {
+            insertar(valor, [](T) {});
+        }
+
+        /**
+         * @brief Busca un valor en el historial
+         * @param valor Valor a buscar
+         * @return true si el valor existe
+         */
+        bool busqueda(T valor) const {
+            for (int i = 0; i < tamanio; i++) {
+                if (datos[ranura(i)] == valor) return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Elimina la primera aparición (la más antigua) de un valor
+         * @param valor Valor a eliminar
+         * @return true si se eliminó, false si no se encontró
+         *
+         * Recorre el lado más corto para cerrar el hueco, así el historial
+         * sigue siendo contiguo en orden de llegada.
+         */
+        bool eliminarValor(T valor) {
+            int i = 0;
+            while (i < tamanio && datos[ranura(i)] != valor) i++;
+            if (i == tamanio) {
+                IOT_DEPURACION("Valor no encontrado: " << valor);
+                return false;
+            }
+            if (i < tamanio / 2) {
+                for (int j = i; j > 0; j--) {
+                    datos[ranura(j)] = datos[ranura(j - 1)];
+                    if (marcas != nullptr) marcas[ranura(j)] = marcas[ranura(j - 1)];
+                }
+                inicio = inicio + 1 == capacidad ? 0 : inicio + 1;
+            } else {
+                for (int j = i; j < tamanio - 1; j++) {
+                    datos[ranura(j)] = datos[ranura(j + 1)];
+                    if (marcas != nullptr) marcas[ranura(j)] = marcas[ranura(j + 1)];
+                }
+            }
+            tamanio--;
+            IOT_DEPURACION("Nodo eliminado: " << valor);
+            return true;
+        }
+
+        /**
+         * @brief Obtiene el número de lecturas almacenadas
+         */
+        int obtenerTamanio() const { return tamanio; }
+
+        /**
+         * @brief Indica si hay ventana de tiempo
+         */
+        bool tieneVentana() const { return marcas != nullptr; }
+
+        /**
+         * @brief Obtiene la capacidad fija
+         */
+        int obtenerCapacidad() const { return capacidad; }
+
+        /**
+         * @brief Obtiene la ventana de tiempo en segundos (0 = sin límite)
+         */
+        double obtenerVentanaSegundos() const { return static_cast<double>(ventanaNs) / 1e9; }
+
+        /**
+         * @brief Memoria reservada para lecturas y marcas de tiempo
+         * @return Bytes, constantes desde la construcción
+         */
+        std::size_t bytesReservados() const {
+            return static_cast<std::size_t>(capacidad) * (sizeof(T) + (marcas != nullptr ? sizeof(long long) : 0));
+        }
+
+        /**
+         * @brief Recorre las lecturas por tramos contiguos, de la más antigua a la más reciente
+         * @param f Función con firma f(const T* datos, int cantidad); se llama a lo sumo dos veces
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            if (tamanio == 0) return;
+            int primerTramo = capacidad - inicio < tamanio ? capacidad - inicio : tamanio;
+            f(static_cast<const T*>(datos + inicio), primerTramo);
+            if (primerTramo < tamanio) {
+                f(static_cast<const T*>(datos), tamanio - primerTramo);
+            }
+        }
+};
+
+/**
+ * @brief Un HistorialCircular con ventana vence lecturas aunque no reciba otras
+ */
+template <typename T>
+inline bool expiraPorTiempo(const HistorialCircular<T>& historial) { return historial.tieneVentana(); }
+
+/**
+ * @brief Rasgos de HistorialCircular: insertar puede desalojar lecturas
+ */
+template <typename T>
+struct RasgosHistorial<HistorialCircular<T> > {
+    static const bool desaloja = true;
+    static const bool monticuloMinimos = false;
+
+    template <typename F>
+    static void insertar(HistorialCircular<T>& historial, T valor, long long marcaNs, F alDesalojar) {
+        historial.insertarEn(valor, marcaNs, alDesalojar);
+    }
+
+    template <typename F>
+    static void expirar(HistorialCircular<T>& historial, F alDesalojar) {
+        historial.expirarVencidas(alDesalojar);
+    }
+};
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef HISTORIALCOMPRIMIDO_H
+#define HISTORIALCOMPRIMIDO_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include "CodificacionSerie.h"
+#include "RasgosHistorial.h"
+#include "RelojMonotonico.h"
+#include "NivelesResumen.h"
+#include "Bitacora.h"
+
+/**
+ * @file HistorialComprimido.h
+ * @brief Historial en bloques sellados y comprimidos
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class HistorialComprimido
+ * @brief Lecturas comprimidas por bloques con CodificadorSerie<T>
+ * @tparam T Tipo de dato almacenado (float o int)
+ *
+ * Las lecturas se acumulan sin comprimir en un bloque abierto de
+ * TAMANIO_BLOQUE valores; al llenarse, el bloque se codifica y queda
+ * sellado en un arreglo de bytes de tamaño exacto. Los bloques sellados
+ * no se modifican: eliminarValor() reemplaza el bloque afectado por uno
+ * nuevo codificado sin la lectura.
+ *
+ * Los recorridos decodifican un bloque a la vez: paraCadaBloque() entrega
+ * cada bloque descomprimido en un arreglo local (así minimoHistorial() y
+ * promedioHistorial() siguen usando los kernels de Agregados) y Cursor
+ * entrega las lecturas una por una sin descomprimir bloques completos.
+ *
+ * Opcionalmente guarda también la marca de tiempo de cada lectura, como
+ * SerieTemporal, en una segunda columna por bloque codificada con
+ * CodificadorMarcas (delta de deltas). Cada bloque sellado conserva sin
+ * codificar su primera y su última marca, así que resumenEntre() y
+ * paraCadaBloqueEntre() saltan los bloques fuera de la ventana sin
+ * decodificarlos.
+ *
+ * Ofrece la misma interfaz que ListaSensor (insertar, busqueda,
+ * eliminarValor, obtenerTamanio, paraCadaBloque).
+ */
+template <typename T>
+class HistorialComprimido {
+    public:
+        typedef T TipoValor; ///< Tipo de las lecturas
+
+        static const int TAMANIO_BLOQUE = 1024; ///< Lecturas por bloque sellado
+
+    private:
+        /**
+         * @struct BloqueSellado
+         * @brief Bloque codificado e inmutable
+         */
+        struct BloqueSellado {
+            std::vector<unsigned char> bytes;  ///< Lecturas codificadas
+            std::vector<unsigned char> marcas; ///< Marcas codificadas (vacío si no se guardan)
+            long long primeraMarca;            ///< Marca de la primera lectura (0 sin marcas)
+            long long ultimaMarca;             ///< Marca de la última lectura (0 sin marcas)
+            int cantidad;                      ///< Lecturas del bloque
+        };
+
+        std::vector<BloqueSellado> sellados; ///< Bloques en orden de llegada
+        std::vector<T> abierto;              ///< Lecturas aún sin comprimir (capacidad TAMANIO_BLOQUE)
+        std::vector<long long> marcasAbierto; ///< Marcas del bloque abierto (vacío sin marcas)
+        bool conMarcas;                      ///< Se guarda la columna de marcas
+        long long ultimaMarca;               ///< Marca de la lectura más reciente
+        int tamanio;                         ///< Lecturas almacenadas
+
+        /**
+         * @brief Codifica un arreglo en bytes de tamaño exacto
+         */
+        template <typename Codificador, typename V>
+        static void codificarExacto(const V* datos, int n, std::vector<unsigned char>& destino) {
+            std::vector<unsigned char> trabajo;
+            trabajo.reserve(static_cast<std::size_t>(n) * (sizeof(V) + 2) + 8);
+            Codificador::codificar(datos, n, trabajo);
+            destino.assign(trabajo.begin(), trabajo.end());
+        }
+
+        /**
+         * @brief Codifica lecturas en un bloque sellado de tamaño exacto
+         * @param datos Lecturas
+         * @param marcas Marcas de las lecturas (nullptr si no se guardan)
+         * @param n Número de lecturas (al menos 1)
+         */
+        static BloqueSellado sellar(const T* datos, const long long* marcas, int n) {
+            BloqueSellado bloque;
+            codificarExacto<CodificadorSerie<T> >(datos, n, bloque.bytes);
+            bloque.primeraMarca = 0;
+            bloque.ultimaMarca = 0;
+            if (marcas != nullptr) {
+                codificarExacto<CodificadorMarcas>(marcas, n, bloque.marcas);
+                bloque.primeraMarca = marcas[0];
+                bloque.ultimaMarca = marcas[n - 1];
+            }
+            bloque.cantidad = n;
+            return bloque;
+        }
+
+        /**
+         * @brief Decodifica las marcas de un bloque sellado
+         * @param bloque Bloque con marcas
+         * @param destino Arreglo de al menos bloque.cantidad marcas
+         */
+        static void decodificarMarcas(const BloqueSellado& bloque, long long* destino) {
+            CodificadorMarcas::Decodificador decodificador(bloque.marcas.data(), bloque.marcas.size(), bloque.cantidad);
+            int i = 0;
+            while (decodificador.siguiente(destino[i])) i++;
+        }
+
+        /**
+         * @brief Entrega la parte de un bloque con marca en [t0, t1)
+         */
+        template <typename F>
+        static void entregarEntre(const long long* marcas, const T* datos, int n, long long t0, long long t1, F& f) {
+            int desde = static_cast<int>(std::lower_bound(marcas, marcas + n, t0) - marcas);
+            int hasta = static_cast<int>(std::lower_bound(marcas + desde, marcas + n, t1) - marcas);
+            if (desde < hasta) f(marcas + desde, datos + desde, hasta - desde);
+        }
+
+        /**
+         * @brief Decodifica un bloque sellado completo
+         * @param bloque Bloque a decodificar
+         * @param destino Arreglo de al menos bloque.cantidad lecturas
+         */
+        static void decodificar(const BloqueSellado& bloque, T* destino) {
+            typename CodificadorSerie<T>::Decodificador decodificador(bloque.bytes.data(), bloque.bytes.size(), bloque.cantidad);
+            int i = 0;
+            while (decodificador.siguiente(destino[i])) i++;
+        }
+
+    public:
+        /**
+         * @class Cursor
+         * @brief Recorre las lecturas en orden de llegada decodificando sobre la marcha
+         */
+        class Cursor {
+            private:
+                const HistorialComprimido* historial; ///< Historial recorrido
+                std::size_t bloque;                   ///< Bloque sellado actual
+                int posicionAbierto;                  ///< Posición en el bloque abierto
+                typename CodificadorSerie<T>::Decodificador decodificador; ///< Estado del bloque actual
+
+                /**
+                 * @brief Decodificador del bloque sellado b (vacío si no existe)
+                 */
+                typename CodificadorSerie<T>::Decodificador decodificadorDe(std::size_t b) const {
+                    if (b >= historial->sellados.size()) {
+                        return typename CodificadorSerie<T>::Decodificador(nullptr, 0, 0);
+                    }
+                    const BloqueSellado& sellado = historial->sellados[b];
+                    return typename CodificadorSerie<T>::Decodificador(sellado.bytes.data(), sellado.bytes.size(), sellado.cantidad);
+                }
+
+            public:
+                /**
+                 * @brief Constructor, se coloca antes de la primera lectura
+                 * @param origen Historial a recorrer (no debe modificarse durante el recorrido)
+                 */
+                explicit Cursor(const HistorialComprimido& origen)
+                    : historial(&origen), bloque(0), posicionAbierto(0), decodificador(decodificadorDe(0)) {}
+
+                /**
+                 * @brief Avanza a la siguiente lectura
+                 * @param valor Lectura
+                 * @return false al terminar
+                 */
+                bool siguiente(T& valor) {
+                    while (bloque < historial->sellados.size()) {
+                        if (decodificador.siguiente(valor)) return true;
+                        bloque++;
+                        decodificador = decodificadorDe(bloque);
+                    }
+                    if (posicionAbierto < static_cast<int>(historial->abierto.size())) {
+                        valor = historial->abierto[posicionAbierto++];
+                        return true;
+                    }
+                    return false;
+                }
+        };
+
+        /**
+         * @brief Constructor, historial vacío
+         * @param guardarMarcas Guardar también la marca de tiempo de cada lectura
+         */
+        explicit HistorialComprimido(bool guardarMarcas = false) : conMarcas(guardarMarcas), ultimaMarca(0), tamanio(0) {
+            abierto.reserve(TAMANIO_BLOQUE);
+            if (conMarcas) marcasAbierto.reserve(TAMANIO_BLOQUE);
+        }
+
+        /**
+         * @brief Destructor
+         */
+        ~HistorialComprimido() {
+            IOT_DEPURACION("Historial comprimido con " << tamanio << " valores destruido");
+        }
+
+        /**
+         * @brief Inserta una lectura al final con su marca de tiempo
+         * @param valor Valor a insertar
+         * @param marcaNs Instante de la lectura; 0 = instante actual. Si es
+         *        anterior a la última marca se toma la última, para que las
+         *        marcas sigan ordenadas. Se ignora si no se guardan marcas.
+         * @post Si el bloque abierto se llena, se codifica y se sella
+         */
+        void insertarEn(T valor, long long marcaNs) {
+            abierto.push_back(valor);
+            if (conMarcas) {
+                if (marcaNs == 0) marcaNs = instanteActualNs();
+                if (tamanio > 0 && marcaNs < ultimaMarca) marcaNs = ultimaMarca;
+                marcasAbierto.push_back(marcaNs);
+                ultimaMarca = marcaNs;
+            }
+            tamanio++;
+            if (static_cast<int>(abierto.size()) == TAMANIO_BLOQUE) {
+                sellados.push_back(sellar(abierto.data(), conMarcas ? marcasAbierto.data() : nullptr, TAMANIO_BLOQUE));
+                abierto.clear();
+                marcasAbierto.clear();
+            }
+            IOT_DEPURACION("Valor insertado: " << valor);
+        }
+
+        /**
+         * @brief Inserta una lectura al final con el instante actual
+         * @param valor Valor a insertar
+         */
+        void insertar(T valor) { insertarEn(valor, 0); }
+
+        /**
+         * @brief Busca un valor en el historial
+         * @param valor Valor a buscar
+         * @return true si el valor existe
+         */
+        bool busqueda(T valor) const {
+            Cursor cursor(*this);
+            T actual;
+            while (cursor.siguiente(actual)) {
+                if (actual == valor) return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Elimina la primera aparición (la más antigua) de un valor
+         * @param valor Valor a eliminar
+         * @return true si se eliminó, false si no se encontró
+         * @post El bloque sellado que la contenía se reemplaza por uno nuevo
+         */
+        bool eliminarValor(T valor) {
+            T buffer[TAMANIO_BLOQUE];
+            long long marcas[TAMANIO_BLOQUE];
+            for (std::size_t b = 0; b < sellados.size(); b++) {
+                int n = sellados[b].cantidad;
+                decodificar(sellados[b], buffer);
+                int i = 0;
+                while (i < n && buffer[i] != valor) i++;
+                if (i == n) continue;
+
+                for (int j = i; j < n - 1; j++) buffer[j] = buffer[j + 1];
+                if (conMarcas) {
+                    decodificarMarcas(sellados[b], marcas);
+                    for (int j = i; j < n - 1; j++) marcas[j] = marcas[j + 1];
+                }
+                if (n == 1) {
+                    sellados.erase(sellados.begin() + b);
+                } else {
+                    sellados[b] = sellar(buffer, conMarcas ? marcas : nullptr, n - 1);
+                }
+                tamanio--;
+                IOT_DEPURACION("Nodo eliminado: " << valor);
+                return true;
+            }
+            for (std::size_t i = 0; i < abierto.size(); i++) {
+                if (abierto[i] == valor) {
+                    abierto.erase(abierto.begin() + i);
+                    if (conMarcas) marcasAbierto.erase(marcasAbierto.begin() + i);
+                    tamanio--;
+                    IOT_DEPURACION("Nodo eliminado: " << valor);
+                    return true;
+                }
+            }
+            IOT_DEPURACION("Valor no encontrado: " << valor);
+            return false;
+        }
+
+        /**
+         * @brief Obtiene el número de lecturas almacenadas
+         */
+        int obtenerTamanio() const { return tamanio; }
+
+        /**
+         * @brief Indica si se guarda la marca de tiempo de cada lectura
+         */
+        bool tieneMarcas() const { return conMarcas; }
+
+        /**
+         * @brief Marca de la lectura más reciente (0 si está vacío o no guarda marcas)
+         */
+        long long obtenerUltimaMarca() const { return tamanio > 0 ? ultimaMarca : 0; }
+
+        /**
+         * @brief Bytes de la columna de marcas: codificadas más las del bloque abierto
+         */
+        std::size_t bytesMarcas() const {
+            std::size_t total = marcasAbierto.size() * sizeof(long long);
+            for (std::size_t b = 0; b < sellados.size(); b++) total += sellados[b].marcas.size();
+            return total;
+        }
+
+        /**
+         * @brief Bytes de las lecturas y marcas codificadas más los del bloque abierto
+         */
+        std::size_t bytesComprimidos() const {
+            std::size_t total = abierto.size() * sizeof(T) + bytesMarcas();
+            for (std::size_t b = 0; b < sellados.size(); b++) total += sellados[b].bytes.size();
+            return total;
+        }
+
+        /**
+         * @brief Memoria reservada, incluidos los descriptores de bloque y el bloque abierto
+         * @return Bytes
+         */
+        std::size_t bytesReservados() const {
+            std::size_t total = sellados.capacity() * sizeof(BloqueSellado) + abierto.capacity() * sizeof(T) +
+                                marcasAbierto.capacity() * sizeof(long long);
+            for (std::size_t b = 0; b < sellados.size(); b++) {
+                total += sellados[b].bytes.capacity() + sellados[b].marcas.capacity();
+            }
+            return total;
+        }
+
+        /**
+         * @brief Tamaño sin comprimir entre tamaño comprimido
+         * @return Razón de compresión frente a un arreglo de T (y otro de
+         *         marcas si se guardan); 0 si está vacío
+         */
+        double razonCompresion() const {
+            std::size_t comprimidos = bytesComprimidos();
+            std::size_t porLectura = sizeof(T) + (conMarcas ? sizeof(long long) : 0);
+            return comprimidos > 0 ? static_cast<double>(tamanio) * porLectura / comprimidos : 0.0;
+        }
+
+        /**
+         * @brief Recorre las lecturas con marca en [t0, t1) por tramos contiguos
+         * @param t0 Inicio de la ventana (incluido), en ns del reloj monotónico
+         * @param t1 Fin de la ventana (excluido)
+         * @param f Función f(const long long* marcas, const T* valores, int cantidad)
+         *
+         * Solo se decodifican los bloques que se cruzan con la ventana. Sin
+         * marcas no entrega nada.
+         */
+        template <typename F>
+        void paraCadaBloqueEntre(long long t0, long long t1, F f) const {
+            if (!conMarcas || t0 >= t1) return;
+            T buffer[TAMANIO_BLOQUE];
+            long long marcas[TAMANIO_BLOQUE];
+            for (std::size_t b = 0; b < sellados.size(); b++) {
+                const BloqueSellado& bloque = sellados[b];
+                if (bloque.ultimaMarca < t0) continue;
+                if (bloque.primeraMarca >= t1) return;
+                decodificar(bloque, buffer);
+                decodificarMarcas(bloque, marcas);
+                entregarEntre(marcas, buffer, bloque.cantidad, t0, t1, f);
+            }
+            if (!abierto.empty()) {
+                entregarEntre(marcasAbierto.data(), abierto.data(), static_cast<int>(abierto.size()), t0, t1, f);
+            }
+        }
+
+        /**
+         * @brief Resume las lecturas con marca en [t0, t1)
+         * @param t0 Inicio de la ventana (incluido), en ns del reloj monotónico
+         * @param t1 Fin de la ventana (excluido)
+         * @return Cantidad, suma, mínimo y máximo de la ventana (vacío sin marcas)
+         */
+        ResumenVentana<T> resumenEntre(long long t0, long long t1) const {
+            ResumenVentana<T> resumen = ResumenVentana<T>::vacio();
+            paraCadaBloqueEntre(t0, t1, [&resumen](const long long*, const T* datos, int cantidad) {
+                resumen.combinar(ResumenVentana<T>::deBloque(datos, cantidad));
+            });
+            return resumen;
+        }
+
+        /**
+         * @brief Recorre las lecturas por bloques, en orden de llegada
+         * @param f Función con firma f(const T* datos, int cantidad)
+         *
+         * Cada bloque sellado se decodifica en un arreglo local antes de
+         * entregarlo; el bloque abierto se entrega sin copiar.
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            T buffer[TAMANIO_BLOQUE];
+            for (std::size_t b = 0; b < sellados.size(); b++) {
+                decodificar(sellados[b], buffer);
+                f(static_cast<const T*>(buffer), sellados[b].cantidad);
+            }
+            if (!abierto.empty()) {
+                f(static_cast<const T*>(abierto.data()), static_cast<int>(abierto.size()));
+            }
+        }
+};
+
+/**
+ * @brief Rasgos de HistorialComprimido: sin montículo de mínimos, que
+ *        ocuparía más memoria que las propias lecturas comprimidas
+ */
+template <typename T>
+struct RasgosHistorial<HistorialComprimido<T> > {
+    static const bool desaloja = false;
+    static const bool monticuloMinimos = false;
+
+    template <typename F>
+    static void insertar(HistorialComprimido<T>& historial, T valor, long long marcaNs, F) {
+        historial.insertarEn(valor, marcaNs);
+    }
+
+    template <typename F>
+    static void expirar(HistorialComprimido<T>&, F) {}
+};
+
+/**
+ * @brief Imprime el tamaño comprimido en mostrarInfo
+ * @param historial Historial comprimido
+ */
+template <typename T>
+inline void mostrarDetalleHistorial(const HistorialComprimido<T>& historial) {
+    std::cout << "Historial comprimido: " << historial.bytesComprimidos() << " bytes";
+    if (historial.tieneMarcas()) std::cout << " (" << historial.bytesMarcas() << " de marcas de tiempo)";
+    std::cout << ", razon " << historial.razonCompresion() << ":1" << std::endl;
+}
+
+#endif
@@ -0,0 +1,463 @@
+#ifndef HISTORIALINDEXADO_H
+#define HISTORIALINDEXADO_H
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include "RasgosHistorial.h"
+#include "Bitacora.h"
+
+/**
+ * @file HistorialIndexado.h
+ * @brief Historial en orden de llegada con un índice ordenado por valor (skip list)
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class HistorialIndexado
+ * @brief Lecturas en orden de llegada, indexadas además por valor
+ * @tparam T Tipo de dato almacenado (float o int)
+ *
+ * Cada lectura es un nodo de dos estructuras a la vez:
+ * - una lista doble en orden de llegada, que es la que recorre
+ *   paraCadaBloque() y la que permite desenlazar un nodo en O(1);
+ * - una skip list ordenada por (valor, orden de llegada), con la
+ *   cantidad de nodos que salta cada enlace.
+ *
+ * Así busqueda, eliminarValor, el mínimo, el máximo y el conteo de
+ * lecturas en un rango cuestan O(log n) esperado en lugar de recorrer
+ * el historial. Con valores repetidos, eliminarValor quita el que llegó
+ * primero, igual que ListaSensor. El costo es memoria: unos 40 bytes
+ * más por lectura que ListaSensor.
+ *
+ * Ofrece la misma interfaz que ListaSensor (insertar, busqueda,
+ * eliminarValor, obtenerTamanio, paraCadaBloque).
+ */
+template <typename T>
+class HistorialIndexado {
+    public:
+        typedef T TipoValor; ///< Tipo de las lecturas
+
+        static const int NIVELES_MAXIMOS = 24; ///< Altura máxima del índice (4^24 lecturas)
+
+    private:
+        struct Nodo;
+
+        /**
+         * @struct Enlace
+         * @brief Enlace de un nivel del índice
+         */
+        struct Enlace {
+            Nodo* sig;          ///< Siguiente nodo en este nivel (nullptr = fin)
+            std::size_t salto;  ///< Nodos del nivel 0 que avanza este enlace
+        };
+
+        /**
+         * @struct Nodo
+         * @brief Lectura con sus enlaces de llegada; los enlaces del índice van a continuación
+         */
+        struct Nodo {
+            T dato;                    ///< Valor de la lectura
+            unsigned long long orden;  ///< Número de llegada, desempata valores iguales
+            Nodo* anterior;            ///< Lectura anterior en orden de llegada
+            Nodo* siguiente;           ///< Lectura siguiente en orden de llegada
+
+            /**
+             * @brief Enlaces del índice, guardados justo después del nodo
+             */
+            Enlace* niveles() { return reinterpret_cast<Enlace*>(this + 1); }
+            const Enlace* niveles() const { return reinterpret_cast<const Enlace*>(this + 1); }
+        };
+
+        Nodo* cabecera;   ///< Centinela del índice con NIVELES_MAXIMOS niveles
+        Nodo* primero;    ///< Lectura más antigua
+        Nodo* ultimo;     ///< Lectura más reciente
+        Nodo* mayor;      ///< Último nodo del nivel 0 del índice (valor máximo)
+        int nivel;        ///< Niveles del índice en uso
+        int tamanio;      ///< Cantidad de lecturas
+        unsigned long long siguienteOrden; ///< Número de llegada de la próxima lectura
+        unsigned int semilla; ///< Estado del generador de alturas (xorshift)
+
+        /**
+         * @brief Reserva un nodo con sus enlaces de índice
+         * @param altura Niveles del nodo
+         */
+        static Nodo* nuevoNodo(int altura) {
+            void* memoria = ::operator new(sizeof(Nodo) + static_cast<std::size_t>(altura) * sizeof(Enlace));
+            Nodo* nodo = new (memoria) Nodo();
+            for (int i = 0; i < altura; i++) {
+                nodo->niveles()[i].sig = nullptr;
+                nodo->niveles()[i].salto = 0;
+            }
+            return nodo;
+        }
+
+        /**
+         * @brief Destruye y libera un nodo
+         */
+        static void liberarNodo(Nodo* nodo) {
+            nodo->~Nodo();
+            ::operator delete(nodo);
+        }
+
+        /**
+         * @brief Altura de un nodo nuevo: cada nivel extra con probabilidad 1/4
+         */
+        int alturaAleatoria() {
+            int altura = 1;
+            while (altura < NIVELES_MAXIMOS) {
+                semilla ^= semilla << 13;
+                semilla ^= semilla >> 17;
+                semilla ^= semilla << 5;
+                if ((semilla & 3u) != 0) break;
+                altura++;
+            }
+            return altura;
+        }
+
+        /**
+         * @brief Baja por el índice mientras el valor del siguiente nodo cumpla avanza
+         * @param avanza Predicado monótono sobre el valor (true al principio del orden)
+         * @param previos Si no es nullptr, recibe el último nodo de cada nivel que cumple
+         * @return Nodos que cumplen avanza
+         */
+        template <typename Avanza>
+        std::size_t descender(Avanza avanza, Nodo** previos) const {
+            Nodo* actual = cabecera;
+            std::size_t cuenta = 0;
+            for (int i = nivel - 1; i >= 0; i--) {
+                while (actual->niveles()[i].sig != nullptr && avanza(actual->niveles()[i].sig->dato)) {
+                    cuenta += actual->niveles()[i].salto;
+                    actual = actual->niveles()[i].sig;
+                }
+                if (previos != nullptr) previos[i] = actual;
+            }
+            return cuenta;
+        }
+
+        /**
+         * @brief Quita un nodo del índice y de la lista de llegada
+         * @param nodo Nodo a quitar
+         * @param previos Predecesores de nodo en cada nivel (de descender)
+         */
+        void quitarNodo(Nodo* nodo, Nodo** previos) {
+            for (int i = 0; i < nivel; i++) {
+                Enlace& enlace = previos[i]->niveles()[i];
+                if (enlace.sig == nodo) {
+                    enlace.salto += nodo->niveles()[i].salto - 1;
+                    enlace.sig = nodo->niveles()[i].sig;
+                } else {
+                    enlace.salto--;
+                }
+            }
+            if (nodo == mayor) mayor = previos[0] == cabecera ? nullptr : previos[0];
+            while (nivel > 1 && cabecera->niveles()[nivel - 1].sig == nullptr) nivel--;
+
+            if (nodo->anterior != nullptr) nodo->anterior->siguiente = nodo->siguiente;
+            else primero = nodo->siguiente;
+            if (nodo->siguiente != nullptr) nodo->siguiente->anterior = nodo->anterior;
+            else ultimo = nodo->anterior;
+            tamanio--;
+            liberarNodo(nodo);
+        }
+
+        /**
+         * @brief Predicado "valor < umbral" para descender
+         */
+        struct MenorQue {
+            T umbral;
+            bool operator()(const T& v) const { return v < umbral; }
+        };
+
+        /**
+         * @brief Predicado "valor <= umbral" para descender
+         */
+        struct MenorOIgualQue {
+            T umbral;
+            bool operator()(const T& v) const { return !(umbral < v); }
+        };
+
+        /**
+         * @brief Deja el historial vacío, sin liberar la cabecera
+         */
+        void vaciar() {
+            Nodo* actual = primero;
+            while (actual != nullptr) {
+                Nodo* sig = actual->siguiente;
+                liberarNodo(actual);
+                actual = sig;
+            }
+            for (int i = 0; i < NIVELES_MAXIMOS; i++) {
+                cabecera->niveles()[i].sig = nullptr;
+                cabecera->niveles()[i].salto = 0;
+            }
+            primero = nullptr;
+            ultimo = nullptr;
+            mayor = nullptr;
+            nivel = 1;
+            tamanio = 0;
+        }
+
+    public:
+        /**
+         * @brief Constructor, historial vacío
+         */
+        HistorialIndexado()
+            : cabecera(nuevoNodo(NIVELES_MAXIMOS)), primero(nullptr), ultimo(nullptr), mayor(nullptr),
+              nivel(1), tamanio(0), siguienteOrden(0), semilla(2463534242u) {}
+
+        /**
+         * @brief Constructor de copia
+         * @param otra Historial a copiar
+         * @post Mismas lecturas en el mismo orden de llegada
+         */
+        HistorialIndexado(const HistorialIndexado& otra)
+            : cabecera(nuevoNodo(NIVELES_MAXIMOS)), primero(nullptr), ultimo(nullptr), mayor(nullptr),
+              nivel(1), tamanio(0), siguienteOrden(0), semilla(2463534242u) {
+            for (Nodo* actual = otra.primero; actual != nullptr; actual = actual->siguiente) {
+                insertar(actual->dato);
+            }
+        }
+
+        /**
+         * @brief Operador de asignación
+         * @param otra Historial a copiar
+         * @return Referencia a este historial
+         */
+        HistorialIndexado& operator=(const HistorialIndexado& otra) {
+            if (this != &otra) {
+                vaciar();
+                for (Nodo* actual = otra.primero; actual != nullptr; actual = actual->siguiente) {
+                    insertar(actual->dato);
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor, libera todos los nodos
+         */
+        ~HistorialIndexado() {
+            vaciar();
+            liberarNodo(cabecera);
+        }
+
+        /**
+         * @brief Inserta una lectura al final del orden de llegada y en el índice
+         * @param valor Lectura a insertar
+         * @post O(log n) esperado
+         */
+        void insertar(T valor) {
+            Nodo* previos[NIVELES_MAXIMOS];
+            std::size_t rangos[NIVELES_MAXIMOS];
+            Nodo* actual = cabecera;
+            // Los iguales quedan antes: el nuevo es el último en llegar
+            for (int i = nivel - 1; i >= 0; i--) {
+                rangos[i] = i == nivel - 1 ? 0 : rangos[i + 1];
+                while (actual->niveles()[i].sig != nullptr && !(valor < actual->niveles()[i].sig->dato)) {
+                    rangos[i] += actual->niveles()[i].salto;
+                    actual = actual->niveles()[i].sig;
+                }
+                previos[i] = actual;
+            }
+
+            int altura = alturaAleatoria();
+            if (altura > nivel) {
+                for (int i = nivel; i < altura; i++) {
+                    rangos[i] = 0;
+                    previos[i] = cabecera;
+                    cabecera->niveles()[i].salto = static_cast<std::size_t>(tamanio);
+                }
+                nivel = altura;
+            }
+
+            Nodo* nodo = nuevoNodo(altura);
+            nodo->dato = valor;
+            nodo->orden = siguienteOrden++;
+            for (int i = 0; i < altura; i++) {
+                Enlace& enlace = previos[i]->niveles()[i];
+                nodo->niveles()[i].sig = enlace.sig;
+                enlace.sig = nodo;
+                nodo->niveles()[i].salto = enlace.salto - (rangos[0] - rangos[i]);
+                enlace.salto = rangos[0] - rangos[i] + 1;
+            }
+            for (int i = altura; i < nivel; i++) {
+                previos[i]->niveles()[i].salto++;
+            }
+            if (nodo->niveles()[0].sig == nullptr) mayor = nodo;
+
+            nodo->anterior = ultimo;
+            nodo->siguiente = nullptr;
+            if (ultimo != nullptr) ultimo->siguiente = nodo;
+            else primero = nodo;
+            ultimo = nodo;
+            tamanio++;
+        }
+
+        /**
+         * @brief Indica si el valor está en el historial
+         * @param valor Valor a buscar
+         * @return true si existe, en O(log n)
+         */
+        bool busqueda(T valor) const {
+            Nodo* previos[NIVELES_MAXIMOS];
+            previos[0] = cabecera; // descender lo escribe siempre (nivel >= 1), pero el compilador no puede saberlo
+            MenorQue menor = { valor };
+            descender(menor, previos);
+            Nodo* candidato = previos[0]->niveles()[0].sig;
+            return candidato != nullptr && !(valor < candidato->dato);
+        }
+
+        /**
+         * @brief Elimina la lectura más antigua con el valor indicado
+         * @param valor Valor a eliminar
+         * @return true si se eliminó, false si no estaba
+         * @post O(log n) esperado; las demás lecturas conservan su orden
+         */
+        bool eliminarValor(T valor) {
+            Nodo* previos[NIVELES_MAXIMOS];
+            previos[0] = cabecera; // descender lo escribe siempre (nivel >= 1), pero el compilador no puede saberlo
+            MenorQue menor = { valor };
+            descender(menor, previos);
+            Nodo* candidato = previos[0]->niveles()[0].sig;
+            if (candidato == nullptr || valor < candidato->dato) {
+                IOT_DEPURACION("Valor no encontrado: " << valor);
+                return false;
+            }
+            IOT_DEPURACION("Nodo eliminado: " << candidato->dato);
+            quitarNodo(candidato, previos);
+            return true;
+        }
+
+        /**
+         * @brief Lectura de menor valor
+         * @pre El historial no está vacío
+         */
+        T minimo() const { return cabecera->niveles()[0].sig->dato; }
+
+        /**
+         * @brief Lectura de mayor valor
+         * @pre El historial no está vacío
+         */
+        T maximo() const { return mayor->dato; }
+
+        /**
+         * @brief Quita y devuelve la lectura de menor valor (la más antigua si se repite)
+         * @pre El historial no está vacío
+         */
+        T extraerMinimo() {
+            T valor = minimo();
+            eliminarValor(valor);
+            return valor;
+        }
+
+        /**
+         * @brief Quita y devuelve la lectura de mayor valor (la más antigua si se repite)
+         * @pre El historial no está vacío
+         */
+        T extraerMaximo() {
+            T valor = maximo();
+            eliminarValor(valor);
+            return valor;
+        }
+
+        /**
+         * @brief Cuenta las lecturas menores que un umbral
+         * @param umbral Valor de corte (excluido)
+         * @return Lecturas con valor < umbral, en O(log n)
+         */
+        int contarMenoresQue(T umbral) const {
+            MenorQue menor = { umbral };
+            return static_cast<int>(descender(menor, nullptr));
+        }
+
+        /**
+         * @brief Cuenta las lecturas mayores que un umbral
+         * @param umbral Valor de corte (excluido)
+         * @return Lecturas con valor > umbral, en O(log n)
+         */
+        int contarMayoresQue(T umbral) const {
+            MenorOIgualQue menorOIgual = { umbral };
+            return tamanio - static_cast<int>(descender(menorOIgual, nullptr));
+        }
+
+        /**
+         * @brief Cuenta las lecturas dentro de un rango cerrado
+         * @param desde Límite inferior (incluido)
+         * @param hasta Límite superior (incluido)
+         * @return Lecturas con desde <= valor <= hasta, en O(log n)
+         */
+        int contarEntre(T desde, T hasta) const {
+            if (hasta < desde) return 0;
+            MenorOIgualQue menorOIgual = { hasta };
+            MenorQue menor = { desde };
+            return static_cast<int>(descender(menorOIgual, nullptr) - descender(menor, nullptr));
+        }
+
+        /**
+         * @brief Obtiene el número de lecturas
+         * @return Cantidad de lecturas (O(1))
+         */
+        int obtenerTamanio() const { return tamanio; }
+
+        /**
+         * @brief Niveles del índice en uso
+         */
+        int obtenerNiveles() const { return nivel; }
+
+        /**
+         * @brief Recorre las lecturas en orden de llegada como bloques de un elemento
+         * @param f Función invocada como f(const T* datos, int cantidad)
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            for (Nodo* actual = primero; actual != nullptr; actual = actual->siguiente) {
+                f(static_cast<const T*>(&actual->dato), 1);
+            }
+        }
+};
+
+/**
+ * @brief Rasgos de HistorialIndexado: sin montículo de mínimos, porque el
+ *        índice ya entrega el mínimo en O(log n)
+ */
+template <typename T>
+struct RasgosHistorial<HistorialIndexado<T> > {
+    static const bool desaloja = false;
+    static const bool monticuloMinimos = false;
+
+    template <typename F>
+    static void insertar(HistorialIndexado<T>& historial, T valor, long long, F) {
+        historial.insertar(valor);
+    }
+
+    template <typename F>
+    static void expirar(HistorialIndexado<T>&, F) {}
+};
+
+/**
+ * @brief Mínimo de un historial indexado, sin recorrerlo
+ * @param historial Historial indexado
+ * @param minimo Lectura de menor valor
+ * @return false si el historial está vacío
+ */
+template <typename T>
+inline bool minimoIndexado(const HistorialIndexado<T>& historial, T& minimo) {
+    if (historial.obtenerTamanio() == 0) return false;
+    minimo = historial.minimo();
+    return true;
+}
+
+/**
+ * @brief Imprime el rango de valores y la altura del índice en mostrarInfo
+ * @param historial Historial indexado
+ */
+template <typename T>
+inline void mostrarDetalleHistorial(const HistorialIndexado<T>& historial) {
+    if (historial.obtenerTamanio() == 0) return;
+    std::cout << "Indice ordenado: " << historial.minimo() << " a " << historial.maximo()
+              << ", " << historial.obtenerNiveles() << " niveles" << std::endl;
+}
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef HISTORIALINSTANTANEA_H
+#define HISTORIALINSTANTANEA_H
+
+#include <memory>
+#include <vector>
+#include "ArchivoMapeado.h"
+#include "RasgosHistorial.h"
+#include "Bitacora.h"
+
+/**
+ * @file HistorialInstantanea.h
+ * @brief Historial que lee sus lecturas guardadas directamente de una instantánea proyectada
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class HistorialInstantanea
+ * @brief Lecturas guardadas (solo lectura, en el archivo) más lecturas nuevas
+ * @tparam T Tipo de dato almacenado (float o int)
+ *
+ * Las lecturas cargadas de una instantánea no se copian: se leen del
+ * archivo proyectado, que el historial mantiene vivo con un shared_ptr.
+ * Las lecturas nuevas se agregan en un arreglo propio. Solo si se elimina
+ * una lectura guardada se copian todas al arreglo propio (copia al
+ * escribir) y se suelta la proyección; también al pedirlo con
+ * soltarInstantanea(), antes de reemplazar el archivo en Windows.
+ *
+ * Ofrece la misma interfaz que ListaSensor (insertar, busqueda,
+ * eliminarValor, obtenerTamanio, paraCadaBloque).
+ */
+template <typename T>
+class HistorialInstantanea {
+    public:
+        typedef T TipoValor; ///< Tipo de las lecturas
+
+    private:
+        std::shared_ptr<const ArchivoMapeado> archivo; ///< Proyección de la que se leen las lecturas guardadas
+        const T* guardadas;  ///< Lecturas guardadas dentro de la proyección
+        int cantidadGuardadas; ///< Número de lecturas guardadas
+        std::vector<T> propias; ///< Lecturas nuevas (o todas, tras copiar)
+
+        /**
+         * @brief Copia las lecturas guardadas al arreglo propio y suelta la proyección
+         */
+        void copiarGuardadas() {
+            std::vector<T> todas;
+            todas.reserve(static_cast<std::size_t>(cantidadGuardadas) + propias.size());
+            todas.insert(todas.end(), guardadas, guardadas + cantidadGuardadas);
+            todas.insert(todas.end(), propias.begin(), propias.end());
+            propias.swap(todas);
+            guardadas = nullptr;
+            cantidadGuardadas = 0;
+            archivo.reset();
+            IOT_DEPURACION("Lecturas de la instantanea copiadas (" << propias.size() << ")");
+        }
+
+    public:
+        /**
+         * @brief Constructor, historial vacío sin instantánea
+         */
+        HistorialInstantanea() : guardadas(nullptr), cantidadGuardadas(0) {}
+
+        /**
+         * @brief Constructor sobre lecturas de una instantánea proyectada
+         * @param origen Proyección que contiene las lecturas
+         * @param datos Primera lectura dentro de la proyección
+         * @param cantidad Número de lecturas
+         */
+        HistorialInstantanea(const std::shared_ptr<const ArchivoMapeado>& origen, const T* datos, int cantidad)
+            : archivo(origen), guardadas(datos), cantidadGuardadas(cantidad) {}
+
+        /**
+         * @brief Destructor
+         */
+        ~HistorialInstantanea() {
+            IOT_DEPURACION("Historial de instantanea con " << obtenerTamanio() << " valores destruido");
+        }
+
+        /**
+         * @brief Inserta una lectura nueva al final
+         * @param valor Valor a insertar
+         */
+        void insertar(T valor) {
+            propias.push_back(valor);
+            IOT_DEPURACION("Valor insertado: " << valor);
+        }
+
+        /**
+         * @brief Busca un valor en el historial
+         * @param valor Valor a buscar
+         * @return true si el valor existe
+         */
+        bool busqueda(T valor) const {
+            for (int i = 0; i < cantidadGuardadas; i++) {
+                if (guardadas[i] == valor) return true;
+            }
+            for (std::size_t i = 0; i < propias.size(); i++) {
+                if (propias[i] == valor) return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Elimina la primera aparición (la más antigua) de un valor
+         * @param valor Valor a eliminar
+         * @return true si se eliminó, false si no se encontró
+         * @post Si el valor estaba en la instantánea, las lecturas guardadas
+         *       pasan al arreglo propio antes de eliminarlo
+         */
+        bool eliminarValor(T valor) {
+            for (int i = 0; i < cantidadGuardadas; i++) {
+                if (guardadas[i] == valor) {
+                    copiarGuardadas();
+                    break;
+                }
+            }
+            for (std::size_t i = 0; i < propias.size(); i++) {
+                if (propias[i] == valor) {
+                    propias.erase(propias.begin() + i);
+                    IOT_DEPURACION("Nodo eliminado: " << valor);
+                    return true;
+                }
+            }
+            IOT_DEPURACION("Valor no encontrado: " << valor);
+            return false;
+        }
+
+        /**
+         * @brief Obtiene el número de lecturas almacenadas
+         */
+        int obtenerTamanio() const { return cantidadGuardadas + static_cast<int>(propias.size()); }
+
+        /**
+         * @brief Indica si todavía se leen lecturas de la instantánea
+         */
+        bool leeDeInstantanea() const { return archivo != nullptr; }
+
+        /**
+         * @brief Copia las lecturas guardadas y suelta la proyección, si aún la usa
+         */
+        void soltarInstantanea() {
+            if (archivo != nullptr) copiarGuardadas();
+        }
+
+        /**
+         * @brief Recorre las lecturas por bloques, en orden de llegada
+         * @param f Función con firma f(const T* datos, int cantidad)
+         *
+         * Las lecturas guardadas se entregan en un solo bloque que apunta
+         * a la proyección, sin copiarlas.
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            if (cantidadGuardadas > 0) {
+                f(guardadas, cantidadGuardadas);
+            }
+            if (!propias.empty()) {
+                f(static_cast<const T*>(propias.data()), static_cast<int>(propias.size()));
+            }
+        }
+};
+
+/**
+ * @brief Rasgos de HistorialInstantanea: sin montículo de mínimos, porque
+ *        construirlo obligaría a leer todas las lecturas al arrancar
+ */
+template <typename T>
+struct RasgosHistorial<HistorialInstantanea<T> > {
+    static const bool desaloja = false;
+    static const bool monticuloMinimos = false;
+
+    template <typename F>
+    static void insertar(HistorialInstantanea<T>& historial, T valor, long long, F) {
+        historial.insertar(valor);
+    }
+
+    template <typename F>
+    static void expirar(HistorialInstantanea<T>&, F) {}
+};
+
+/**
+ * @brief Suelta la instantánea proyectada, copiando sus lecturas
+ */
+template <typename T>
+inline void soltarArchivoDe(HistorialInstantanea<T>& historial) {
+    historial.soltarInstantanea();
+}
+
+#endif
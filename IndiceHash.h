@@ -0,0 +1,177 @@
+#ifndef INDICEHASH_H
+#define INDICEHASH_H
+
+#include <cstddef>
+
+/**
+ * @file IndiceHash.h
+ * @brief Tabla hash de direccionamiento abierto indexada por nombre
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Calcula el hash FNV-1a de 32 bits de una cadena
+ * @param texto Caracteres a procesar
+ * @param longitud Número de caracteres
+ * @return Hash de la cadena
+ */
+inline unsigned int hashCadena(const char* texto, std::size_t longitud) {
+    unsigned int hash = 2166136261u;
+    for (std::size_t i = 0; i < longitud; i++) {
+        hash ^= static_cast<unsigned char>(texto[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Calcula el hash FNV-1a de una cadena terminada en '\0'
+ * @param texto Cadena a procesar
+ * @return Hash de la cadena
+ */
+inline unsigned int hashCadena(const char* texto) {
+    std::size_t longitud = 0;
+    while (texto[longitud] != '\0') longitud++;
+    return hashCadena(texto, longitud);
+}
+
+/**
+ * @class IndiceHash
+ * @brief Índice nombre -> valor con direccionamiento abierto y sondeo lineal
+ * @tparam V Tipo de valor asociado (por ejemplo SensorBase*)
+ *
+ * Las claves no se copian: el índice guarda el puntero al nombre, que
+ * debe vivir al menos tanto como la entrada (por ejemplo el nombre dentro
+ * del propio sensor). El hash de cada clave se guarda junto a ella para
+ * descartar colisiones sin comparar caracteres. La capacidad es potencia
+ * de 2 y se duplica al superar un factor de carga de 0.7.
+ */
+template <typename V>
+class IndiceHash {
+    private:
+        /**
+         * @struct Entrada
+         * @brief Ranura de la tabla; clave == nullptr indica ranura libre
+         */
+        struct Entrada {
+            const char* clave;  ///< Nombre terminado en '\0'
+            unsigned int hash;  ///< Hash precalculado de la clave
+            V valor;            ///< Valor asociado
+        };
+
+        Entrada* tabla;       ///< Arreglo de ranuras
+        std::size_t capacidad; ///< Número de ranuras (potencia de 2)
+        std::size_t tamanio;   ///< Entradas ocupadas
+
+        IndiceHash(const IndiceHash&);            ///< No copiable
+        IndiceHash& operator=(const IndiceHash&); ///< No asignable
+
+        /**
+         * @brief Compara una clave guardada con un texto de longitud dada
+         */
+        static bool claveIgual(const char* clave, const char* texto, std::size_t longitud) {
+            for (std::size_t i = 0; i < longitud; i++) {
+                if (clave[i] != texto[i] || clave[i] == '\0') return false;
+            }
+            return clave[longitud] == '\0';
+        }
+
+        /**
+         * @brief Coloca una entrada sin verificar duplicados ni carga
+         */
+        void colocar(const Entrada& entrada) {
+            std::size_t mascara = capacidad - 1;
+            std::size_t i = entrada.hash & mascara;
+            while (tabla[i].clave != nullptr) {
+                i = (i + 1) & mascara;
+            }
+            tabla[i] = entrada;
+        }
+
+        /**
+         * @brief Duplica la capacidad y reubica todas las entradas
+         */
+        void crecer() {
+            Entrada* anterior = tabla;
+            std::size_t capacidadAnterior = capacidad;
+            capacidad = capacidad == 0 ? 16 : capacidad * 2;
+            tabla = new Entrada[capacidad]();
+            for (std::size_t i = 0; i < capacidadAnterior; i++) {
+                if (anterior[i].clave != nullptr) {
+                    colocar(anterior[i]);
+                }
+            }
+            delete[] anterior;
+        }
+
+    public:
+        /**
+         * @brief Constructor por defecto
+         * @post Índice vacío sin memoria reservada
+         */
+        IndiceHash() : tabla(nullptr), capacidad(0), tamanio(0) {}
+
+        /**
+         * @brief Destructor, libera la tabla (no los valores)
+         */
+        ~IndiceHash() { delete[] tabla; }
+
+        /**
+         * @brief Busca el valor asociado a un nombre
+         * @param texto Caracteres del nombre (no requiere terminador)
+         * @param longitud Número de caracteres
+         * @param hash Hash del nombre (hashCadena)
+         * @return Puntero al valor, o nullptr si el nombre no existe
+         */
+        V* buscar(const char* texto, std::size_t longitud, unsigned int hash) const {
+            if (tamanio == 0) return nullptr;
+            std::size_t mascara = capacidad - 1;
+            for (std::size_t i = hash & mascara; tabla[i].clave != nullptr; i = (i + 1) & mascara) {
+                if (tabla[i].hash == hash && claveIgual(tabla[i].clave, texto, longitud)) {
+                    return &tabla[i].valor;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Busca el valor asociado a un nombre terminado en '\0'
+         * @param nombre Nombre a buscar
+         * @return Puntero al valor, o nullptr si el nombre no existe
+         */
+        V* buscar(const char* nombre) const {
+            std::size_t longitud = 0;
+            while (nombre[longitud] != '\0') longitud++;
+            return buscar(nombre, longitud, hashCadena(nombre, longitud));
+        }
+
+        /**
+         * @brief Inserta un nombre si aún no existe
+         * @param clave Nombre terminado en '\0' (debe sobrevivir a la entrada)
+         * @param hash Hash precalculado del nombre
+         * @param valor Valor a asociar
+         * @return true si se insertó, false si el nombre ya existía
+         */
+        bool insertar(const char* clave, unsigned int hash, const V& valor) {
+            std::size_t longitud = 0;
+            while (clave[longitud] != '\0') longitud++;
+            if (buscar(clave, longitud, hash) != nullptr) return false;
+
+            if ((tamanio + 1) * 10 > capacidad * 7) {
+                crecer();
+            }
+            Entrada entrada = { clave, hash, valor };
+            colocar(entrada);
+            tamanio++;
+            return true;
+        }
+
+        /**
+         * @brief Obtiene la cantidad de entradas
+         * @return Número de nombres indexados
+         */
+        std::size_t obtenerTamanio() const { return tamanio; }
+};
+
+#endif
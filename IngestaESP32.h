@@ -0,0 +1,446 @@
+#ifndef INGESTAESP32_H
+#define INGESTAESP32_H
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "ColaSPSC.h"
+#include "FuenteSerial.h"
+#include "MultiplexorPuertos.h"
+#include "LectorLineas.h"
+#include "ProtocoloESP32.h"
+#include "EnrutadorESP32.h"
+#include "DiarioLecturas.h"
+#include "HistogramaLatencia.h"
+#include "RelojMonotonico.h"
+
+/**
+ * @file IngestaESP32.h
+ * @brief Lectura de los puertos y registro de lecturas en hilos separados
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct RegistroLectura
+ * @brief Lectura ya interpretada que viaja del hilo lector al consumidor
+ *
+ * Copia el identificador en un arreglo fijo porque la línea original se
+ * sobrescribe en el anillo del lector en cuanto se consume.
+ */
+struct RegistroLectura {
+    char id[50];             ///< Identificador del sensor, terminado en '\0'
+    unsigned char longitudId; ///< Caracteres válidos de id
+    TipoLectura tipo;        ///< Tipo de sensor
+    float temperatura;       ///< Valor si tipo == LECTURA_TEMPERATURA
+    int presion;             ///< Valor si tipo == LECTURA_PRESION
+    long long marcaNs;       ///< Instante de llegada (reloj monotónico, ns)
+};
+
+/**
+ * @struct ContadoresIngesta
+ * @brief Métricas de la ingesta; se pueden leer mientras los hilos trabajan
+ */
+struct ContadoresIngesta {
+    std::atomic<long> lineas;           ///< Líneas completas recibidas
+    std::atomic<long> encoladas;        ///< Lecturas que entraron en la cola
+    std::atomic<long> descartadas;      ///< Lecturas perdidas por cola llena
+    std::atomic<long> erroresParseo;    ///< Líneas TEMP/PRES con valor o id inválido
+    std::atomic<long> registradas;      ///< Lecturas aplicadas a un sensor
+    std::atomic<long> rechazadas;       ///< Lecturas cuyo id es de otro tipo de sensor
+    std::atomic<long> lotes;            ///< Lotes aplicados por el consumidor
+    std::atomic<long> profundidadMaxima; ///< Mayor profundidad observada de la cola (tras cada lectura del puerto)
+
+    ContadoresIngesta()
+        : lineas(0), encoladas(0), descartadas(0), erroresParseo(0),
+          registradas(0), rechazadas(0), lotes(0), profundidadMaxima(0) {}
+};
+
+/**
+ * @struct ContadoresPuerto
+ * @brief Métricas de un puerto; se pueden leer mientras los hilos trabajan
+ */
+struct ContadoresPuerto {
+    std::atomic<long> bytes;   ///< Bytes leídos del puerto
+    std::atomic<long> lineas;  ///< Líneas completas recibidas
+    std::atomic<long> errores; ///< Líneas TEMP/PRES inválidas o más largas que el anillo del lector
+    std::atomic<bool> cerrado; ///< El puerto terminó (EOF o error de lectura)
+
+    ContadoresPuerto() : bytes(0), lineas(0), errores(0), cerrado(false) {}
+};
+
+/**
+ * @class IngestaESP32
+ * @brief Hilo lector (puertos -> cola) y hilo consumidor (cola -> sensores)
+ *
+ * Un solo hilo lector atiende todos los puertos: cada uno tiene su
+ * propio LectorLineas, así que las líneas de un ESP32 no se mezclan con
+ * las de otro, y sus propios contadores. Con varios puertos que tienen
+ * descriptor (tty, pty o FIFO en POSIX) el lector espera en un
+ * MultiplexorPuertos (epoll en Linux) y solo lee los que tienen datos;
+ * con un solo puerto, o si alguno no admite la espera, los lee por turnos.
+ * Todas las lecturas comparten una cola y un consumidor, que es quien
+ * crea y alimenta los sensores de la lista.
+ *
+ * El hilo lector solo lee bytes, separa líneas y las interpreta; nunca
+ * emite mensajes ni toca la lista, así que un consumidor lento no
+ * retrasa la lectura del puerto. Si la cola se llena, la lectura se
+ * descarta y se cuenta en lugar de bloquear al lector (salvo que se pida
+ * esperar con esperarSiColaLlena()). El consumidor
+ * extrae lotes de hasta TAMANIO_LOTE lecturas y las registra mediante el
+ * EnrutadorESP32; es el único hilo que modifica la lista mientras la
+ * ingesta está activa. Si hay un DiarioLecturas, el consumidor anota en
+ * él cada lectura que se registró.
+ */
+class IngestaESP32 {
+    public:
+        static const std::size_t TAMANIO_LOTE = 256; ///< Lecturas aplicadas por lote
+
+    private:
+        /**
+         * @struct Puerto
+         * @brief Fuente abierta con su separador de líneas y sus contadores
+         */
+        struct Puerto {
+            FuenteSerial* fuente;          ///< Puerto abierto (lo usa solo el lector)
+            LectorLineas lector;           ///< Líneas de este puerto
+            std::size_t descartadasVistas; ///< lineasDescartadas() ya sumadas a errores
+            ContadoresPuerto contadores;   ///< Métricas del puerto
+
+            explicit Puerto(FuenteSerial* fuenteAbierta) : fuente(fuenteAbierta), lector(4096), descartadasVistas(0) {}
+        };
+
+        std::vector<std::unique_ptr<Puerto> > puertos; ///< Puertos en el orden recibido
+        EnrutadorESP32& enrutador;        ///< Destino de las lecturas (lo usa solo el consumidor)
+        DiarioLecturas* diario;           ///< Diario de las lecturas aceptadas (nullptr = sin diario)
+        ColaSPSC<RegistroLectura> cola;   ///< Cola entre los dos hilos
+        ContadoresIngesta contadores;     ///< Métricas
+        HistogramaLatencia latencias;     ///< Llegada -> aplicación de cada lectura (lo escribe solo el consumidor)
+        std::atomic<bool> detenerLector;  ///< Solicitud de paro al lector
+        std::atomic<bool> lectorTerminado; ///< El lector salió (paro, EOF o error)
+        bool esperarCola;                 ///< Con la cola llena, esperar en lugar de descartar
+        std::thread hiloLector;           ///< Hilo que lee los puertos
+        std::thread hiloConsumidor;       ///< Hilo que registra las lecturas
+
+        IngestaESP32(const IngestaESP32&);            ///< No copiable
+        IngestaESP32& operator=(const IngestaESP32&); ///< No asignable
+
+        /**
+         * @brief Actualiza el máximo de profundidad observado
+         *
+         * Lee el índice del consumidor, así que se llama una vez por lectura
+         * del puerto y no por cada lectura encolada: la cola alcanza su
+         * máximo justo después de encolar las líneas de un bloque.
+         */
+        void observarProfundidad() {
+            long actual = static_cast<long>(cola.profundidad());
+            if (actual > contadores.profundidadMaxima.load(std::memory_order_relaxed)) {
+                contadores.profundidadMaxima.store(actual, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Interpreta una línea y la encola
+         * @param linea Línea sin salto de línea
+         * @param marcaNs Instante en que se leyeron los bytes de la línea
+         * @param puerto Contadores del puerto de donde vino la línea
+         */
+        void encolarLinea(VistaCadena linea, long long marcaNs, ContadoresPuerto& puerto) {
+            if (linea.vacia()) return;
+            contadores.lineas.fetch_add(1, std::memory_order_relaxed);
+            puerto.lineas.fetch_add(1, std::memory_order_relaxed);
+
+            LecturaESP32 lectura = LecturaESP32();
+            ResultadoParseo resultado = parsearLineaESP32(linea, lectura);
+            if (resultado == PARSEO_IGNORADA) return;
+            VistaCadena id = EnrutadorESP32::identificadorDestino(lectura.tipo, lectura.id);
+            if (resultado == PARSEO_ERROR_VALOR || id.longitud >= sizeof(RegistroLectura().id)) {
+                contadores.erroresParseo.fetch_add(1, std::memory_order_relaxed);
+                puerto.errores.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            RegistroLectura registro;
+            std::memcpy(registro.id, id.datos, id.longitud);
+            registro.id[id.longitud] = '\0';
+            registro.longitudId = static_cast<unsigned char>(id.longitud);
+            registro.tipo = lectura.tipo;
+            registro.temperatura = lectura.temperatura;
+            registro.presion = lectura.presion;
+            registro.marcaNs = marcaNs;
+            bool encolada = cola.intentarEncolar(registro);
+            while (!encolada && esperarCola && !detenerLector.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+                encolada = cola.intentarEncolar(registro);
+            }
+            if (encolada) {
+                contadores.encoladas.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                contadores.descartadas.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Lee una vez un puerto y encola sus líneas completas
+         * @param puerto Puerto a leer
+         * @param esperaMs Espera máxima si no hay datos (0 si ya se esperó)
+         * @return false si el puerto terminó (EOF o error)
+         *
+         * El reloj se consulta una vez por lectura del puerto: las líneas
+         * completadas por esos bytes llegaron juntas y comparten la marca.
+         */
+        bool leerPuerto(Puerto& puerto, int esperaMs) {
+            std::size_t disponible;
+            char* zona = puerto.lector.zonaEscritura(disponible);
+            long bytesLeidos = puerto.fuente->leer(zona, disponible, esperaMs);
+            if (bytesLeidos < 0) {
+                puerto.contadores.cerrado.store(true, std::memory_order_release);
+                return false;
+            }
+            if (bytesLeidos == 0) return true;
+            puerto.lector.confirmarEscritura(static_cast<std::size_t>(bytesLeidos));
+            puerto.contadores.bytes.fetch_add(bytesLeidos, std::memory_order_relaxed);
+
+            long long marcaNs = instanteActualNs();
+            VistaCadena linea;
+            while (puerto.lector.siguienteLinea(linea)) {
+                encolarLinea(linea, marcaNs, puerto.contadores);
+            }
+            observarProfundidad();
+            std::size_t descartadas = puerto.lector.lineasDescartadas();
+            if (descartadas != puerto.descartadasVistas) {
+                puerto.contadores.errores.fetch_add(static_cast<long>(descartadas - puerto.descartadasVistas),
+                                                    std::memory_order_relaxed);
+                puerto.descartadasVistas = descartadas;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Lee los puertos uno tras otro, cada uno con su propia espera
+         *
+         * Es el camino de un solo puerto y el de las fuentes sin descriptor
+         * (Win32, capturas en archivo): con N puertos cada uno espera 50/N ms.
+         */
+        void leerPorTurnos() {
+            std::size_t abiertos = puertos.size();
+            int espera = 50 / static_cast<int>(abiertos);
+            if (espera < 1) espera = 1;
+            while (abiertos > 0 && !detenerLector.load(std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < puertos.size(); i++) {
+                    Puerto& puerto = *puertos[i];
+                    if (puerto.contadores.cerrado.load(std::memory_order_relaxed)) continue;
+                    if (!leerPuerto(puerto, espera)) abiertos--;
+                }
+            }
+        }
+
+        /**
+         * @brief Espera en el multiplexor y lee solo los puertos con datos
+         * @param multiplexor Multiplexor con todos los puertos registrados
+         *
+         * Cada puerto listo se lee una vez por espera, así que un ESP32 que
+         * envía sin pausa no deja sin atender a los demás.
+         */
+        void leerMultiplexado(MultiplexorPuertos& multiplexor) {
+            std::vector<std::size_t> listos;
+            std::size_t abiertos = puertos.size();
+            while (abiertos > 0 && !detenerLector.load(std::memory_order_relaxed)) {
+                if (multiplexor.esperar(listos, 50) < 0) break;
+                for (std::size_t k = 0; k < listos.size(); k++) {
+                    Puerto& puerto = *puertos[listos[k]];
+                    if (!leerPuerto(puerto, 0)) {
+                        multiplexor.quitar(puerto.fuente->obtenerDescriptor());
+                        abiertos--;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Cuerpo del hilo lector
+         */
+        void leer() {
+            MultiplexorPuertos multiplexor;
+            bool multiplexado = puertos.size() > 1;
+            for (std::size_t i = 0; i < puertos.size() && multiplexado; i++) {
+                multiplexado = multiplexor.agregar(puertos[i]->fuente->obtenerDescriptor(), i);
+            }
+            if (multiplexado) {
+                leerMultiplexado(multiplexor);
+            } else {
+                leerPorTurnos();
+            }
+            lectorTerminado.store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Registra un lote de lecturas en sus sensores
+         * @param lote Lecturas extraídas de la cola
+         * @param n Número de lecturas
+         */
+        void aplicarLote(const RegistroLectura* lote, std::size_t n) {
+            long registradas = 0;
+            long rechazadas = 0;
+            for (std::size_t i = 0; i < n; i++) {
+                LecturaESP32 lectura = LecturaESP32();
+                lectura.tipo = lote[i].tipo;
+                lectura.id.datos = lote[i].id;
+                lectura.id.longitud = lote[i].longitudId;
+                lectura.temperatura = lote[i].temperatura;
+                lectura.presion = lote[i].presion;
+
+                ResultadoRuta resultado = enrutador.registrar(lectura, lote[i].marcaNs);
+                if (resultado != RUTA_REGISTRADA) {
+                    rechazadas++;
+                    continue;
+                }
+                registradas++;
+                if (diario != nullptr) {
+                    diario->anotar(lote[i].tipo, lote[i].id, lote[i].longitudId, lote[i].temperatura,
+                                   lote[i].presion, lote[i].marcaNs);
+                }
+                if (lectura.tipo == LECTURA_TEMPERATURA) {
+                    IOT_DEPURACION("[ESP32] " << lote[i].id << " temperatura registrada: " << lectura.temperatura);
+                } else {
+                    IOT_DEPURACION("[ESP32] " << lote[i].id << " presion registrada: " << lectura.presion);
+                }
+            }
+            // Un reloj por lote: la latencia incluye la espera en la cola y el lote completo
+            long long ahora = instanteActualNs();
+            for (std::size_t i = 0; i < n; i++) latencias.registrar(ahora - lote[i].marcaNs);
+            contadores.registradas.fetch_add(registradas, std::memory_order_relaxed);
+            contadores.rechazadas.fetch_add(rechazadas, std::memory_order_relaxed);
+            contadores.lotes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Cuerpo del hilo consumidor
+         *
+         * Termina cuando el lector terminó y la cola quedó vacía. Si no hay
+         * nada que consumir duerme 1 ms; a 115200 baudios llegan pocas
+         * líneas por milisegundo, así que la cola absorbe la espera.
+         */
+        void consumir() {
+            RegistroLectura lote[TAMANIO_LOTE];
+            while (true) {
+                bool terminado = lectorTerminado.load(std::memory_order_acquire);
+                std::size_t n = cola.extraerLote(lote, TAMANIO_LOTE);
+                if (n > 0) {
+                    aplicarLote(lote, n);
+                } else if (terminado) {
+                    break;
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param fuenteAbierta Fuente serial ya abierta
+         * @param enrutadorLecturas Enrutador de la lista de sensores
+         * @param capacidadCola Lecturas que puede retener la cola
+         * @param diarioLecturas Diario abierto donde anotar las lecturas registradas (opcional)
+         */
+        IngestaESP32(FuenteSerial& fuenteAbierta, EnrutadorESP32& enrutadorLecturas, std::size_t capacidadCola = 16384,
+                     DiarioLecturas* diarioLecturas = nullptr)
+            : enrutador(enrutadorLecturas), diario(diarioLecturas), cola(capacidadCola),
+              detenerLector(false), lectorTerminado(false), esperarCola(false) {
+            puertos.push_back(std::unique_ptr<Puerto>(new Puerto(&fuenteAbierta)));
+        }
+
+        /**
+         * @brief Constructor para varios puertos atendidos por el mismo hilo lector
+         * @param fuentesAbiertas Fuentes ya abiertas (al menos una); quien llama las cierra
+         * @param enrutadorLecturas Enrutador de la lista de sensores
+         * @param capacidadCola Lecturas que puede retener la cola
+         * @param diarioLecturas Diario abierto donde anotar las lecturas registradas (opcional)
+         */
+        IngestaESP32(const std::vector<FuenteSerial*>& fuentesAbiertas, EnrutadorESP32& enrutadorLecturas,
+                     std::size_t capacidadCola = 16384, DiarioLecturas* diarioLecturas = nullptr)
+            : enrutador(enrutadorLecturas), diario(diarioLecturas), cola(capacidadCola),
+              detenerLector(false), lectorTerminado(false), esperarCola(false) {
+            for (std::size_t i = 0; i < fuentesAbiertas.size(); i++) {
+                puertos.push_back(std::unique_ptr<Puerto>(new Puerto(fuentesAbiertas[i])));
+            }
+        }
+
+        /**
+         * @brief Destructor, detiene los hilos si siguen activos
+         */
+        ~IngestaESP32() { detener(); }
+
+        /**
+         * @brief Elige qué hace el lector cuando la cola está llena
+         * @param esperar true para esperar a que el consumidor libere espacio
+         *        (una captura en archivo no pierde nada por esperar), false
+         *        para descartar la lectura, como con el puerto (por defecto)
+         * @pre Se llama antes de iniciar()
+         */
+        void esperarSiColaLlena(bool esperar) { esperarCola = esperar; }
+
+        /**
+         * @brief Arranca los hilos lector y consumidor
+         */
+        void iniciar() {
+            detenerLector.store(false);
+            lectorTerminado.store(false);
+            hiloLector = std::thread(&IngestaESP32::leer, this);
+            hiloConsumidor = std::thread(&IngestaESP32::consumir, this);
+        }
+
+        /**
+         * @brief Detiene la lectura y espera a que se apliquen las lecturas encoladas
+         * @post Ningún hilo de la ingesta sigue activo
+         */
+        void detener() {
+            detenerLector.store(true);
+            if (hiloLector.joinable()) hiloLector.join();
+            if (hiloConsumidor.joinable()) hiloConsumidor.join();
+        }
+
+        /**
+         * @brief Indica si el lector terminó por sí solo (EOF o error de todos los puertos)
+         */
+        bool lecturaTerminada() const { return lectorTerminado.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Lecturas en la cola en este momento
+         */
+        std::size_t profundidadCola() const { return cola.profundidad(); }
+
+        /**
+         * @brief Obtiene las métricas de la ingesta
+         */
+        const ContadoresIngesta& obtenerContadores() const { return contadores; }
+
+        /**
+         * @brief Cantidad de puertos que atiende el lector
+         */
+        std::size_t obtenerPuertos() const { return puertos.size(); }
+
+        /**
+         * @brief Obtiene las métricas de un puerto
+         * @param i Posición del puerto, en el orden en que se recibieron las fuentes
+         */
+        const ContadoresPuerto& obtenerContadoresPuerto(std::size_t i) const { return puertos[i]->contadores; }
+
+        /**
+         * @brief Obtiene la ruta de un puerto
+         * @param i Posición del puerto
+         */
+        const char* obtenerRutaPuerto(std::size_t i) const { return puertos[i]->fuente->obtenerRuta(); }
+
+        /**
+         * @brief Latencias desde que el lector recibió cada lectura hasta que el consumidor la aplicó
+         * @return Histograma en ns; solo es consistente después de detener()
+         */
+        const HistogramaLatencia& obtenerLatencias() const { return latencias; }
+};
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef INSTANTANEA_H
+#define INSTANTANEA_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ArchivoMapeado.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "PoliticaRetencion.h"
+#include "EnrutadorESP32.h"
+#include "RelojMonotonico.h"
+#include "Bitacora.h"
+
+/**
+ * @file Instantanea.h
+ * @brief Guardado y carga de todos los sensores en un archivo binario
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Formato (versión 2, con el orden de bytes y la representación de la
+ * máquina que lo escribió):
+ *
+ *   CabeceraInstantanea
+ *   EntradaInstantanea x cantidadSensores
+ *   lecturas de cada sensor, contiguas y alineadas a 8 bytes
+ *
+ * Cada entrada guarda nombre, tipo, clase de historial con sus
+ * parámetros, estadísticas y la posición de sus lecturas. Los sensores
+ * con historial en lista (sin límite ni índice) se sirven desde el
+ * archivo proyectado (HistorialInstantanea) sin leer sus lecturas, así
+ * que su arranque no depende de cuántas haya. Los demás se vuelven a
+ * crear con su historial (circular, serie temporal, comprimido o
+ * indexado) y sus parámetros, registrando las lecturas guardadas, para
+ * que conserven su límite de memoria y su costo de procesamiento; un
+ * historial acotado cuesta a lo sumo su capacidad.
+ */
+
+/**
+ * @struct CabeceraInstantanea
+ * @brief Encabezado del archivo
+ */
+struct CabeceraInstantanea {
+    char magia[4];                  ///< "IOTS"
+    unsigned int version;           ///< VERSION_INSTANTANEA
+    unsigned int marcaOrden;        ///< MARCA_ORDEN_INSTANTANEA tal como la escribió la máquina
+    unsigned int cantidadSensores;  ///< Entradas de la tabla
+    unsigned long long tamanioArchivo; ///< Bytes totales, para detectar archivos truncados
+};
+
+/**
+ * @struct EntradaInstantanea
+ * @brief Descripción de un sensor guardado
+ */
+struct EntradaInstantanea {
+    char nombre[50];               ///< Nombre terminado en '\0'
+    unsigned char tipo;            ///< INSTANTANEA_TEMPERATURA o INSTANTANEA_PRESION
+    unsigned char extremosValidos; ///< EstadisticasLecturas::extremosValidos
+    unsigned int cantidad;         ///< Número de lecturas
+    unsigned long long desplazamiento; ///< Posición de la primera lectura desde el inicio del archivo
+    long long estCantidad;         ///< EstadisticasLecturas::cantidad
+    double suma;                   ///< EstadisticasLecturas::suma
+    double minimo;                 ///< EstadisticasLecturas::minimo
+    double maximo;                 ///< EstadisticasLecturas::maximo
+    double media;                  ///< EstadisticasLecturas::media
+    double m2;                     ///< EstadisticasLecturas::m2
+    unsigned char historial;       ///< HISTORIAL_LISTA, HISTORIAL_CIRCULAR, ...
+    unsigned char conMarcas;       ///< Comprimido con columna de marcas de tiempo
+    unsigned char reservado[2];    ///< Relleno explícito, en cero
+    int capacidad;                 ///< Capacidad del historial circular
+    double ventanaSegundos;        ///< Ventana de tiempo del historial circular (0 = sin límite)
+    double horizonteSegundos;      ///< Horizonte de la serie temporal (0 = sin compactar)
+};
+
+static_assert(sizeof(CabeceraInstantanea) == 24, "CabeceraInstantanea debe ocupar 24 bytes");
+static_assert(sizeof(EntradaInstantanea) == 136, "EntradaInstantanea debe ocupar 136 bytes");
+static_assert(sizeof(float) == 4 && sizeof(int) == 4, "Las lecturas se guardan en 4 bytes");
+
+const unsigned int VERSION_INSTANTANEA = 2;              ///< Versión del formato que se escribe y se acepta
+const unsigned int MARCA_ORDEN_INSTANTANEA = 0x01020304u; ///< Detecta archivos de otra arquitectura
+const unsigned char INSTANTANEA_TEMPERATURA = 0;         ///< Lecturas float
+const unsigned char INSTANTANEA_PRESION = 1;             ///< Lecturas int
+const unsigned char HISTORIAL_LISTA = 0;      ///< ListaSensor, desenrollada o instantánea: se sirve del archivo
+const unsigned char HISTORIAL_CIRCULAR = 1;   ///< HistorialCircular (capacidad y ventana)
+const unsigned char HISTORIAL_SERIE = 2;      ///< SerieTemporal (horizonte)
+const unsigned char HISTORIAL_COMPRIMIDO = 3; ///< HistorialComprimido (con o sin marcas)
+const unsigned char HISTORIAL_INDEXADO = 4;   ///< HistorialIndexado
+
+/**
+ * @brief Redondea una posición hacia arriba a múltiplo de 8
+ */
+inline unsigned long long alinearInstantanea(unsigned long long posicion) {
+    return (posicion + 7) & ~7ULL;
+}
+
+/**
+ * @brief Anota en la entrada la clase de historial y sus parámetros
+ *
+ * Por defecto el historial es una lista sin límite (HISTORIAL_LISTA, la
+ * entrada ya está en cero); los demás tienen su sobrecarga.
+ */
+template <typename Historial>
+inline void describirHistorial(const Historial&, EntradaInstantanea&) {}
+
+template <typename T>
+inline void describirHistorial(const HistorialCircular<T>& historial, EntradaInstantanea& entrada) {
+    entrada.historial = HISTORIAL_CIRCULAR;
+    entrada.capacidad = historial.obtenerCapacidad();
+    entrada.ventanaSegundos = historial.obtenerVentanaSegundos();
+}
+
+template <typename T>
+inline void describirHistorial(const SerieTemporal<T>& historial, EntradaInstantanea& entrada) {
+    entrada.historial = HISTORIAL_SERIE;
+    entrada.horizonteSegundos = historial.obtenerHorizonteSegundos();
+}
+
+template <typename T>
+inline void describirHistorial(const HistorialComprimido<T>& historial, EntradaInstantanea& entrada) {
+    entrada.historial = HISTORIAL_COMPRIMIDO;
+    entrada.conMarcas = historial.tieneMarcas() ? 1 : 0;
+}
+
+template <typename T>
+inline void describirHistorial(const HistorialIndexado<T>&, EntradaInstantanea& entrada) {
+    entrada.historial = HISTORIAL_INDEXADO;
+}
+
+/**
+ * @brief Política con la que se vuelve a crear el sensor de una entrada
+ * @param entrada Entrada con historial distinto de HISTORIAL_LISTA
+ */
+inline PoliticaRetencion politicaDeEntrada(const EntradaInstantanea& entrada) {
+    PoliticaRetencion politica;
+    if (entrada.historial == HISTORIAL_CIRCULAR) {
+        politica = PoliticaRetencion(entrada.capacidad, entrada.ventanaSegundos);
+    } else if (entrada.historial == HISTORIAL_SERIE) {
+        politica.serieTemporal = true;
+        politica.horizonteSegundos = entrada.horizonteSegundos;
+    } else if (entrada.historial == HISTORIAL_COMPRIMIDO) {
+        politica.comprimido = true;
+        politica.serieTemporal = entrada.conMarcas != 0;
+    } else {
+        politica.indexado = true;
+    }
+    return politica;
+}
+
+/**
+ * @brief Escribe las lecturas de un sensor si es del tipo indicado
+ * @tparam Sensor Tipo concreto del sensor
+ * @tparam T Tipo de sus lecturas
+ * @param sensor Sensor de la lista
+ * @param tipo Tipo que se anota en la entrada
+ * @param salida Archivo, colocado donde van las lecturas
+ * @param entrada Entrada a completar con la cantidad de lecturas
+ * @return true si el sensor era de tipo Sensor
+ */
+template <typename Sensor, typename T>
+bool escribirLecturasSiEs(const SensorBase* sensor, unsigned char tipo, std::ofstream& salida, EntradaInstantanea& entrada) {
+    const Sensor* concreto = dynamic_cast<const Sensor*>(sensor);
+    if (concreto == nullptr) return false;
+    entrada.tipo = tipo;
+    unsigned int cantidad = 0;
+    concreto->paraCadaBloque([&salida, &cantidad](const T* datos, int n) {
+        salida.write(reinterpret_cast<const char*>(datos), static_cast<std::streamsize>(n * sizeof(T)));
+        cantidad += static_cast<unsigned int>(n);
+    });
+    entrada.cantidad = cantidad;
+    describirHistorial(concreto->obtenerHistorial(), entrada);
+    return true;
+}
+
+/**
+ * @brief Escribe las lecturas de cualquier sensor conocido
+ * @return false si el tipo concreto del sensor no es uno de los conocidos
+ */
+inline bool escribirLecturas(const SensorBase* sensor, std::ofstream& salida, EntradaInstantanea& entrada) {
+    return escribirLecturasSiEs<SensorTemperatura, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorTemperaturaDesenrollado, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorTemperaturaCircular, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorTemperaturaTemporal, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorTemperaturaComprimido, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorTemperaturaInstantanea, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorTemperaturaIndexado, float>(sensor, INSTANTANEA_TEMPERATURA, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresion, int>(sensor, INSTANTANEA_PRESION, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresionDesenrollado, int>(sensor, INSTANTANEA_PRESION, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresionCircular, int>(sensor, INSTANTANEA_PRESION, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresionTemporal, int>(sensor, INSTANTANEA_PRESION, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresionComprimido, int>(sensor, INSTANTANEA_PRESION, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresionInstantanea, int>(sensor, INSTANTANEA_PRESION, salida, entrada) ||
+           escribirLecturasSiEs<SensorPresionIndexado, int>(sensor, INSTANTANEA_PRESION, salida, entrada);
+}
+
+/**
+ * @brief Guarda todos los sensores de la lista en una instantánea
+ * @tparam Almacen ListaGeneral o RegistroSensores
+ * @param lista Sensores a guardar, en su orden
+ * @param ruta Archivo destino
+ * @return true si se guardó
+ *
+ * Se escribe en ruta + ".tmp", se fuerza a disco y luego se renombra
+ * encima de la anterior (sincronizando también el directorio), así que
+ * un corte a medio guardado deja intacta la instantánea anterior. Los sensores con
+ * historial acotado o serie temporal guardan las lecturas que conservan
+ * en ese momento junto con la clase de historial y sus parámetros (sin
+ * marcas de tiempo ni niveles de resumen).
+ */
+template <typename Almacen>
+bool guardarInstantanea(const Almacen& lista, const char* ruta) {
+    std::vector<EntradaInstantanea> entradas;
+    entradas.reserve(static_cast<std::size_t>(lista.obtenerTamanio()));
+
+    std::string temporal = std::string(ruta) + ".tmp";
+    std::ofstream salida(temporal.c_str(), std::ios::binary | std::ios::trunc);
+    if (!salida) {
+        IOT_ERROR("No se pudo crear la instantanea " << temporal);
+        return false;
+    }
+
+    // La tabla se escribe al final, cuando ya se conocen las posiciones
+    unsigned long long posicion = sizeof(CabeceraInstantanea) +
+                                  static_cast<unsigned long long>(lista.obtenerTamanio()) * sizeof(EntradaInstantanea);
+    static const char ceros[8] = { 0 };
+    salida.seekp(static_cast<std::streamoff>(posicion));
+    for (SensorBase* sensor : lista) {
+        EntradaInstantanea entrada;
+        std::memset(&entrada, 0, sizeof(entrada));
+        // SensorBase limita el nombre a 49 caracteres, así que siempre queda el '\0'
+        std::memcpy(entrada.nombre, sensor->obtenerNombre(), std::strlen(sensor->obtenerNombre()));
+        entrada.desplazamiento = posicion;
+        if (!escribirLecturas(sensor, salida, entrada)) {
+            IOT_ADVERTENCIA("Sensor '" << entrada.nombre << "' de tipo desconocido, no se guarda");
+            continue;
+        }
+        const EstadisticasLecturas& estadisticas = sensor->obtenerEstadisticas();
+        entrada.extremosValidos = estadisticas.extremosValidos ? 1 : 0;
+        entrada.estCantidad = estadisticas.cantidad;
+        entrada.suma = estadisticas.suma;
+        entrada.minimo = estadisticas.minimo;
+        entrada.maximo = estadisticas.maximo;
+        entrada.media = estadisticas.media;
+        entrada.m2 = estadisticas.m2;
+        entradas.push_back(entrada);
+
+        posicion += static_cast<unsigned long long>(entrada.cantidad) * 4;
+        unsigned long long alineada = alinearInstantanea(posicion);
+        salida.write(ceros, static_cast<std::streamsize>(alineada - posicion));
+        posicion = alineada;
+    }
+
+    CabeceraInstantanea cabecera;
+    std::memcpy(cabecera.magia, "IOTS", 4);
+    cabecera.version = VERSION_INSTANTANEA;
+    cabecera.marcaOrden = MARCA_ORDEN_INSTANTANEA;
+    cabecera.cantidadSensores = static_cast<unsigned int>(entradas.size());
+    cabecera.tamanioArchivo = posicion;
+    salida.seekp(0);
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    if (!entradas.empty()) {
+        salida.write(reinterpret_cast<const char*>(entradas.data()),
+                     static_cast<std::streamsize>(entradas.size() * sizeof(EntradaInstantanea)));
+    }
+    // Si hubo sensores desconocidos la tabla quedó más corta: se rellena con ceros
+    for (std::size_t i = entradas.size(); i < static_cast<std::size_t>(lista.obtenerTamanio()); i++) {
+        EntradaInstantanea vacia;
+        std::memset(&vacia, 0, sizeof(vacia));
+        salida.write(reinterpret_cast<const char*>(&vacia), sizeof(vacia));
+    }
+    salida.close();
+    if (!salida) {
+        IOT_ERROR("No se pudo escribir la instantanea " << temporal);
+        std::remove(temporal.c_str());
+        return false;
+    }
+
+    if (!sincronizarArchivo(temporal.c_str())) {
+        IOT_ERROR("No se pudo forzar a disco la instantanea " << temporal);
+        std::remove(temporal.c_str());
+        return false;
+    }
+    // En Windows la instantánea cargada sigue proyectada y no se puede
+    // reemplazar: los sensores que leen de ella copian antes sus lecturas
+    if (REEMPLAZO_EXIGE_SOLTAR) {
+        for (SensorBase* sensor : lista) sensor->soltarArchivo();
+    }
+    if (!reemplazarArchivo(temporal.c_str(), ruta)) {
+        IOT_ERROR("No se pudo reemplazar la instantanea " << ruta);
+        return false;
+    }
+    IOT_INFO("Instantanea guardada en " << ruta << ": " << entradas.size() << " sensores, " << posicion << " bytes");
+    return true;
+}
+
+/**
+ * @brief Carga los sensores de una instantánea y los agrega a la lista
+ * @tparam Almacen ListaGeneral o un RegistroSensores que admita todos los tipos de sensor
+ * @param ruta Archivo a cargar
+ * @param lista Lista destino (los sensores con un nombre ya registrado se omiten)
+ * @param cargados Número de sensores agregados
+ * @return false si el archivo no existe o no es una instantánea válida
+ *
+ * Los sensores con historial en lista se cargan sin leer sus lecturas:
+ * quedan en el archivo proyectado y cada sensor las lee de ahí
+ * (SensorTemperaturaInstantanea, SensorPresionInstantanea) con las
+ * estadísticas guardadas. Los demás se crean con crearSensorTemperaturaEn
+ * o crearSensorPresionEn y la política de su entrada, y reciben las
+ * lecturas guardadas con la marca de tiempo de la carga; sus estadísticas
+ * se recalculan a partir de ellas.
+ */
+template <typename Almacen>
+bool cargarInstantanea(const char* ruta, Almacen& lista, int& cargados) {
+    cargados = 0;
+    std::shared_ptr<ArchivoMapeado> archivo(new ArchivoMapeado());
+    if (!archivo->abrir(ruta)) {
+        IOT_INFO("No hay instantanea en " << ruta);
+        return false;
+    }
+    const unsigned char* base = archivo->obtenerDatos();
+    std::size_t tamanio = archivo->obtenerTamanio();
+    if (tamanio < sizeof(CabeceraInstantanea)) {
+        IOT_ERROR("Instantanea " << ruta << " truncada");
+        return false;
+    }
+    CabeceraInstantanea cabecera;
+    std::memcpy(&cabecera, base, sizeof(cabecera));
+    if (std::memcmp(cabecera.magia, "IOTS", 4) != 0 || cabecera.marcaOrden != MARCA_ORDEN_INSTANTANEA) {
+        IOT_ERROR("Instantanea " << ruta << " no reconocida");
+        return false;
+    }
+    if (cabecera.version != VERSION_INSTANTANEA) {
+        IOT_ERROR("Instantanea " << ruta << " de version " << cabecera.version << " no soportada");
+        return false;
+    }
+    unsigned long long finTabla = sizeof(CabeceraInstantanea) +
+                                  static_cast<unsigned long long>(cabecera.cantidadSensores) * sizeof(EntradaInstantanea);
+    if (cabecera.tamanioArchivo != tamanio || finTabla > tamanio) {
+        IOT_ERROR("Instantanea " << ruta << " truncada");
+        return false;
+    }
+
+    std::shared_ptr<const ArchivoMapeado> compartido(archivo);
+    long long ahora = instanteActualNs();
+    const EntradaInstantanea* entradas = reinterpret_cast<const EntradaInstantanea*>(base + sizeof(CabeceraInstantanea));
+    for (unsigned int i = 0; i < cabecera.cantidadSensores; i++) {
+        const EntradaInstantanea& entrada = entradas[i];
+        // Los límites se comprueban sin sumar al desplazamiento: uno cercano a 2^64 daría la vuelta
+        if (std::memchr(entrada.nombre, '\0', sizeof(entrada.nombre)) == nullptr ||
+            entrada.tipo > INSTANTANEA_PRESION || entrada.historial > HISTORIAL_INDEXADO ||
+            (entrada.historial == HISTORIAL_CIRCULAR && entrada.capacidad <= 0) || entrada.desplazamiento % 4 != 0 ||
+            entrada.desplazamiento < finTabla || entrada.desplazamiento > tamanio || entrada.cantidad > 0x7FFFFFFFu ||
+            entrada.cantidad > (tamanio - entrada.desplazamiento) / 4) {
+            IOT_ERROR("Entrada " << i << " de la instantanea " << ruta << " no es valida");
+            continue;
+        }
+        if (lista.buscarSensor(entrada.nombre) != nullptr) {
+            IOT_ADVERTENCIA("Sensor '" << entrada.nombre << "' ya existe, no se carga de la instantanea");
+            continue;
+        }
+
+        const unsigned char* lecturas = base + entrada.desplazamiento;
+        int cantidad = static_cast<int>(entrada.cantidad);
+        if (entrada.historial != HISTORIAL_LISTA) {
+            PoliticaRetencion politica = politicaDeEntrada(entrada);
+            if (entrada.tipo == INSTANTANEA_TEMPERATURA) {
+                RutaSensor ruta = rutaDeSensor(&crearSensorTemperaturaEn(lista, entrada.nombre, politica));
+                float valor;
+                for (int j = 0; j < cantidad; j++) {
+                    std::memcpy(&valor, lecturas + static_cast<std::size_t>(j) * sizeof(float), sizeof(valor));
+                    ruta.registrarTemperatura(ruta.sensor, valor, ahora);
+                }
+            } else {
+                RutaSensor ruta = rutaDeSensor(&crearSensorPresionEn(lista, entrada.nombre, politica));
+                int valor;
+                for (int j = 0; j < cantidad; j++) {
+                    std::memcpy(&valor, lecturas + static_cast<std::size_t>(j) * sizeof(int), sizeof(valor));
+                    ruta.registrarPresion(ruta.sensor, valor, ahora);
+                }
+            }
+            cargados++;
+            continue;
+        }
+
+        SensorBase* sensor;
+        if (entrada.tipo == INSTANTANEA_TEMPERATURA) {
+            sensor = &lista.template crear<SensorTemperaturaInstantanea>(entrada.nombre, compartido,
+                                                                         reinterpret_cast<const float*>(lecturas), cantidad);
+        } else {
+            sensor = &lista.template crear<SensorPresionInstantanea>(entrada.nombre, compartido,
+                                                                     reinterpret_cast<const int*>(lecturas), cantidad);
+        }
+        EstadisticasLecturas estadisticas;
+        estadisticas.cantidad = entrada.estCantidad;
+        estadisticas.suma = entrada.suma;
+        estadisticas.minimo = entrada.minimo;
+        estadisticas.maximo = entrada.maximo;
+        estadisticas.media = entrada.media;
+        estadisticas.m2 = entrada.m2;
+        estadisticas.extremosValidos = entrada.extremosValidos != 0;
+        sensor->restaurarEstadisticas(estadisticas);
+        cargados++;
+    }
+    IOT_INFO("Instantanea " << ruta << " cargada: " << cargados << " sensores");
+    return true;
+}
+
+#endif
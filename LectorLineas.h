@@ -0,0 +1,351 @@
+#ifndef LECTORLINEAS_H
+#define LECTORLINEAS_H
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @file LectorLineas.h
+ * @brief Separación de líneas sin copias y parseo numérico sin asignaciones
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct VistaCadena
+ * @brief Referencia (puntero + longitud) a caracteres que no le pertenecen
+ *
+ * Equivalente mínimo de std::string_view para C++11. La vista es válida
+ * solo mientras exista el buffer del que proviene.
+ */
+struct VistaCadena {
+    const char* datos;     ///< Primer carácter
+    std::size_t longitud;  ///< Número de caracteres
+
+    /**
+     * @brief Indica si la vista no tiene caracteres
+     */
+    bool vacia() const { return longitud == 0; }
+
+    /**
+     * @brief Indica si la vista comienza con un prefijo
+     * @param prefijo Cadena terminada en '\0'
+     */
+    bool empiezaCon(const char* prefijo) const {
+        std::size_t n = std::strlen(prefijo);
+        return longitud >= n && std::memcmp(datos, prefijo, n) == 0;
+    }
+
+    /**
+     * @brief Compara con una cadena terminada en '\0'
+     * @param texto Cadena a comparar
+     */
+    bool igualA(const char* texto) const {
+        return std::strlen(texto) == longitud && std::memcmp(datos, texto, longitud) == 0;
+    }
+
+    /**
+     * @brief Obtiene una subvista
+     * @param inicio Posición inicial
+     * @param n Número de caracteres (se recorta al final de la vista)
+     */
+    VistaCadena subvista(std::size_t inicio, std::size_t n) const {
+        if (inicio > longitud) inicio = longitud;
+        if (n > longitud - inicio) n = longitud - inicio;
+        VistaCadena v = { datos + inicio, n };
+        return v;
+    }
+
+    /**
+     * @brief Busca un carácter
+     * @param c Carácter a buscar
+     * @param desde Posición inicial de la búsqueda
+     * @return Posición encontrada, o longitud si no existe
+     */
+    std::size_t buscar(char c, std::size_t desde = 0) const {
+        for (std::size_t i = desde; i < longitud; i++) {
+            if (datos[i] == c) return i;
+        }
+        return longitud;
+    }
+};
+
+/**
+ * @brief Construye una vista a partir de una cadena terminada en '\0'
+ * @param texto Cadena de origen
+ * @return Vista sobre el texto
+ */
+inline VistaCadena vistaDe(const char* texto) {
+    VistaCadena v = { texto, std::strlen(texto) };
+    return v;
+}
+
+/**
+ * @brief Parsea un entero decimal con signo que ocupa toda la vista
+ * @param texto Caracteres a convertir
+ * @param valor Resultado
+ * @return true si la vista completa es un entero válido dentro de rango
+ */
+inline bool parsearEntero(VistaCadena texto, int& valor) {
+    std::size_t i = 0;
+    bool negativo = false;
+    if (i < texto.longitud && (texto.datos[i] == '-' || texto.datos[i] == '+')) {
+        negativo = texto.datos[i] == '-';
+        i++;
+    }
+    if (i == texto.longitud) return false;
+
+    long long acumulado = 0;
+    for (; i < texto.longitud; i++) {
+        char c = texto.datos[i];
+        if (c < '0' || c > '9') return false;
+        acumulado = acumulado * 10 + (c - '0');
+        if (acumulado > 2147483648LL) return false;
+    }
+    if (negativo) acumulado = -acumulado;
+    if (acumulado > 2147483647LL || acumulado < -2147483648LL) return false;
+    valor = static_cast<int>(acumulado);
+    return true;
+}
+
+/**
+ * @brief Parsea un número decimal (con exponente opcional) que ocupa toda la vista
+ * @param texto Caracteres a convertir, por ejemplo "23.40", "-1.5e2"
+ * @param valor Resultado
+ * @return true si la vista completa es un número válido
+ *
+ * Acumula hasta 19 dígitos significativos en un entero de 64 bits y
+ * aplica la potencia de 10 al final; no asigna memoria ni depende del locale.
+ */
+inline bool parsearFlotante(VistaCadena texto, float& valor) {
+    static const double potencias[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    std::size_t i = 0;
+    bool negativo = false;
+    if (i < texto.longitud && (texto.datos[i] == '-' || texto.datos[i] == '+')) {
+        negativo = texto.datos[i] == '-';
+        i++;
+    }
+
+    unsigned long long mantisa = 0;
+    int digitos = 0;
+    int exponente = 0;
+    bool hayDigitos = false;
+
+    for (; i < texto.longitud && texto.datos[i] >= '0' && texto.datos[i] <= '9'; i++) {
+        hayDigitos = true;
+        if (digitos < 19) {
+            mantisa = mantisa * 10 + (texto.datos[i] - '0');
+            if (mantisa != 0) digitos++;
+        } else {
+            exponente++;
+        }
+    }
+    if (i < texto.longitud && texto.datos[i] == '.') {
+        i++;
+        for (; i < texto.longitud && texto.datos[i] >= '0' && texto.datos[i] <= '9'; i++) {
+            hayDigitos = true;
+            if (digitos < 19) {
+                mantisa = mantisa * 10 + (texto.datos[i] - '0');
+                if (mantisa != 0) digitos++;
+                exponente--;
+            }
+        }
+    }
+    if (!hayDigitos) return false;
+
+    if (i < texto.longitud && (texto.datos[i] == 'e' || texto.datos[i] == 'E')) {
+        i++;
+        bool expNegativo = false;
+        if (i < texto.longitud && (texto.datos[i] == '-' || texto.datos[i] == '+')) {
+            expNegativo = texto.datos[i] == '-';
+            i++;
+        }
+        if (i == texto.longitud) return false;
+        int expLeido = 0;
+        for (; i < texto.longitud && texto.datos[i] >= '0' && texto.datos[i] <= '9'; i++) {
+            if (expLeido < 10000) expLeido = expLeido * 10 + (texto.datos[i] - '0');
+        }
+        exponente += expNegativo ? -expLeido : expLeido;
+    }
+    if (i != texto.longitud) return false;
+
+    double resultado = static_cast<double>(mantisa);
+    while (exponente > 22) { resultado *= 1e22; exponente -= 22; }
+    while (exponente < -22) { resultado /= 1e22; exponente += 22; }
+    resultado = exponente >= 0 ? resultado * potencias[exponente] : resultado / potencias[-exponente];
+    valor = static_cast<float>(negativo ? -resultado : resultado);
+    return true;
+}
+
+/**
+ * @class LectorLineas
+ * @brief Buffer circular que separa un flujo de bytes en líneas
+ *
+ * La fuente escribe directamente en la zona libre del anillo
+ * (zonaEscritura + confirmarEscritura) y las líneas completas se entregan
+ * como VistaCadena sobre el propio anillo, sin copiar ni asignar memoria.
+ * Solo una línea que da la vuelta al final del anillo se copia a un
+ * buffer fijo interno. Se quitan '\n' y '\r' finales. Una línea más larga
+ * que la capacidad se descarta y se cuenta en lineasDescartadas().
+ *
+ * Las vistas entregadas son válidas hasta la siguiente llamada a
+ * zonaEscritura() o siguienteLinea().
+ */
+class LectorLineas {
+    private:
+        char* anillo;            ///< Memoria del anillo
+        char* lineaPartida;      ///< Copia contigua de una línea que da la vuelta
+        std::size_t capacidad;   ///< Tamaño del anillo (potencia de 2)
+        std::size_t inicio;      ///< Posición (absoluta) del primer byte sin consumir
+        std::size_t fin;         ///< Posición (absoluta) siguiente al último byte escrito
+        std::size_t revisado;    ///< Hasta dónde ya se buscó '\n' sin encontrarlo
+        std::size_t descartadas; ///< Líneas descartadas por exceder la capacidad
+        bool descartando;        ///< true mientras se salta el resto de una línea demasiado larga
+
+        LectorLineas(const LectorLineas&);            ///< No copiable
+        LectorLineas& operator=(const LectorLineas&); ///< No asignable
+
+        /**
+         * @brief Busca el siguiente '\n' sin volver a revisar bytes ya vistos
+         * @return Posición absoluta del salto de línea, o fin si no hay
+         */
+        std::size_t buscarSalto() {
+            if (revisado < inicio) revisado = inicio;
+            while (revisado < fin) {
+                std::size_t p = revisado & (capacidad - 1);
+                std::size_t tramo = capacidad - p < fin - revisado ? capacidad - p : fin - revisado;
+                const void* encontrado = std::memchr(anillo + p, '\n', tramo);
+                if (encontrado != nullptr) {
+                    return revisado + (static_cast<const char*>(encontrado) - (anillo + p));
+                }
+                revisado += tramo;
+            }
+            return fin;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param capacidadMinima Tamaño mínimo del anillo (se redondea a potencia de 2)
+         * @post Toda la memoria se reserva aquí; no se vuelve a asignar
+         */
+        explicit LectorLineas(std::size_t capacidadMinima = 4096)
+            : capacidad(64), inicio(0), fin(0), revisado(0), descartadas(0), descartando(false) {
+            while (capacidad < capacidadMinima) capacidad *= 2;
+            anillo = new char[capacidad];
+            lineaPartida = new char[capacidad];
+        }
+
+        ~LectorLineas() {
+            delete[] anillo;
+            delete[] lineaPartida;
+        }
+
+        /**
+         * @brief Obtiene la zona contigua donde se pueden escribir bytes nuevos
+         * @param disponible Bytes que se pueden escribir en la zona
+         * @return Puntero a la zona
+         *
+         * disponible es 0 si el anillo está lleno de líneas completas que aún
+         * no se consumen con siguienteLinea().
+         */
+        char* zonaEscritura(std::size_t& disponible) {
+            std::size_t ocupados = fin - inicio;
+            if (ocupados == capacidad && buscarSalto() != fin) {
+                disponible = 0;
+                return anillo + (fin & (capacidad - 1));
+            }
+            if (ocupados == capacidad) {
+                // Línea más larga que el anillo: se descarta hasta el próximo '\n'
+                if (!descartando) {
+                    descartando = true;
+                    descartadas++;
+                }
+                inicio = fin;
+                revisado = fin;
+                ocupados = 0;
+            }
+            std::size_t posicion = fin & (capacidad - 1);
+            std::size_t hastaFinal = capacidad - posicion;
+            std::size_t libres = capacidad - ocupados;
+            disponible = hastaFinal < libres ? hastaFinal : libres;
+            return anillo + posicion;
+        }
+
+        /**
+         * @brief Confirma los bytes escritos en la zona de escritura
+         * @param n Bytes escritos
+         */
+        void confirmarEscritura(std::size_t n) { fin += n; }
+
+        /**
+         * @brief Copia bytes al anillo (para fuentes que no escriben en sitio)
+         * @param datos Bytes a agregar
+         * @param n Número de bytes
+         * @return Bytes copiados (menos que n si el anillo se llenó)
+         */
+        std::size_t agregar(const char* datos, std::size_t n) {
+            std::size_t copiados = 0;
+            while (copiados < n) {
+                std::size_t disponible;
+                char* zona = zonaEscritura(disponible);
+                if (disponible == 0) break;
+                std::size_t trozo = n - copiados < disponible ? n - copiados : disponible;
+                std::memcpy(zona, datos + copiados, trozo);
+                confirmarEscritura(trozo);
+                copiados += trozo;
+            }
+            return copiados;
+        }
+
+        /**
+         * @brief Extrae la siguiente línea completa
+         * @param linea Vista de la línea, sin '\n' ni '\r' finales
+         * @return true si había una línea completa
+         */
+        bool siguienteLinea(VistaCadena& linea) {
+            while (true) {
+                std::size_t posNueva = buscarSalto();
+                if (posNueva == fin) return false;
+
+                std::size_t longitud = posNueva - inicio;
+                std::size_t p = inicio & (capacidad - 1);
+                if (p + longitud <= capacidad) {
+                    linea.datos = anillo + p;
+                } else {
+                    std::size_t primera = capacidad - p;
+                    std::memcpy(lineaPartida, anillo + p, primera);
+                    std::memcpy(lineaPartida + primera, anillo, longitud - primera);
+                    linea.datos = lineaPartida;
+                }
+                linea.longitud = longitud;
+                inicio = posNueva + 1;
+                revisado = inicio;
+
+                if (descartando) {
+                    descartando = false;
+                    continue;
+                }
+                while (linea.longitud > 0 && linea.datos[linea.longitud - 1] == '\r') {
+                    linea.longitud--;
+                }
+                return true;
+            }
+        }
+
+        /**
+         * @brief Bytes escritos pendientes de formar línea
+         */
+        std::size_t pendientes() const { return fin - inicio; }
+
+        /**
+         * @brief Líneas descartadas por exceder la capacidad del anillo
+         */
+        std::size_t lineasDescartadas() const { return descartadas; }
+};
+
+#endif
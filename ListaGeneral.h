@@ -1,8 +1,18 @@
 #ifndef LISTAGENERAL_H
 #define LISTAGENERAL_H
 
+#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 #include "SensorBase.h"
+#include "PoolTrabajo.h"
+#include "AsignadorNodos.h"
+#include "IndiceHash.h"
+#include "Bitacora.h"
 
 /**
  * @file ListaGeneral.h
@@ -23,66 +33,139 @@ struct NodoGeneral {
     NodoGeneral* siguiente;  ///< Puntero al siguiente nodo
 };
 
+/**
+ * @class IteradorGeneral
+ * @brief Iterador de avance sobre los sensores de una ListaGeneral
+ *
+ * Entrega el puntero a cada sensor, en orden de inserción. El puntero no
+ * se puede reemplazar a través del iterador (la lista lo tiene en su
+ * índice por nombre), pero el sensor sí se puede modificar, igual que con
+ * los iteradores de std::set.
+ */
+class IteradorGeneral {
+private:
+    NodoGeneral* nodo; ///< Nodo actual (nullptr = fin de la lista)
+
+public:
+    typedef std::forward_iterator_tag iterator_category; ///< Solo avanza
+    typedef SensorBase* value_type;                      ///< Puntero al sensor
+    typedef std::ptrdiff_t difference_type;              ///< Distancia entre iteradores
+    typedef SensorBase* const* pointer;                  ///< Puntero al puntero del sensor
+    typedef SensorBase* const& reference;                ///< Referencia al puntero del sensor
+
+    /**
+     * @brief Constructor
+     * @param inicial Nodo al que apunta (nullptr = fin)
+     */
+    explicit IteradorGeneral(NodoGeneral* inicial = nullptr) : nodo(inicial) {}
+
+    reference operator*() const { return nodo->sensor; }
+    pointer operator->() const { return &nodo->sensor; }
+
+    IteradorGeneral& operator++() {
+        nodo = nodo->siguiente;
+        return *this;
+    }
+
+    IteradorGeneral operator++(int) {
+        IteradorGeneral anterior(*this);
+        nodo = nodo->siguiente;
+        return anterior;
+    }
+
+    bool operator==(const IteradorGeneral& otro) const { return nodo == otro.nodo; }
+    bool operator!=(const IteradorGeneral& otro) const { return nodo != otro.nodo; }
+};
+
 /**
  * @class ListaGeneral
  * @brief Lista enlazada para gestionar una colección heterogénea de sensores
  * 
  * Esta lista permite almacenar diferentes tipos de sensores (temperatura,
  * presión, etc.) en una misma estructura mediante polimorfismo. Gestiona
- * automáticamente la memoria de los sensores almacenados.
+ * automáticamente la memoria de los sensores almacenados. Junto a la lista
+ * (que conserva el orden de inserción) mantiene un índice hash por nombre
+ * para que buscarSensor sea O(1).
+ *
+ * begin()/end() recorren los sensores con IteradorGeneral, que sirve con
+ * for de rango y con los algoritmos de la STL.
  */
 class ListaGeneral {
 private:
     NodoGeneral* cabeza; ///< Puntero al primer nodo de la lista
+    NodoGeneral* cola;   ///< Puntero al último nodo (inserción al final en O(1))
+    int tamanio;         ///< Cantidad de sensores registrados
+    AsignadorPool<NodoGeneral> asignador; ///< Pool del que se toman los nodos
+    IndiceHash<SensorBase*> indice;       ///< Índice nombre -> sensor
 
 public:
+    typedef IteradorGeneral iterator;       ///< Iterador sobre los sensores
+    typedef IteradorGeneral const_iterator; ///< Igual que iterator: ninguno reemplaza sensores
+    typedef SensorBase* value_type;         ///< Puntero al sensor (nombre de la STL)
+
     /**
      * @brief Constructor por defecto
-     * @post Inicializa la lista vacía con cabeza = nullptr
+     * @post Inicializa la lista vacía con cabeza = cola = nullptr
      */
-    ListaGeneral() : cabeza(nullptr) {}
+    ListaGeneral() : cabeza(nullptr), cola(nullptr), tamanio(0) {}
     
     /**
      * @brief Destructor de la lista general
      * @post Libera toda la memoria de nodos y sensores
      * 
-     * Recorre la lista eliminando cada nodo y su sensor asociado.
-     * Los sensores se destruyen polimórficamente.
+     * Recorre la lista eliminando el sensor de cada nodo; los sensores se
+     * destruyen polimórficamente y los nodos se devuelven con el pool.
      */
     ~ListaGeneral() {
         NodoGeneral* actual = cabeza;
         while (actual != nullptr) {
             NodoGeneral* siguiente = actual->siguiente;
-            std::cout << "Liberando sensor: " << actual->sensor->obtenerNombre() << std::endl;
+            IOT_INFO("Liberando sensor: " << actual->sensor->obtenerNombre());
             delete actual->sensor;  
-            delete actual;
             actual = siguiente;
         }
+        asignador.liberarTodo();
     }
     
     /**
      * @brief Inserta un nuevo sensor al final de la lista
      * @param sensor Puntero al sensor a insertar
-     * @post El sensor se agrega al final de la lista
+     * @post El sensor se agrega al final de la lista en O(1) usando la cola
      * @warning La lista toma propiedad del puntero y lo liberará en el destructor
      */
     void insertarSensor(SensorBase* sensor) {
-        NodoGeneral* nuevoNodo = new NodoGeneral();
+        NodoGeneral* nuevoNodo = asignador.reservar();
         nuevoNodo->sensor = sensor;
         nuevoNodo->siguiente = nullptr;
         
         if (cabeza == nullptr) {
             cabeza = nuevoNodo;
         } else {
-            NodoGeneral* actual = cabeza;
-            while (actual->siguiente != nullptr) {
-                actual = actual->siguiente;
-            }
-            actual->siguiente = nuevoNodo;
+            cola->siguiente = nuevoNodo;
         }
-        std::cout << "Sensor '" << sensor->obtenerNombre() << "' agregado a lista general" << std::endl;
+        cola = nuevoNodo;
+        tamanio++;
+        indice.insertar(sensor->obtenerNombre(), sensor->obtenerHash(), sensor);
+        IOT_INFO("Sensor '" << sensor->obtenerNombre() << "' agregado a lista general");
     }
     
+    /**
+     * @brief Construye un sensor y lo inserta al final de la lista
+     * @tparam Sensor Tipo concreto del sensor
+     * @param nombre Nombre del sensor
+     * @param args Argumentos restantes del constructor (capacidad, ventana, ...)
+     * @return Referencia tipada al sensor, válida mientras viva la lista
+     *
+     * Misma firma que RegistroSensores::crear, para que el código que crea
+     * sensores (EnrutadorESP32, cargarInstantanea) sirva con ambos.
+     */
+    template <typename Sensor, typename... Args>
+    Sensor& crear(const char* nombre, Args&&... args) {
+        Sensor* sensor = new Sensor(nombre, std::forward<Args>(args)...);
+        insertarSensor(sensor);
+        return *sensor;
+    }
+
     /**
      * @brief Ejecuta procesamiento polimórfico en todos los sensores
      * @post Llama al método procesarLectura() de cada sensor
@@ -92,12 +175,54 @@ public:
      */
     void procesarTodos() {
         std::cout << "\nProcesando todos los sensores..." << std::endl;
-        NodoGeneral* actual = cabeza;
-        while (actual != nullptr) {
-            actual->sensor->procesarLectura();
-            actual = actual->siguiente;
+        for (SensorBase* sensor : *this) {
+            sensor->procesarLectura();
         }
     }
+
+    /**
+     * @brief Procesa todos los sensores en paralelo y muestra el resultado en orden
+     * @param pool Hilos que reparten los sensores con robo de trabajo
+     * @param tiemposNs Si no es nullptr, recibe el tiempo de cada sensor en ns, en orden de la lista
+     * @post La salida es la misma que la de procesarTodos(), en el mismo orden
+     *
+     * Cada sensor se procesa en el hilo que lo tome, escribiendo en su
+     * propio búfer; los mensajes de la bitácora de ese hilo se desvían al
+     * mismo búfer mientras tanto. Al terminar todos, los búferes se
+     * escriben en std::cout en el orden de la lista. Los sensores son
+     * independientes entre sí, así que no hace falta más sincronización.
+     */
+    void procesarTodos(PoolTrabajo& pool, std::vector<long long>* tiemposNs = nullptr) {
+        std::cout << "\nProcesando todos los sensores..." << std::endl;
+        std::vector<SensorBase*> sensores(begin(), end());
+        std::vector<std::string> salidas(sensores.size());
+        std::vector<long long> tiempos(sensores.size());
+
+        // Cada búfer empieza con el formato de std::cout, donde se escribiría en serie
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        pool.paraCadaIndice(sensores.size(), [&sensores, &salidas, &tiempos, formato, precision](std::size_t i) {
+            // Un búfer por hilo, reutilizado: construir un ostringstream por sensor cuesta más que procesarlo
+            static thread_local std::ostringstream salida;
+            static thread_local SumideroConsola captura(salida);
+            salida.str(std::string());
+            salida.clear();
+            salida.flags(formato);
+            salida.precision(precision);
+            SumideroBitacora* anterior = Bitacora::establecerSumideroDelHilo(&captura);
+            std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+            sensores[i]->procesarLectura(salida);
+            tiempos[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inicio).count();
+            Bitacora::establecerSumideroDelHilo(anterior);
+            salidas[i] = salida.str();
+        });
+
+        for (std::size_t i = 0; i < salidas.size(); i++) {
+            std::cout.write(salidas[i].data(), static_cast<std::streamsize>(salidas[i].size()));
+        }
+        std::cout.flush();
+        if (tiemposNs != nullptr) tiemposNs->swap(tiempos);
+    }
     
     /**
      * @brief Muestra información de todos los sensores en la lista
@@ -108,10 +233,8 @@ public:
      */
     void mostrarTodos() const {
         std::cout << "\n--- LISTA GENERAL DE SENSORES ---" << std::endl;
-        NodoGeneral* actual = cabeza;
-        while (actual != nullptr) {
-            actual->sensor->mostrarInfo();
-            actual = actual->siguiente;
+        for (SensorBase* sensor : *this) {
+            sensor->mostrarInfo();
         }
     }
     
@@ -120,22 +243,24 @@ public:
      * @param nombre Nombre del sensor a buscar
      * @return Puntero al sensor si se encuentra, nullptr en caso contrario
      * 
-     * Realiza comparación carácter por carácter del nombre
+     * Consulta el índice hash en O(1). Con nombres repetidos se devuelve
+     * el primero que se insertó, igual que el recorrido lineal.
      */
-    SensorBase* buscarSensor(const char* nombre) {
-        NodoGeneral* actual = cabeza;
-        while (actual != nullptr) {
-            const char* nombreSensor = actual->sensor->obtenerNombre();
-            int i = 0;
-            while (nombre[i] != '\0' && nombreSensor[i] != '\0' && nombre[i] == nombreSensor[i]) {
-                i++;
-            }
-            if (nombre[i] == '\0' && nombreSensor[i] == '\0') {
-                return actual->sensor;
-            }
-            actual = actual->siguiente;
-        }
-        return nullptr;
+    SensorBase* buscarSensor(const char* nombre) const {
+        SensorBase* const* encontrado = indice.buscar(nombre);
+        return encontrado != nullptr ? *encontrado : nullptr;
+    }
+
+    /**
+     * @brief Busca un sensor por un nombre que no termina en '\0'
+     * @param nombre Caracteres del nombre
+     * @param longitud Número de caracteres
+     * @param hash Hash del nombre (hashCadena)
+     * @return Puntero al sensor si se encuentra, nullptr en caso contrario
+     */
+    SensorBase* buscarSensor(const char* nombre, std::size_t longitud, unsigned int hash) const {
+        SensorBase* const* encontrado = indice.buscar(nombre, longitud, hash);
+        return encontrado != nullptr ? *encontrado : nullptr;
     }
     
     /**
@@ -143,6 +268,15 @@ public:
      * @return Puntero al primer nodo de la lista
      */
     NodoGeneral* obtenerCabeza() const { return cabeza; }
+
+    iterator begin() const { return iterator(cabeza); } ///< Primer sensor
+    iterator end() const { return iterator(); }         ///< Fin de la lista
+
+    /**
+     * @brief Obtiene la cantidad de sensores registrados
+     * @return Número de sensores en la lista (O(1))
+     */
+    int obtenerTamanio() const { return tamanio; }
 };
 
 #endif
\ No newline at end of file
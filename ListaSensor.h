@@ -1,7 +1,12 @@
 #ifndef LISTASENSOR_H
 #define LISTASENSOR_H
 
-#include <iostream>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "AsignadorNodos.h"
+#include "Bitacora.h"
 
 /**
  * @file ListaSensor.h
@@ -25,29 +30,111 @@ struct Nodo {
  * @class ListaSensor
  * @brief Lista enlazada simple genérica para almacenar lecturas de sensores
  * @tparam T Tipo de dato que almacenará la lista (int, float, etc.)
+ * @tparam Asignador Política de memoria de los nodos (ver AsignadorNodos.h)
  * 
  * Implementa una lista enlazada simple con operaciones básicas de inserción,
  * búsqueda, eliminación y consulta. Gestiona automáticamente la memoria
- * mediante constructores de copia y destructores.
+ * mediante constructores de copia y destructores. Por defecto los nodos
+ * se toman de un pool por lista, que se libera por losas completas.
+ *
+ * Mover una lista (o intercambiarla) entrega sus nodos y su pool en O(1),
+ * y empalmar() pasa los nodos de otra lista al final sin copiarlos.
+ *
+ * begin()/end() dan iteradores de avance (forward), así que la lista
+ * sirve con for de rango y con los algoritmos de <algorithm>/<numeric>.
  */
-template <typename T>
+template <typename T, typename Asignador = AsignadorPool<Nodo<T> > >
 class ListaSensor {
+    public:
+        typedef T TipoValor; ///< Tipo de las lecturas almacenadas
+
+        /**
+         * @class IteradorLista
+         * @brief Iterador de avance sobre las lecturas de la lista
+         * @tparam Valor T para modificar las lecturas, const T para solo leerlas
+         *
+         * Un iterador sigue siendo válido mientras no se elimine su nodo.
+         */
+        template <typename Valor>
+        class IteradorLista {
+            private:
+                Nodo<T>* nodo; ///< Nodo actual (nullptr = fin de la lista)
+
+            public:
+                typedef std::forward_iterator_tag iterator_category; ///< Solo avanza
+                typedef T value_type;                                ///< Tipo de las lecturas
+                typedef std::ptrdiff_t difference_type;              ///< Distancia entre iteradores
+                typedef Valor* pointer;                              ///< Puntero a la lectura
+                typedef Valor& reference;                            ///< Referencia a la lectura
+
+                /**
+                 * @brief Constructor, iterador de fin
+                 */
+                IteradorLista() : nodo(nullptr) {}
+
+                /**
+                 * @brief Constructor a partir de un nodo
+                 * @param inicial Nodo al que apunta (nullptr = fin)
+                 */
+                explicit IteradorLista(Nodo<T>* inicial) : nodo(inicial) {}
+
+                /**
+                 * @brief Conversión de iterador modificable a iterador de solo lectura
+                 */
+                template <typename Otro>
+                IteradorLista(const IteradorLista<Otro>& otro,
+                              typename std::enable_if<std::is_const<Valor>::value && std::is_same<Otro, T>::value>::type* = nullptr)
+                    : nodo(otro.obtenerNodo()) {}
+
+                reference operator*() const { return nodo->dato; }
+                pointer operator->() const { return &nodo->dato; }
+
+                IteradorLista& operator++() {
+                    nodo = nodo->sig;
+                    return *this;
+                }
+
+                IteradorLista operator++(int) {
+                    IteradorLista anterior(*this);
+                    nodo = nodo->sig;
+                    return anterior;
+                }
+
+                template <typename Otro>
+                bool operator==(const IteradorLista<Otro>& otro) const { return nodo == otro.obtenerNodo(); }
+
+                template <typename Otro>
+                bool operator!=(const IteradorLista<Otro>& otro) const { return nodo != otro.obtenerNodo(); }
+
+                /**
+                 * @brief Nodo al que apunta el iterador
+                 */
+                Nodo<T>* obtenerNodo() const { return nodo; }
+        };
+
+        typedef IteradorLista<T> iterator;             ///< Iterador que permite modificar las lecturas
+        typedef IteradorLista<const T> const_iterator; ///< Iterador de solo lectura
+        typedef T value_type;                          ///< Tipo de las lecturas (nombre de la STL)
+
     private:
         Nodo<T>* cabeza; ///< Puntero al primer nodo de la lista
+        Nodo<T>* cola;   ///< Puntero al último nodo (inserción al final en O(1))
+        int tamanio;     ///< Cantidad de nodos mantenida en cada operación
+        Asignador asignador; ///< Origen de la memoria de los nodos
         
     public:
         /**
          * @brief Constructor por defecto
-         * @post Inicializa la lista vacía con cabeza = nullptr
+         * @post Inicializa la lista vacía con cabeza = cola = nullptr
          */
-        ListaSensor() : cabeza(nullptr) {}
+        ListaSensor() : cabeza(nullptr), cola(nullptr), tamanio(0) {}
         
         /**
          * @brief Constructor de copia
          * @param otra Referencia a la lista que se va a copiar
          * @post Crea una copia profunda de la lista original
          */
-        ListaSensor(const ListaSensor<T>& otra) : cabeza(nullptr) {
+        ListaSensor(const ListaSensor& otra) : cabeza(nullptr), cola(nullptr), tamanio(0) {
             Nodo<T>* actual = otra.cabeza;
             while (actual != nullptr) {
                 insertar(actual->dato);
@@ -61,15 +148,18 @@ class ListaSensor {
          * @return Referencia a esta lista
          * @post Libera la memoria actual y crea una copia de la otra lista
          */
-        ListaSensor<T>& operator=(const ListaSensor<T>& otra) {
+        ListaSensor& operator=(const ListaSensor& otra) {
             if (this != &otra) {
                 Nodo<T>* actual = cabeza;
-                while (actual != nullptr) {
+                while (actual != nullptr && !Asignador::liberacionMasiva) {
                     Nodo<T>* sig = actual->sig;
-                    delete actual;
+                    asignador.liberar(actual);
                     actual = sig;
                 }
+                asignador.liberarTodo();
                 cabeza = nullptr;
+                cola = nullptr;
+                tamanio = 0;
 
                 actual = otra.cabeza;
                 while (actual != nullptr) {
@@ -80,43 +170,144 @@ class ListaSensor {
             return *this;
         }
         
+        /**
+         * @brief Constructor de movimiento
+         * @param otra Lista cuyos nodos y memoria pasan a esta
+         * @post otra queda vacía; no se copia ni se reserva ningún nodo
+         */
+        ListaSensor(ListaSensor&& otra) noexcept : cabeza(otra.cabeza), cola(otra.cola), tamanio(otra.tamanio) {
+            asignador.intercambiar(otra.asignador);
+            otra.cabeza = nullptr;
+            otra.cola = nullptr;
+            otra.tamanio = 0;
+        }
+
+        /**
+         * @brief Asignación por movimiento
+         * @param otra Lista cuyos nodos y memoria pasan a esta
+         * @return Referencia a esta lista
+         * @post Los nodos anteriores se liberan y otra queda vacía
+         */
+        ListaSensor& operator=(ListaSensor&& otra) noexcept {
+            if (this != &otra) {
+                ListaSensor temporal(std::move(otra));
+                intercambiar(temporal);
+            }
+            return *this;
+        }
+        
         /**
          * @brief Destructor de la lista
          * @post Libera toda la memoria dinámica de los nodos
          * 
-         * Recorre la lista eliminando cada nodo y liberando su memoria.
-         * Imprime mensajes de log para cada nodo destruido.
+         * Recorre la lista emitiendo un mensaje de depuración por cada nodo
+         * destruido. Si el asignador libera por losas, la memoria se
+         * devuelve al final en bloque y la lista solo se recorre cuando la
+         * depuración está activa.
          */
         ~ListaSensor() {
-            Nodo<T>* actual = cabeza;
-            while (actual != nullptr) {
-                Nodo<T>* sig = actual->sig;
-                std::cout << "Nodo con valor: " << actual->dato << " destruido" << std::endl;
-                delete actual;
-                actual = sig;
+            if (!Asignador::liberacionMasiva || Bitacora::habilitado(BITACORA_DEPURACION)) {
+                Nodo<T>* actual = cabeza;
+                while (actual != nullptr) {
+                    Nodo<T>* sig = actual->sig;
+                    IOT_DEPURACION("Nodo con valor: " << actual->dato << " destruido");
+                    if (!Asignador::liberacionMasiva) {
+                        asignador.liberar(actual);
+                    }
+                    actual = sig;
+                }
             }
+            asignador.liberarTodo();
         }
         
         /**
          * @brief Inserta un nuevo elemento al final de la lista
          * @param valor Valor a insertar en la lista
          * @post Se agrega un nuevo nodo al final de la lista
+         * 
+         * Usa el puntero a la cola, por lo que la inserción es O(1)
+         * sin importar la longitud del historial.
          */
         void insertar(T valor) {
-            Nodo<T>* nuevoNodo = new Nodo<T>();
+            Nodo<T>* nuevoNodo = asignador.reservar();
             nuevoNodo->dato = valor;
             nuevoNodo->sig = nullptr;
             
             if (cabeza == nullptr) {
                 cabeza = nuevoNodo;
             } else {
-                Nodo<T>* actual = cabeza;
-                while (actual->sig != nullptr) {
-                    actual = actual->sig;
-                }
-                actual->sig = nuevoNodo;
-                std::cout << "Nodo insertado: " << valor << std::endl;
+                cola->sig = nuevoNodo;
+                IOT_DEPURACION("Nodo insertado: " << valor);
             }
+            cola = nuevoNodo;
+            tamanio++;
+        }
+        
+        /**
+         * @brief Inserta un lote de valores al final de la lista
+         * @param valores Arreglo con las lecturas, en orden
+         * @param cantidad Número de lecturas del arreglo
+         * @post Los valores quedan al final, en el mismo orden
+         * 
+         * Enlaza la cadena del lote de una pasada y la engancha a la cola
+         * una sola vez, en lugar de hacerlo nodo por nodo.
+         */
+        void insertarLote(const T* valores, std::size_t cantidad) {
+            if (cantidad == 0) return;
+            Nodo<T>* primero = asignador.reservar();
+            primero->dato = valores[0];
+            Nodo<T>* ultimo = primero;
+            for (std::size_t i = 1; i < cantidad; i++) {
+                Nodo<T>* nuevoNodo = asignador.reservar();
+                nuevoNodo->dato = valores[i];
+                ultimo->sig = nuevoNodo;
+                ultimo = nuevoNodo;
+            }
+            ultimo->sig = nullptr;
+
+            if (cabeza == nullptr) {
+                cabeza = primero;
+            } else {
+                cola->sig = primero;
+            }
+            cola = ultimo;
+            tamanio += static_cast<int>(cantidad);
+            IOT_DEPURACION("Lote insertado: " << cantidad << " nodos");
+        }
+
+        /**
+         * @brief Pasa todos los nodos de otra lista al final de esta
+         * @param otra Lista que se vacía
+         * @post otra queda vacía y sus nodos quedan al final de esta, en orden
+         * 
+         * No reserva ni copia nodos: se enlaza la cadena de otra a la cola
+         * y esta lista se queda con su memoria (ver AsignadorPool::absorber),
+         * así que los nodos siguen en el mismo lugar.
+         */
+        void empalmar(ListaSensor& otra) {
+            if (this == &otra || otra.cabeza == nullptr) return;
+            if (cabeza == nullptr) {
+                cabeza = otra.cabeza;
+            } else {
+                cola->sig = otra.cabeza;
+            }
+            cola = otra.cola;
+            tamanio += otra.tamanio;
+            asignador.absorber(otra.asignador);
+            otra.cabeza = nullptr;
+            otra.cola = nullptr;
+            otra.tamanio = 0;
+        }
+
+        /**
+         * @brief Intercambia el contenido con otra lista en O(1)
+         * @param otra Lista con la que se intercambian nodos y memoria
+         */
+        void intercambiar(ListaSensor& otra) noexcept {
+            Nodo<T>* n = cabeza; cabeza = otra.cabeza; otra.cabeza = n;
+            n = cola; cola = otra.cola; otra.cola = n;
+            int t = tamanio; tamanio = otra.tamanio; otra.tamanio = t;
+            asignador.intercambiar(otra.asignador);
         }
         
         /**
@@ -136,18 +327,10 @@ class ListaSensor {
         }
         
         /**
-         * @brief Calcula el número de elementos en la lista
-         * @return Cantidad de nodos en la lista
+         * @brief Obtiene el número de elementos en la lista
+         * @return Cantidad de nodos en la lista (contador mantenido, O(1))
          */
-        int obtenerTamanio() const {
-            int contador = 0;
-            Nodo<T>* actual = cabeza;
-            while (actual != nullptr) {
-                contador++;
-                actual = actual->sig;
-            }
-            return contador;
-        }
+        int obtenerTamanio() const { return tamanio; }
         
         /**
          * @brief Elimina el primer nodo que contenga el valor especificado
@@ -161,8 +344,10 @@ class ListaSensor {
             if (cabeza->dato == valor) {
                 Nodo<T>* temp = cabeza;
                 cabeza = cabeza->sig;
-                std::cout << "Nodo eliminado: " << temp->dato << std::endl;
-                delete temp;
+                if (cabeza == nullptr) cola = nullptr;
+                tamanio--;
+                IOT_DEPURACION("Nodo eliminado: " << temp->dato);
+                asignador.liberar(temp);
                 return true;
             }
             
@@ -172,22 +357,106 @@ class ListaSensor {
             }
             
             if (actual->sig == nullptr) {
-                std::cout << "Valor no encontrado: " << valor << std::endl;
+                IOT_DEPURACION("Valor no encontrado: " << valor);
                 return false;
             }
             
             Nodo<T>* temp = actual->sig;
             actual->sig = temp->sig;
-            std::cout << "Nodo eliminado: " << temp->dato << std::endl;
-            delete temp;
+            if (temp == cola) cola = actual;
+            tamanio--;
+            IOT_DEPURACION("Nodo eliminado: " << temp->dato);
+            asignador.liberar(temp);
             return true;
         }
         
+        /**
+         * @brief Elimina en una sola pasada todas las lecturas que cumplan un predicado
+         * @param predicado Función invocada como predicado(const T&), true = eliminar
+         * @return Número de nodos eliminados
+         * @post Las lecturas restantes conservan su orden
+         * 
+         * Equivale a llamar eliminarValor() por cada valor, pero recorre la
+         * lista una vez en lugar de una vez por eliminación.
+         */
+        template <typename Predicado>
+        int eliminarSi(Predicado predicado) {
+            int eliminados = 0;
+            Nodo<T>* anterior = nullptr;
+            Nodo<T>* actual = cabeza;
+            while (actual != nullptr) {
+                Nodo<T>* sig = actual->sig;
+                if (predicado(static_cast<const T&>(actual->dato))) {
+                    if (anterior == nullptr) {
+                        cabeza = sig;
+                    } else {
+                        anterior->sig = sig;
+                    }
+                    IOT_DEPURACION("Nodo eliminado: " << actual->dato);
+                    asignador.liberar(actual);
+                    eliminados++;
+                } else {
+                    anterior = actual;
+                }
+                actual = sig;
+            }
+            cola = anterior;
+            tamanio -= eliminados;
+            return eliminados;
+        }
+
+        /**
+         * @brief Elimina el nodo que sigue a una posición
+         * @param posicion Iterador a un nodo de esta lista (no el fin)
+         * @return Iterador al nodo que quedó después de posicion
+         * @post Si posicion era el penúltimo nodo, pasa a ser la cola
+         */
+        iterator eliminarDespues(const_iterator posicion) {
+            Nodo<T>* anterior = posicion.obtenerNodo();
+            Nodo<T>* temp = anterior->sig;
+            if (temp == nullptr) return end();
+            anterior->sig = temp->sig;
+            if (temp == cola) cola = anterior;
+            tamanio--;
+            IOT_DEPURACION("Nodo eliminado: " << temp->dato);
+            asignador.liberar(temp);
+            return iterator(anterior->sig);
+        }
+
         /**
          * @brief Obtiene el puntero a la cabeza de la lista
          * @return Puntero al primer nodo de la lista
          */
         Nodo<T>* obtenerCabeza() const { return cabeza; }
+
+        iterator begin() { return iterator(cabeza); }              ///< Primera lectura
+        iterator end() { return iterator(); }                      ///< Fin de la lista
+        const_iterator begin() const { return const_iterator(cabeza); } ///< Primera lectura (solo lectura)
+        const_iterator end() const { return const_iterator(); }         ///< Fin de la lista (solo lectura)
+        const_iterator cbegin() const { return const_iterator(cabeza); } ///< Primera lectura (solo lectura)
+        const_iterator cend() const { return const_iterator(); }         ///< Fin de la lista (solo lectura)
+
+        /**
+         * @brief Recorre los valores como bloques de un elemento
+         * @param f Función invocada como f(const T* datos, int cantidad)
+         * 
+         * Misma interfaz que ListaSensorDesenrollada::paraCadaBloque, para
+         * que los sensores recorran cualquier historial de la misma forma.
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            for (Nodo<T>* actual = cabeza; actual != nullptr; actual = actual->sig) {
+                f(static_cast<const T*>(&actual->dato), 1);
+            }
+        }
 };
 
+/**
+ * @brief Intercambia dos listas en O(1) (lo usan std::swap y los algoritmos)
+ */
+template <typename T, typename Asignador>
+void swap(ListaSensor<T, Asignador>& a, ListaSensor<T, Asignador>& b) noexcept {
+    a.intercambiar(b);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,241 @@
+#ifndef LISTASENSORDESENROLLADA_H
+#define LISTASENSORDESENROLLADA_H
+
+#include <cstddef>
+#include "AsignadorNodos.h"
+#include "Bitacora.h"
+
+/**
+ * @file ListaSensorDesenrollada.h
+ * @brief Lista enlazada desenrollada: nodos con varios valores contiguos
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct NodoBloque
+ * @brief Nodo que guarda un bloque de valores contiguos
+ * @tparam T Tipo de dato almacenado
+ * @tparam BytesBloque Tamaño objetivo del nodo en bytes (una línea de caché por defecto)
+ *
+ * La capacidad se calcula para que el nodo completo (valores, contador y
+ * enlace) ocupe BytesBloque bytes, así un recorrido lee líneas de caché
+ * llenas de lecturas en vez de un puntero por lectura.
+ */
+template <typename T, std::size_t BytesBloque = 64>
+struct NodoBloque {
+    static const int capacidad =
+        (BytesBloque - sizeof(void*) - sizeof(int)) / sizeof(T) > 0
+            ? static_cast<int>((BytesBloque - sizeof(void*) - sizeof(int)) / sizeof(T))
+            : 1; ///< Valores que caben en el bloque
+
+    T datos[capacidad];            ///< Valores almacenados, en orden de llegada
+    int cantidad;                  ///< Valores ocupados en datos[]
+    NodoBloque<T, BytesBloque>* sig; ///< Siguiente bloque de la lista
+};
+
+/**
+ * @class ListaSensorDesenrollada
+ * @brief Variante desenrollada de ListaSensor con la misma interfaz pública
+ * @tparam T Tipo de dato que almacenará la lista (int, float, etc.)
+ * @tparam BytesBloque Tamaño de cada bloque en bytes
+ *
+ * Ofrece insertar(), busqueda(), eliminarValor() y obtenerTamanio() igual
+ * que ListaSensor, pero almacena las lecturas en bloques contiguos.
+ * Los bloques se recorren con obtenerCabeza() (iterador de bloques) o
+ * con paraCadaBloque().
+ */
+template <typename T, std::size_t BytesBloque = 64>
+class ListaSensorDesenrollada {
+    public:
+        typedef T TipoValor;                      ///< Tipo de las lecturas
+        typedef NodoBloque<T, BytesBloque> Bloque; ///< Tipo de bloque de la lista
+
+    private:
+        Bloque* cabeza;   ///< Primer bloque
+        Bloque* cola;     ///< Último bloque (donde se inserta)
+        int tamanio;      ///< Total de valores almacenados
+        AsignadorPool<Bloque> asignador; ///< Pool del que se toman los bloques
+
+        /**
+         * @brief Libera todos los bloques y deja la lista vacía
+         */
+        void vaciar() {
+            asignador.liberarTodo();
+            cabeza = nullptr;
+            cola = nullptr;
+            tamanio = 0;
+        }
+
+        /**
+         * @brief Copia todos los valores de otra lista al final de esta
+         * @param otra Lista de origen
+         */
+        void copiarDesde(const ListaSensorDesenrollada& otra) {
+            for (Bloque* b = otra.cabeza; b != nullptr; b = b->sig) {
+                for (int i = 0; i < b->cantidad; i++) {
+                    agregarSinLog(b->datos[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Agrega un valor al bloque de la cola
+         * @param valor Valor a agregar
+         */
+        void agregarSinLog(T valor) {
+            if (cola == nullptr || cola->cantidad == Bloque::capacidad) {
+                Bloque* nuevo = asignador.reservar();
+                nuevo->cantidad = 0;
+                nuevo->sig = nullptr;
+                if (cola == nullptr) {
+                    cabeza = nuevo;
+                } else {
+                    cola->sig = nuevo;
+                }
+                cola = nuevo;
+            }
+            cola->datos[cola->cantidad++] = valor;
+            tamanio++;
+        }
+
+    public:
+        /**
+         * @brief Constructor por defecto
+         * @post Lista vacía, sin bloques
+         */
+        ListaSensorDesenrollada() : cabeza(nullptr), cola(nullptr), tamanio(0) {}
+
+        /**
+         * @brief Constructor de copia
+         * @param otra Lista que se va a copiar
+         * @post Copia profunda con los bloques compactados
+         */
+        ListaSensorDesenrollada(const ListaSensorDesenrollada& otra)
+            : cabeza(nullptr), cola(nullptr), tamanio(0) {
+            copiarDesde(otra);
+        }
+
+        /**
+         * @brief Operador de asignación
+         * @param otra Lista que se va a asignar
+         * @return Referencia a esta lista
+         */
+        ListaSensorDesenrollada& operator=(const ListaSensorDesenrollada& otra) {
+            if (this != &otra) {
+                vaciar();
+                copiarDesde(otra);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor, devuelve todos los bloques al pool
+         *
+         * El pool libera los bloques en bloque, así que solo se recorren
+         * cuando la depuración está activa.
+         */
+        ~ListaSensorDesenrollada() {
+            if (Bitacora::habilitado(BITACORA_DEPURACION)) {
+                for (Bloque* b = cabeza; b != nullptr; b = b->sig) {
+                    IOT_DEPURACION("Bloque con " << b->cantidad << " valores destruido");
+                }
+            }
+            asignador.liberarTodo();
+        }
+
+        /**
+         * @brief Inserta un nuevo elemento al final de la lista
+         * @param valor Valor a insertar
+         * @post Se llena el bloque de la cola o se enlaza uno nuevo (O(1))
+         */
+        void insertar(T valor) {
+            agregarSinLog(valor);
+            IOT_DEPURACION("Valor insertado: " << valor);
+        }
+
+        /**
+         * @brief Busca un valor en la lista
+         * @param valor Valor a buscar
+         * @return true si el valor existe en la lista, false en caso contrario
+         */
+        bool busqueda(T valor) {
+            for (Bloque* b = cabeza; b != nullptr; b = b->sig) {
+                for (int i = 0; i < b->cantidad; i++) {
+                    if (b->datos[i] == valor) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Obtiene el número de elementos en la lista
+         * @return Cantidad de valores almacenados (O(1))
+         */
+        int obtenerTamanio() const { return tamanio; }
+
+        /**
+         * @brief Elimina la primera aparición del valor especificado
+         * @param valor Valor a eliminar de la lista
+         * @return true si se eliminó el valor, false si no se encontró
+         *
+         * Desplaza los valores restantes del bloque; si el bloque queda a
+         * menos de la mitad y cabe en él el siguiente, se fusionan para
+         * mantener la densidad. Un bloque vacío se desenlaza.
+         */
+        bool eliminarValor(T valor) {
+            Bloque* anterior = nullptr;
+            for (Bloque* b = cabeza; b != nullptr; anterior = b, b = b->sig) {
+                for (int i = 0; i < b->cantidad; i++) {
+                    if (b->datos[i] != valor) continue;
+
+                    for (int j = i + 1; j < b->cantidad; j++) {
+                        b->datos[j - 1] = b->datos[j];
+                    }
+                    b->cantidad--;
+                    tamanio--;
+                    IOT_DEPURACION("Nodo eliminado: " << valor);
+
+                    if (b->cantidad == 0) {
+                        if (anterior == nullptr) cabeza = b->sig;
+                        else anterior->sig = b->sig;
+                        if (cola == b) cola = anterior;
+                        asignador.liberar(b);
+                    } else if (b->sig != nullptr && b->cantidad < Bloque::capacidad / 2 &&
+                               b->cantidad + b->sig->cantidad <= Bloque::capacidad) {
+                        Bloque* siguiente = b->sig;
+                        for (int j = 0; j < siguiente->cantidad; j++) {
+                            b->datos[b->cantidad++] = siguiente->datos[j];
+                        }
+                        b->sig = siguiente->sig;
+                        if (cola == siguiente) cola = b;
+                        asignador.liberar(siguiente);
+                    }
+                    return true;
+                }
+            }
+            IOT_DEPURACION("Valor no encontrado: " << valor);
+            return false;
+        }
+
+        /**
+         * @brief Obtiene el primer bloque (iterador de bloques)
+         * @return Puntero al primer bloque; se avanza con ->sig
+         */
+        Bloque* obtenerCabeza() const { return cabeza; }
+
+        /**
+         * @brief Recorre los valores por bloques contiguos
+         * @param f Función invocada como f(const T* datos, int cantidad)
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            for (Bloque* b = cabeza; b != nullptr; b = b->sig) {
+                f(static_cast<const T*>(b->datos), b->cantidad);
+            }
+        }
+};
+
+#endif
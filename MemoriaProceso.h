@@ -0,0 +1,44 @@
+#ifndef MEMORIAPROCESO_H
+#define MEMORIAPROCESO_H
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @file MemoriaProceso.h
+ * @brief Consulta de la memoria residente máxima del proceso
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Mayor memoria residente (RSS) que ha usado el proceso
+ * @return KiB, o -1 si la plataforma no lo informa
+ *
+ * POSIX usa getrusage (ru_maxrss viene en KiB en Linux y en bytes en
+ * macOS); Windows usa el pico del conjunto de trabajo.
+ */
+inline long memoriaMaximaKiB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS contadores;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) return -1;
+    return static_cast<long>(contadores.PeakWorkingSetSize / 1024);
+#else
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return -1;
+#ifdef __APPLE__
+    return static_cast<long>(uso.ru_maxrss / 1024);
+#else
+    return static_cast<long>(uso.ru_maxrss);
+#endif
+#endif
+}
+
+#endif
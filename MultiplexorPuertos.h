@@ -0,0 +1,157 @@
+#ifndef MULTIPLEXORPUERTOS_H
+#define MULTIPLEXORPUERTOS_H
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _WIN32
+// Sin descriptores POSIX: la ingesta lee los puertos por turnos
+#elif defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#else
+#include <poll.h>
+#include <cerrno>
+#endif
+
+/**
+ * @file MultiplexorPuertos.h
+ * @brief Espera simultánea sobre los descriptores de varios puertos
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * En Linux usa epoll: registrar un puerto es una llamada y cada espera
+ * devuelve solo los puertos listos, sin recorrer los demás. En otros
+ * sistemas POSIX usa poll() sobre el arreglo de descriptores. En Windows
+ * no hay implementación y agregar() siempre falla.
+ */
+
+/**
+ * @class MultiplexorPuertos
+ * @brief Conjunto de descriptores de lectura y espera hasta que alguno esté listo
+ *
+ * Cada descriptor se registra junto con un índice (la posición del puerto
+ * en quien llama), y esperar() entrega los índices de los puertos con
+ * datos o cerrados. Un puerto cerrado sigue apareciendo como listo hasta
+ * que se quita. Lo usa un solo hilo.
+ */
+class MultiplexorPuertos {
+    private:
+#ifdef _WIN32
+#elif defined(__linux__)
+        int descriptorEpoll;                       ///< Instancia de epoll (-1 si no se pudo crear)
+        std::vector<struct epoll_event> eventos;   ///< Eventos devueltos por epoll_wait
+#else
+        std::vector<struct pollfd> descriptores;   ///< Descriptores registrados
+        std::vector<std::size_t> indices;          ///< Índice de cada descriptor registrado
+#endif
+
+        MultiplexorPuertos(const MultiplexorPuertos&);            ///< No copiable
+        MultiplexorPuertos& operator=(const MultiplexorPuertos&); ///< No asignable
+
+    public:
+        /**
+         * @brief Constructor, conjunto vacío
+         */
+        MultiplexorPuertos() {
+#if !defined(_WIN32) && defined(__linux__)
+            descriptorEpoll = epoll_create1(EPOLL_CLOEXEC);
+#endif
+        }
+
+        /**
+         * @brief Destructor, libera la instancia de epoll (no cierra los puertos)
+         */
+        ~MultiplexorPuertos() {
+#if !defined(_WIN32) && defined(__linux__)
+            if (descriptorEpoll >= 0) ::close(descriptorEpoll);
+#endif
+        }
+
+        /**
+         * @brief Registra el descriptor de un puerto
+         * @param descriptor Descriptor abierto para lectura
+         * @param indice Valor que esperar() entrega cuando el puerto está listo
+         * @return false si el descriptor no admite espera (por ejemplo, un
+         *         archivo regular con epoll) o la plataforma no la ofrece
+         */
+        bool agregar(int descriptor, std::size_t indice) {
+#ifdef _WIN32
+            (void)descriptor;
+            (void)indice;
+            return false;
+#elif defined(__linux__)
+            if (descriptorEpoll < 0 || descriptor < 0) return false;
+            struct epoll_event evento;
+            evento.events = EPOLLIN;
+            evento.data.u64 = indice;
+            if (epoll_ctl(descriptorEpoll, EPOLL_CTL_ADD, descriptor, &evento) != 0) return false;
+            eventos.resize(eventos.size() + 1);
+            return true;
+#else
+            if (descriptor < 0) return false;
+            struct pollfd entrada;
+            entrada.fd = descriptor;
+            entrada.events = POLLIN;
+            entrada.revents = 0;
+            descriptores.push_back(entrada);
+            indices.push_back(indice);
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Deja de esperar un descriptor
+         * @param descriptor Descriptor registrado con agregar()
+         * @pre Se llama antes de cerrar el descriptor
+         */
+        void quitar(int descriptor) {
+#ifdef _WIN32
+            (void)descriptor;
+#elif defined(__linux__)
+            if (epoll_ctl(descriptorEpoll, EPOLL_CTL_DEL, descriptor, nullptr) == 0 && !eventos.empty()) {
+                eventos.pop_back();
+            }
+#else
+            for (std::size_t i = 0; i < descriptores.size(); i++) {
+                if (descriptores[i].fd == descriptor) {
+                    descriptores.erase(descriptores.begin() + static_cast<std::ptrdiff_t>(i));
+                    indices.erase(indices.begin() + static_cast<std::ptrdiff_t>(i));
+                    return;
+                }
+            }
+#endif
+        }
+
+        /**
+         * @brief Espera a que algún puerto tenga datos o se cierre
+         * @param listos Destino de los índices de los puertos listos
+         * @param esperaMs Tiempo máximo de espera
+         * @return Puertos listos (0 si venció la espera o llegó una señal), -1 si hubo error
+         * @post listos tiene tantos elementos como el valor devuelto
+         */
+        int esperar(std::vector<std::size_t>& listos, int esperaMs) {
+            listos.clear();
+#ifdef _WIN32
+            (void)esperaMs;
+            return -1;
+#elif defined(__linux__)
+            if (eventos.empty()) return 0;
+            int n = epoll_wait(descriptorEpoll, &eventos[0], static_cast<int>(eventos.size()), esperaMs);
+            if (n < 0) return errno == EINTR ? 0 : -1;
+            for (int i = 0; i < n; i++) listos.push_back(static_cast<std::size_t>(eventos[i].data.u64));
+            return n;
+#else
+            if (descriptores.empty()) return 0;
+            int n = ::poll(&descriptores[0], static_cast<nfds_t>(descriptores.size()), esperaMs);
+            if (n < 0) return errno == EINTR ? 0 : -1;
+            for (std::size_t i = 0; i < descriptores.size(); i++) {
+                if (descriptores[i].revents != 0) listos.push_back(indices[i]);
+            }
+            return static_cast<int>(listos.size());
+#endif
+        }
+};
+
+#endif
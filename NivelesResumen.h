@@ -0,0 +1,258 @@
+#ifndef NIVELESRESUMEN_H
+#define NIVELESRESUMEN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include "Agregados.h"
+
+/**
+ * @file NivelesResumen.h
+ * @brief Resúmenes de lecturas por segundo, minuto y hora
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct ResumenVentana
+ * @brief Cantidad, suma, mínimo y máximo de las lecturas de una ventana
+ * @tparam T Tipo de las lecturas
+ *
+ * Dos resúmenes de ventanas disjuntas se combinan sin volver a recorrer
+ * las lecturas.
+ */
+template <typename T>
+struct ResumenVentana {
+    long cantidad; ///< Lecturas en la ventana
+    double suma;   ///< Suma de las lecturas
+    T minimo;      ///< Lectura más baja (válido si cantidad > 0)
+    T maximo;      ///< Lectura más alta (válido si cantidad > 0)
+
+    /**
+     * @brief Resumen de una ventana sin lecturas
+     */
+    static ResumenVentana vacio() {
+        ResumenVentana r = { 0, 0.0, T(), T() };
+        return r;
+    }
+
+    /**
+     * @brief Resumen de un bloque contiguo de lecturas
+     * @param datos Lecturas
+     * @param n Número de lecturas
+     */
+    static ResumenVentana deBloque(const T* datos, int n) {
+        ResumenVentana r = vacio();
+        if (n <= 0) return r;
+        r.cantidad = n;
+        r.suma = static_cast<double>(Agregados::suma(datos, n));
+        r.minimo = Agregados::minimo(datos, n);
+        r.maximo = Agregados::maximo(datos, n);
+        return r;
+    }
+
+    /**
+     * @brief Agrega una lectura
+     * @param valor Lectura
+     */
+    void agregar(T valor) {
+        if (cantidad == 0 || valor < minimo) minimo = valor;
+        if (cantidad == 0 || valor > maximo) maximo = valor;
+        cantidad++;
+        suma += valor;
+    }
+
+    /**
+     * @brief Agrega las lecturas de otro resumen
+     * @param otro Resumen de una ventana disjunta
+     */
+    void combinar(const ResumenVentana& otro) {
+        if (otro.cantidad == 0) return;
+        if (cantidad == 0 || otro.minimo < minimo) minimo = otro.minimo;
+        if (cantidad == 0 || otro.maximo > maximo) maximo = otro.maximo;
+        cantidad += otro.cantidad;
+        suma += otro.suma;
+    }
+
+    /**
+     * @brief Media de la ventana (0 si está vacía)
+     */
+    double media() const { return cantidad > 0 ? suma / cantidad : 0.0; }
+};
+
+/**
+ * @struct CubetaResumen
+ * @brief Resumen de las lecturas de un intervalo alineado [inicio, inicio + ancho)
+ */
+template <typename T>
+struct CubetaResumen {
+    long long inicioNs;         ///< Inicio del intervalo (múltiplo del ancho del nivel)
+    ResumenVentana<T> resumen;  ///< Lecturas del intervalo
+};
+
+/**
+ * @class NivelResumen
+ * @brief Cubetas de un ancho fijo, en orden de tiempo, con retención propia
+ * @tparam T Tipo de las lecturas
+ *
+ * Cada lectura se suma a la cubeta de su intervalo en O(1): como las
+ * lecturas llegan en orden, siempre es la última o una nueva. Las cubetas
+ * que terminan antes de (marca más reciente - retención) se descartan.
+ */
+template <typename T>
+class NivelResumen {
+    private:
+        long long anchoNs;       ///< Ancho de cada cubeta
+        long long retencionNs;   ///< Antigüedad máxima de una cubeta (0 = sin límite)
+        long long coberturaNs;   ///< Antes de esta marca ya se descartaron cubetas
+        long long finActualNs;   ///< Fin del intervalo de la última cubeta
+        std::deque<CubetaResumen<T> > cubetas; ///< Cubetas en orden de tiempo
+
+        /**
+         * @brief Compara una cubeta con una marca (para bisección)
+         */
+        static bool empiezaAntes(const CubetaResumen<T>& cubeta, long long t) { return cubeta.inicioNs < t; }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param ancho Ancho de las cubetas en ns
+         * @param retencion Antigüedad máxima en ns (0 = sin límite)
+         */
+        NivelResumen(long long ancho, long long retencion)
+            : anchoNs(ancho), retencionNs(retencion), coberturaNs(std::numeric_limits<long long>::min()),
+              finActualNs(std::numeric_limits<long long>::min()) {}
+
+        /**
+         * @brief Inicio del intervalo que contiene t
+         */
+        long long alinearAbajo(long long t) const { return t - ((t % anchoNs) + anchoNs) % anchoNs; }
+
+        /**
+         * @brief Primer inicio de intervalo mayor o igual que t
+         */
+        long long alinearArriba(long long t) const {
+            long long abajo = alinearAbajo(t);
+            return abajo == t ? t : abajo + anchoNs;
+        }
+
+        /**
+         * @brief Suma una lectura a su cubeta y descarta las cubetas vencidas
+         * @param marcaNs Instante de la lectura (no decreciente)
+         * @param valor Lectura
+         *
+         * Solo al abrir una cubeta se alinea la marca y se revisa la
+         * retención; el caso común es sumar a la última cubeta.
+         */
+        void agregar(long long marcaNs, T valor) {
+            if (marcaNs >= finActualNs) {
+                long long inicio = alinearAbajo(marcaNs);
+                CubetaResumen<T> cubeta = { inicio, ResumenVentana<T>::vacio() };
+                cubetas.push_back(cubeta);
+                finActualNs = inicio + anchoNs;
+                if (retencionNs > 0) {
+                    while (cubetas.front().inicioNs + anchoNs <= marcaNs - retencionNs) {
+                        coberturaNs = cubetas.front().inicioNs + anchoNs;
+                        cubetas.pop_front();
+                    }
+                }
+            }
+            cubetas.back().resumen.agregar(valor);
+        }
+
+        /**
+         * @brief Resume las cubetas que empiezan en [a, b)
+         * @param a Inicio (alineado al ancho)
+         * @param b Fin (alineado al ancho)
+         * @return Combinación de las cubetas; O(log cubetas + cubetas en el rango)
+         */
+        ResumenVentana<T> resumenEntre(long long a, long long b) const {
+            ResumenVentana<T> resumen = ResumenVentana<T>::vacio();
+            typename std::deque<CubetaResumen<T> >::const_iterator it =
+                std::lower_bound(cubetas.begin(), cubetas.end(), a, empiezaAntes);
+            for (; it != cubetas.end() && it->inicioNs < b; ++it) {
+                resumen.combinar(it->resumen);
+            }
+            return resumen;
+        }
+
+        /**
+         * @brief Marca desde la que el nivel conserva todas sus cubetas
+         * @return Mínimo de long long si nunca descartó nada
+         */
+        long long coberturaDesde() const { return coberturaNs; }
+
+        /**
+         * @brief Ancho de las cubetas en ns
+         */
+        long long obtenerAncho() const { return anchoNs; }
+
+        /**
+         * @brief Cubetas conservadas
+         */
+        std::size_t obtenerCantidad() const { return cubetas.size(); }
+
+        /**
+         * @brief Memoria aproximada de las cubetas
+         * @return Bytes
+         */
+        std::size_t bytesReservados() const { return cubetas.size() * sizeof(CubetaResumen<T>); }
+};
+
+/**
+ * @class NivelesResumen
+ * @brief Niveles de 1 s, 1 min y 1 h que se actualizan con cada lectura
+ * @tparam T Tipo de las lecturas
+ *
+ * Por omisión las cubetas de 1 s se conservan una hora, las de 1 min una
+ * semana y las de 1 h sin límite: para un sensor que envía al menos una
+ * lectura por segundo son unos 115 KB (1 s) y 320 KB (1 min) fijos más
+ * 23 KB por mes (1 h).
+ */
+template <typename T>
+class NivelesResumen {
+    public:
+        static const int CANTIDAD = 3; ///< Número de niveles
+
+    private:
+        NivelResumen<T> niveles[CANTIDAD]; ///< Del más fino al más grueso
+
+    public:
+        /**
+         * @brief Constructor con las retenciones por omisión
+         */
+        NivelesResumen()
+            : niveles{ NivelResumen<T>(1000000000LL, 3600LL * 1000000000LL),
+                       NivelResumen<T>(60LL * 1000000000LL, 7LL * 24 * 3600 * 1000000000LL),
+                       NivelResumen<T>(3600LL * 1000000000LL, 0) } {}
+
+        /**
+         * @brief Suma una lectura a los tres niveles
+         * @param marcaNs Instante de la lectura (no decreciente)
+         * @param valor Lectura
+         */
+        void agregar(long long marcaNs, T valor) {
+            for (int i = 0; i < CANTIDAD; i++) {
+                niveles[i].agregar(marcaNs, valor);
+            }
+        }
+
+        /**
+         * @brief Obtiene un nivel
+         * @param i 0 = 1 s, 1 = 1 min, 2 = 1 h
+         */
+        const NivelResumen<T>& nivel(int i) const { return niveles[i]; }
+
+        /**
+         * @brief Memoria de los tres niveles
+         * @return Bytes
+         */
+        std::size_t bytesReservados() const {
+            std::size_t total = 0;
+            for (int i = 0; i < CANTIDAD; i++) total += niveles[i].bytesReservados();
+            return total;
+        }
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef POLITICARETENCION_H
+#define POLITICARETENCION_H
+
+#include <cstddef>
+#include "SensorBase.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+
+/**
+ * @file PoliticaRetencion.h
+ * @brief Cuántas lecturas conserva cada sensor nuevo
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct PoliticaRetencion
+ * @brief Límite del historial de los sensores que se crean
+ *
+ * Con capacidad 0 y sin ventana el historial crece sin límite: una
+ * ListaSensor en los sensores de presión y un HistorialIndexado en los de
+ * temperatura, porque procesarlos quita su mínimo y en la lista eso es un
+ * recorrido de eliminarValor. En otro caso se usa un
+ * HistorialCircular de capacidad fija; si solo se indica la ventana, la
+ * capacidad es CAPACIDAD_POR_VENTANA para que la memoria siga acotada.
+ * Con serieTemporal cada lectura se guarda con su marca de tiempo en una
+ * SerieTemporal para poder consultar ventanas de tiempo; las lecturas
+ * crudas más viejas que horizonteSegundos se compactan en sus niveles de
+ * resumen (0 = conservarlas todas). Con comprimido se conservan todas
+ * las lecturas en un HistorialComprimido (bloques sellados con
+ * codificación XOR o delta); si además se pide serieTemporal (sin
+ * horizonte), sus marcas de tiempo se guardan comprimidas en una segunda
+ * columna. Con indexado también los sensores de presión conservan todas
+ * en un HistorialIndexado, que además las ordena por valor para buscar,
+ * quitar el mínimo y contar rangos en O(log n).
+ */
+struct PoliticaRetencion {
+    static const int CAPACIDAD_POR_VENTANA = 1024; ///< Capacidad si solo hay ventana de tiempo
+
+    int capacidad;          ///< Últimas lecturas a conservar (0 = sin límite)
+    double ventanaSegundos; ///< Antigüedad máxima de una lectura (0 = sin límite)
+    bool serieTemporal;     ///< Guardar cada lectura con su marca de tiempo
+    double horizonteSegundos; ///< Antigüedad máxima de las lecturas crudas de la serie (0 = sin límite)
+    bool comprimido;        ///< Guardar las lecturas en bloques comprimidos
+    bool indexado;          ///< Guardar también las lecturas de presión con índice ordenado por valor
+
+    /**
+     * @brief Constructor
+     * @param capacidadMaxima Últimas lecturas a conservar (0 = sin límite)
+     * @param ventana Antigüedad máxima en segundos (0 = sin límite)
+     */
+    explicit PoliticaRetencion(int capacidadMaxima = 0, double ventana = 0.0)
+        : capacidad(capacidadMaxima), ventanaSegundos(ventana), serieTemporal(false), horizonteSegundos(0.0), comprimido(false),
+          indexado(false) {}
+
+    /**
+     * @brief Indica si los sensores usan un historial circular
+     */
+    bool acotada() const { return capacidad > 0 || ventanaSegundos > 0.0; }
+
+    /**
+     * @brief Capacidad del historial circular
+     */
+    int capacidadEfectiva() const {
+        if (capacidad > 0) return capacidad;
+        return CAPACIDAD_POR_VENTANA;
+    }
+
+    /**
+     * @brief Memoria que reserva el historial de un sensor acotado
+     * @param tamanioValor sizeof del tipo de lectura
+     * @return Bytes por sensor (0 si la política no está acotada)
+     */
+    std::size_t bytesPorSensor(std::size_t tamanioValor) const {
+        if (!acotada()) return 0;
+        return static_cast<std::size_t>(capacidadEfectiva()) *
+               (tamanioValor + (ventanaSegundos > 0.0 ? sizeof(long long) : 0));
+    }
+};
+
+/**
+ * @brief Crea un sensor de temperatura con el historial de la política
+ * @tparam Almacen ListaGeneral o un RegistroSensores que admita los tipos de la política
+ * @param almacen Contenedor dueño del sensor
+ * @param nombre Nombre del sensor
+ * @param politica Retención de lecturas
+ * @return Sensor nuevo, ya agregado al almacén
+ */
+template <typename Almacen>
+SensorBase& crearSensorTemperaturaEn(Almacen& almacen, const char* nombre, const PoliticaRetencion& politica) {
+    if (politica.comprimido) {
+        return almacen.template crear<SensorTemperaturaComprimido>(nombre, politica.serieTemporal);
+    }
+    if (politica.serieTemporal) {
+        return almacen.template crear<SensorTemperaturaTemporal>(nombre, politica.horizonteSegundos);
+    }
+    if (politica.acotada()) {
+        return almacen.template crear<SensorTemperaturaCircular>(nombre, politica.capacidadEfectiva(), politica.ventanaSegundos);
+    }
+    // Sin límite, con o sin indexado: quitar el mínimo en O(log n)
+    return almacen.template crear<SensorTemperaturaIndexado>(nombre);
+}
+
+/**
+ * @brief Crea un sensor de presión con el historial de la política
+ * @tparam Almacen ListaGeneral o un RegistroSensores que admita los tipos de la política
+ * @param almacen Contenedor dueño del sensor
+ * @param nombre Nombre del sensor
+ * @param politica Retención de lecturas
+ * @return Sensor nuevo, ya agregado al almacén
+ */
+template <typename Almacen>
+SensorBase& crearSensorPresionEn(Almacen& almacen, const char* nombre, const PoliticaRetencion& politica) {
+    if (politica.comprimido) {
+        return almacen.template crear<SensorPresionComprimido>(nombre, politica.serieTemporal);
+    }
+    if (politica.serieTemporal) {
+        return almacen.template crear<SensorPresionTemporal>(nombre, politica.horizonteSegundos);
+    }
+    if (politica.indexado) {
+        return almacen.template crear<SensorPresionIndexado>(nombre);
+    }
+    if (politica.acotada()) {
+        return almacen.template crear<SensorPresionCircular>(nombre, politica.capacidadEfectiva(), politica.ventanaSegundos);
+    }
+    return almacen.template crear<SensorPresion>(nombre);
+}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef POOLTRABAJO_H
+#define POOLTRABAJO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file PoolTrabajo.h
+ * @brief Hilos persistentes que reparten un rango de índices con robo de trabajo
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class PoolTrabajo
+ * @brief Ejecuta f(i) para i en [0, n) en varios hilos, robando trabajo entre ellos
+ *
+ * Cada participante (los hilos del pool y el que llama) recibe un tramo
+ * contiguo de índices y los toma de uno en uno desde el inicio. Cuando
+ * su tramo se agota, roba la mitad final del tramo de otro participante.
+ * Así los índices caros (sensores con historiales grandes) no dejan
+ * hilos ociosos, y el costo de coordinación es un mutex sin contención
+ * por índice.
+ *
+ * Los hilos se crean una vez y esperan trabajo en una variable de
+ * condición. paraCadaIndice() no es reentrante: lo llama un solo hilo a
+ * la vez, y f no debe lanzar excepciones.
+ */
+class PoolTrabajo {
+    private:
+        /**
+         * @struct Tramo
+         * @brief Índices pendientes de un participante, [desde, hasta)
+         */
+        struct Tramo {
+            std::mutex candado;  ///< Protege desde y hasta (el dueño y los ladrones)
+            std::size_t desde;   ///< Siguiente índice del dueño
+            std::size_t hasta;   ///< Fin del tramo (los ladrones lo recortan)
+            Tramo() : desde(0), hasta(0) {}
+        };
+
+        std::vector<std::thread> hilos;               ///< Hilos del pool (participantes 1..n)
+        std::vector<std::unique_ptr<Tramo> > tramos;  ///< Un tramo por participante; el 0 es el que llama
+        std::mutex candado;                           ///< Protege tarea, generacion, pendientes y salir
+        std::condition_variable hayTrabajo;           ///< Despierta a los hilos con una tarea nueva
+        std::condition_variable terminaron;           ///< Avisa al que llama que los hilos acabaron
+        const std::function<void(std::size_t)>* tarea; ///< Función de la ronda en curso
+        unsigned long generacion;                     ///< Número de ronda
+        int pendientes;                               ///< Hilos que no han terminado la ronda
+        bool salir;                                   ///< Solicitud de paro
+        std::atomic<long> robos;                      ///< Tramos robados desde la construcción
+
+        PoolTrabajo(const PoolTrabajo&);            ///< No copiable
+        PoolTrabajo& operator=(const PoolTrabajo&); ///< No asignable
+
+        /**
+         * @brief Toma el siguiente índice del tramo propio
+         * @return true si había uno
+         */
+        bool tomarPropio(std::size_t participante, std::size_t& indice) {
+            Tramo& tramo = *tramos[participante];
+            std::lock_guard<std::mutex> guarda(tramo.candado);
+            if (tramo.desde >= tramo.hasta) return false;
+            indice = tramo.desde++;
+            return true;
+        }
+
+        /**
+         * @brief Roba la mitad final del tramo de otro participante
+         * @return true si el tramo propio quedó con índices
+         */
+        bool robar(std::size_t participante) {
+            std::size_t total = tramos.size();
+            for (std::size_t k = 1; k < total; k++) {
+                Tramo& victima = *tramos[(participante + k) % total];
+                std::size_t desde, hasta;
+                {
+                    std::lock_guard<std::mutex> guarda(victima.candado);
+                    if (victima.desde >= victima.hasta) continue;
+                    std::size_t mitad = (victima.hasta - victima.desde + 1) / 2;
+                    hasta = victima.hasta;
+                    desde = hasta - mitad;
+                    victima.hasta = desde;
+                }
+                Tramo& propio = *tramos[participante];
+                std::lock_guard<std::mutex> guarda(propio.candado);
+                propio.desde = desde;
+                propio.hasta = hasta;
+                robos.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Procesa índices propios y robados hasta que no quede ninguno
+         */
+        void trabajar(std::size_t participante, const std::function<void(std::size_t)>& f) {
+            std::size_t indice;
+            while (true) {
+                if (tomarPropio(participante, indice)) {
+                    f(indice);
+                } else if (!robar(participante)) {
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief Cuerpo de cada hilo del pool
+         */
+        void esperarRondas(std::size_t participante) {
+            unsigned long vista = 0;
+            while (true) {
+                const std::function<void(std::size_t)>* f;
+                {
+                    std::unique_lock<std::mutex> guarda(candado);
+                    hayTrabajo.wait(guarda, [this, vista] { return salir || generacion != vista; });
+                    if (salir) return;
+                    vista = generacion;
+                    f = tarea;
+                }
+                trabajar(participante, *f);
+                std::lock_guard<std::mutex> guarda(candado);
+                if (--pendientes == 0) terminaron.notify_one();
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param participantes Hilos que trabajan en cada ronda, contando al
+         *        que llama (0 = std::thread::hardware_concurrency())
+         */
+        explicit PoolTrabajo(unsigned participantes = 0)
+            : tarea(nullptr), generacion(0), pendientes(0), salir(false), robos(0) {
+            if (participantes == 0) participantes = std::thread::hardware_concurrency();
+            if (participantes == 0) participantes = 1;
+            for (unsigned i = 0; i < participantes; i++) tramos.push_back(std::unique_ptr<Tramo>(new Tramo()));
+            for (unsigned i = 1; i < participantes; i++) hilos.push_back(std::thread(&PoolTrabajo::esperarRondas, this, i));
+        }
+
+        /**
+         * @brief Destructor, detiene los hilos
+         */
+        ~PoolTrabajo() {
+            {
+                std::lock_guard<std::mutex> guarda(candado);
+                salir = true;
+            }
+            hayTrabajo.notify_all();
+            for (std::size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+        }
+
+        /**
+         * @brief Ejecuta f(i) para cada i en [0, n) y espera a que terminen todos
+         * @param n Número de índices
+         * @param f Función a aplicar; se llama desde varios hilos a la vez
+         * @post f se llamó exactamente una vez por índice
+         */
+        void paraCadaIndice(std::size_t n, const std::function<void(std::size_t)>& f) {
+            std::size_t total = tramos.size();
+            for (std::size_t p = 0; p < total; p++) {
+                std::lock_guard<std::mutex> guarda(tramos[p]->candado);
+                tramos[p]->desde = n * p / total;
+                tramos[p]->hasta = n * (p + 1) / total;
+            }
+            if (!hilos.empty()) {
+                std::lock_guard<std::mutex> guarda(candado);
+                tarea = &f;
+                pendientes = static_cast<int>(hilos.size());
+                generacion++;
+            }
+            hayTrabajo.notify_all();
+            trabajar(0, f);
+            std::unique_lock<std::mutex> guarda(candado);
+            terminaron.wait(guarda, [this] { return pendientes == 0; });
+        }
+
+        /**
+         * @brief Hilos que trabajan en cada ronda, contando al que llama
+         */
+        std::size_t obtenerParticipantes() const { return tramos.size(); }
+
+        /**
+         * @brief Tramos robados entre participantes desde la construcción
+         */
+        long obtenerRobos() const { return robos.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef PROTOCOLOESP32_H
+#define PROTOCOLOESP32_H
+
+#include "LectorLineas.h"
+
+/**
+ * @file ProtocoloESP32.h
+ * @brief Interpretación de las líneas CSV que envía el ESP32
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * El firmware envía líneas de la forma TEMP,T-001,23.40 y PRES,P-001,97.
+ */
+
+/**
+ * @enum TipoLectura
+ * @brief Tipo de sensor indicado por el prefijo de la línea
+ */
+enum TipoLectura {
+    LECTURA_TEMPERATURA, ///< Prefijo TEMP,
+    LECTURA_PRESION      ///< Prefijo PRES,
+};
+
+/**
+ * @enum ResultadoParseo
+ * @brief Resultado de interpretar una línea
+ */
+enum ResultadoParseo {
+    PARSEO_OK,           ///< Lectura válida
+    PARSEO_IGNORADA,     ///< La línea no es una lectura (prefijo desconocido)
+    PARSEO_ERROR_VALOR   ///< Prefijo válido pero el valor no es numérico
+};
+
+/**
+ * @struct LecturaESP32
+ * @brief Campos de una línea de lectura; las vistas apuntan a la línea original
+ */
+struct LecturaESP32 {
+    TipoLectura tipo;        ///< Tipo de sensor
+    VistaCadena id;          ///< Campo intermedio (identificador del sensor), puede estar vacío
+    VistaCadena valorTexto;  ///< Campo del valor tal como llegó
+    float temperatura;       ///< Valor si tipo == LECTURA_TEMPERATURA
+    int presion;             ///< Valor si tipo == LECTURA_PRESION
+};
+
+/**
+ * @brief Interpreta una línea del ESP32 sin asignar memoria
+ * @param linea Línea sin salto de línea final
+ * @param lectura Campos extraídos
+ * @return PARSEO_OK, PARSEO_IGNORADA o PARSEO_ERROR_VALOR
+ *
+ * Despacha por los primeros 5 caracteres; el valor es lo que sigue a la
+ * última coma y el identificador lo que queda entre el prefijo y esa coma.
+ */
+inline ResultadoParseo parsearLineaESP32(VistaCadena linea, LecturaESP32& lectura) {
+    if (linea.longitud < 5 || linea.datos[4] != ',') return PARSEO_IGNORADA;
+    if (std::memcmp(linea.datos, "TEMP", 4) == 0) {
+        lectura.tipo = LECTURA_TEMPERATURA;
+    } else if (std::memcmp(linea.datos, "PRES", 4) == 0) {
+        lectura.tipo = LECTURA_PRESION;
+    } else {
+        return PARSEO_IGNORADA;
+    }
+
+    std::size_t ultimaComa = linea.longitud - 1;
+    while (linea.datos[ultimaComa] != ',') ultimaComa--;
+
+    lectura.id = ultimaComa > 4 ? linea.subvista(5, ultimaComa - 5) : linea.subvista(5, 0);
+    lectura.valorTexto = linea.subvista(ultimaComa + 1, linea.longitud);
+
+    if (lectura.tipo == LECTURA_TEMPERATURA) {
+        return parsearFlotante(lectura.valorTexto, lectura.temperatura) ? PARSEO_OK : PARSEO_ERROR_VALOR;
+    }
+    return parsearEntero(lectura.valorTexto, lectura.presion) ? PARSEO_OK : PARSEO_ERROR_VALOR;
+}
+
+#endif
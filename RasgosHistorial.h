@@ -0,0 +1,102 @@
+#ifndef RASGOSHISTORIAL_H
+#define RASGOSHISTORIAL_H
+
+/**
+ * @file RasgosHistorial.h
+ * @brief Comportamiento de inserción de cada contenedor de historial
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @struct RasgosHistorial
+ * @brief Describe si insertar en un historial puede desalojar lecturas
+ * @tparam Historial Contenedor de lecturas (ListaSensor, HistorialCircular, ...)
+ *
+ * Por defecto el historial crece sin límite: insertar nunca desaloja y
+ * alDesalojar no se llama. Los historiales acotados se especializan para
+ * informar cada lectura desalojada y que el sensor ajuste sus estadísticas.
+ *
+ * monticuloMinimos indica si el sensor puede llevar un montículo con las
+ * mismas lecturas que el historial para encontrar el mínimo en O(log n).
+ * No sirve si el historial desaloja (el montículo crecería con valores ya
+ * desalojados) ni si el historial comprime sus lecturas (el montículo
+ * ocuparía más que ellas); en esos casos el mínimo se busca recorriéndolo.
+ * Si eso depende de cómo se construyó el historial, el sensor lo consulta
+ * con monticuloMinimosEn().
+ */
+template <typename Historial>
+struct RasgosHistorial {
+    static const bool desaloja = false; ///< true si insertar puede quitar lecturas
+    static const bool monticuloMinimos = true; ///< true si el sensor lleva un montículo de mínimos
+
+    /**
+     * @brief Inserta una lectura
+     * @param historial Contenedor destino
+     * @param valor Lectura a insertar
+     * @param marcaNs Instante de la lectura (0 = instante actual); se
+     *        ignora si el historial no guarda marcas de tiempo
+     * @param alDesalojar Función llamada con cada lectura desalojada
+     */
+    template <typename F>
+    static void insertar(Historial& historial, typename Historial::TipoValor valor, long long marcaNs, F alDesalojar) {
+        (void)marcaNs;
+        (void)alDesalojar;
+        historial.insertar(valor);
+    }
+
+    /**
+     * @brief Desaloja las lecturas vencidas antes de una consulta
+     * @param historial Contenedor a revisar
+     * @param alDesalojar Función llamada con cada lectura desalojada
+     *
+     * Solo los historiales con ventana de tiempo desalojan sin insertar;
+     * por defecto no hace nada.
+     */
+    template <typename F>
+    static void expirar(Historial& historial, F alDesalojar) {
+        (void)historial;
+        (void)alDesalojar;
+    }
+};
+
+/**
+ * @brief Detalles propios del historial para mostrarInfo (sin efecto por
+ *        defecto; SerieTemporal y HistorialComprimido tienen su sobrecarga)
+ */
+template <typename Historial>
+inline void mostrarDetalleHistorial(const Historial&) {}
+
+/**
+ * @brief Indica si el sensor lleva el montículo de mínimos con este historial
+ * @return RasgosHistorial<Historial>::monticuloMinimos por defecto;
+ *         SerieTemporal tiene su sobrecarga porque solo desaloja lecturas
+ *         si se creó con horizonte
+ */
+template <typename Historial>
+inline bool monticuloMinimosEn(const Historial&) { return RasgosHistorial<Historial>::monticuloMinimos; }
+
+/**
+ * @brief Indica si el historial desaloja lecturas con el paso del tiempo,
+ *        aunque no se inserte nada (por defecto no; HistorialCircular con
+ *        ventana tiene su sobrecarga)
+ */
+template <typename Historial>
+inline bool expiraPorTiempo(const Historial&) { return false; }
+
+/**
+ * @brief Mínimo del historial si lo conoce sin recorrerse (por defecto no;
+ *        HistorialIndexado tiene su sobrecarga)
+ * @return false si el mínimo debe buscarse recorriendo el historial
+ */
+template <typename Historial>
+inline bool minimoIndexado(const Historial&, typename Historial::TipoValor&) { return false; }
+
+/**
+ * @brief Deja de leer de un archivo proyectado, copiando lo que haga falta
+ *        (sin efecto por defecto; HistorialInstantanea tiene su sobrecarga)
+ */
+template <typename Historial>
+inline void soltarArchivoDe(Historial&) {}
+
+#endif
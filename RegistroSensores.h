@@ -0,0 +1,292 @@
+#ifndef REGISTROSENSORES_H
+#define REGISTROSENSORES_H
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SensorBase.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "IndiceHash.h"
+#include "Bitacora.h"
+
+/**
+ * @file RegistroSensores.h
+ * @brief Registro de sensores separado por tipo concreto, con lazos sin llamadas virtuales
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class ParticionSensores
+ * @brief Sensores de un solo tipo concreto guardados por valor en losas contiguas
+ * @tparam Sensor Tipo concreto (SensorTemperatura, SensorPresionCircular, ...)
+ *
+ * Cada losa guarda SENSORES_POR_LOSA sensores seguidos, así que recorrer
+ * la partición es avanzar por arreglos en lugar de saltar de nodo en
+ * nodo. Los sensores no se mueven al crecer (se agregan losas nuevas),
+ * de modo que los punteros que se entregan siguen siendo válidos hasta
+ * destruir la partición. Como el tipo es conocido, los lazos llaman a
+ * Sensor::procesarLectura directamente y el compilador puede expandirla.
+ */
+template <typename Sensor>
+class ParticionSensores {
+    static_assert(std::is_base_of<SensorBase, Sensor>::value, "Sensor debe derivar de SensorBase");
+
+    public:
+        static const std::size_t SENSORES_POR_LOSA = 64; ///< Sensores por bloque contiguo
+
+    private:
+        std::vector<Sensor*> losas;  ///< Bloques de memoria sin construir de SENSORES_POR_LOSA sensores
+        std::size_t tamanio;         ///< Sensores construidos, en orden de creación
+        IndiceHash<Sensor*> indice;  ///< Nombre -> sensor de este tipo
+
+        ParticionSensores(const ParticionSensores&);            ///< No copiable
+        ParticionSensores& operator=(const ParticionSensores&); ///< No asignable
+
+    public:
+        /**
+         * @brief Constructor, partición vacía
+         */
+        ParticionSensores() : tamanio(0) {}
+
+        /**
+         * @brief Destructor, destruye los sensores en orden de creación y libera las losas
+         */
+        ~ParticionSensores() {
+            for (std::size_t i = 0; i < tamanio; i++) {
+                Sensor& sensor = losas[i / SENSORES_POR_LOSA][i % SENSORES_POR_LOSA];
+                IOT_INFO("Liberando sensor: " << sensor.obtenerNombre());
+                sensor.~Sensor();
+            }
+            for (std::size_t i = 0; i < losas.size(); i++) {
+                ::operator delete(losas[i]);
+            }
+        }
+
+        /**
+         * @brief Construye un sensor al final de la partición
+         * @param nombre Nombre del sensor
+         * @param args Argumentos restantes del constructor (capacidad, ventana, ...)
+         * @return Referencia al sensor, válida mientras viva la partición
+         */
+        template <typename... Args>
+        Sensor& crear(const char* nombre, Args&&... args) {
+            if (tamanio % SENSORES_POR_LOSA == 0) {
+                losas.push_back(static_cast<Sensor*>(::operator new(sizeof(Sensor) * SENSORES_POR_LOSA)));
+            }
+            Sensor* sensor = new (losas.back() + tamanio % SENSORES_POR_LOSA) Sensor(nombre, std::forward<Args>(args)...);
+            tamanio++;
+            indice.insertar(sensor->obtenerNombre(), sensor->obtenerHash(), sensor);
+            return *sensor;
+        }
+
+        /**
+         * @brief Busca un sensor de este tipo por nombre, sin dynamic_cast
+         * @param nombre Nombre del sensor
+         * @return Sensor con ese nombre, o nullptr si no hay uno de este tipo
+         */
+        Sensor* buscar(const char* nombre) const {
+            Sensor* const* encontrado = indice.buscar(nombre);
+            return encontrado != nullptr ? *encontrado : nullptr;
+        }
+
+        /**
+         * @brief Recorre los sensores por losas contiguas
+         * @param f Función invocada como f(Sensor* sensores, std::size_t cantidad)
+         */
+        template <typename F>
+        void paraCadaLosa(F f) {
+            for (std::size_t i = 0; i < losas.size(); i++) {
+                std::size_t restantes = tamanio - i * SENSORES_POR_LOSA;
+                f(losas[i], restantes < SENSORES_POR_LOSA ? restantes : static_cast<std::size_t>(SENSORES_POR_LOSA));
+            }
+        }
+
+        /**
+         * @brief Aplica f a cada sensor, en orden de creación
+         * @param f Función invocada como f(Sensor&)
+         */
+        template <typename F>
+        void paraCada(F f) {
+            paraCadaLosa([&f](Sensor* sensores, std::size_t cantidad) {
+                for (std::size_t i = 0; i < cantidad; i++) f(sensores[i]);
+            });
+        }
+
+        /**
+         * @brief Procesa todos los sensores de la partición sin llamadas virtuales
+         * @param salida Stream donde se describe el procesamiento
+         */
+        void procesarTodos(std::ostream& salida) {
+            paraCada([&salida](Sensor& sensor) { sensor.Sensor::procesarLectura(salida); });
+        }
+
+        /**
+         * @brief Obtiene la cantidad de sensores de este tipo
+         */
+        std::size_t obtenerTamanio() const { return tamanio; }
+};
+
+/**
+ * @class RegistroSensores
+ * @brief Registro con una partición contigua por cada tipo de sensor de la lista de tipos
+ * @tparam Sensores Tipos concretos que admite el registro, cada uno una sola vez
+ *
+ * Los tipos se fijan en compilación: el registro hereda una
+ * ParticionSensores por cada uno, y procesarTodos() recorre las
+ * particiones en el orden de la lista de tipos con un lazo por tipo, sin
+ * vtable ni saltos de puntero entre sensores.
+ *
+ * Para el código que trabaja con SensorBase conserva la interfaz de
+ * ListaGeneral: buscarSensor, mostrarTodos, obtenerTamanio y begin()/end()
+ * sobre los punteros en orden de creación. La diferencia visible es que
+ * procesarTodos() procesa por tipo (todos los de temperatura, después
+ * todos los de presión) y no en orden de creación.
+ */
+template <typename... Sensores>
+class RegistroSensores : private ParticionSensores<Sensores>... {
+    private:
+        std::vector<SensorBase*> orden;  ///< Todos los sensores, en orden de creación
+        IndiceHash<SensorBase*> indice;  ///< Nombre -> sensor de cualquier tipo
+
+        RegistroSensores(const RegistroSensores&);            ///< No copiable
+        RegistroSensores& operator=(const RegistroSensores&); ///< No asignable
+
+    public:
+        typedef std::vector<SensorBase*>::const_iterator iterator;       ///< Iterador sobre los sensores
+        typedef std::vector<SensorBase*>::const_iterator const_iterator; ///< Igual que iterator, como en ListaGeneral
+        typedef SensorBase* value_type;                                  ///< Puntero al sensor (nombre de la STL)
+
+        /**
+         * @brief Constructor, registro vacío
+         */
+        RegistroSensores() {}
+
+        /**
+         * @brief Crea un sensor en la partición de su tipo
+         * @tparam Sensor Uno de los tipos de la lista del registro
+         * @param nombre Nombre del sensor
+         * @param args Argumentos restantes del constructor
+         * @return Referencia tipada al sensor, válida mientras viva el registro
+         */
+        template <typename Sensor, typename... Args>
+        Sensor& crear(const char* nombre, Args&&... args) {
+            Sensor& sensor = ParticionSensores<Sensor>::crear(nombre, std::forward<Args>(args)...);
+            orden.push_back(&sensor);
+            indice.insertar(sensor.obtenerNombre(), sensor.obtenerHash(), &sensor);
+            IOT_INFO("Sensor '" << sensor.obtenerNombre() << "' agregado al registro");
+            return sensor;
+        }
+
+        /**
+         * @brief Partición de un tipo, para recorrerla con lazos propios
+         * @tparam Sensor Uno de los tipos de la lista del registro
+         */
+        template <typename Sensor>
+        ParticionSensores<Sensor>& particion() { return *this; }
+
+        /**
+         * @brief Busca un sensor de un tipo concreto, sin dynamic_cast
+         * @tparam Sensor Uno de los tipos de la lista del registro
+         * @param nombre Nombre del sensor
+         * @return Sensor tipado, o nullptr si no existe uno de ese tipo
+         */
+        template <typename Sensor>
+        Sensor* buscar(const char* nombre) const {
+            return ParticionSensores<Sensor>::buscar(nombre);
+        }
+
+        /**
+         * @brief Busca un sensor de cualquier tipo por su nombre
+         * @param nombre Nombre del sensor
+         * @return Puntero al sensor, o nullptr si no existe (con nombres repetidos, el primero)
+         */
+        SensorBase* buscarSensor(const char* nombre) const {
+            SensorBase* const* encontrado = indice.buscar(nombre);
+            return encontrado != nullptr ? *encontrado : nullptr;
+        }
+
+        /**
+         * @brief Busca un sensor por un nombre que no termina en '\0'
+         * @param nombre Caracteres del nombre
+         * @param longitud Número de caracteres
+         * @param hash Hash del nombre (hashCadena)
+         * @return Puntero al sensor, o nullptr si no existe
+         */
+        SensorBase* buscarSensor(const char* nombre, std::size_t longitud, unsigned int hash) const {
+            SensorBase* const* encontrado = indice.buscar(nombre, longitud, hash);
+            return encontrado != nullptr ? *encontrado : nullptr;
+        }
+
+        /**
+         * @brief Procesa todos los sensores, un lazo por tipo
+         * @post Llama a procesarLectura() de cada sensor, agrupados por tipo
+         *       en el orden de la lista de tipos
+         */
+        void procesarTodos() {
+            std::cout << "\nProcesando todos los sensores..." << std::endl;
+            // La lista de inicialización garantiza el orden de izquierda a derecha
+            int secuencia[] = { 0, (ParticionSensores<Sensores>::procesarTodos(std::cout), 0)... };
+            (void)secuencia;
+        }
+
+        /**
+         * @brief Muestra la información de todos los sensores, en orden de creación
+         */
+        void mostrarTodos() const {
+            std::cout << "\n--- LISTA GENERAL DE SENSORES ---" << std::endl;
+            for (SensorBase* sensor : orden) {
+                sensor->mostrarInfo();
+            }
+        }
+
+        /**
+         * @brief Aplica f a cada sensor de un tipo, sin llamadas virtuales
+         * @tparam Sensor Uno de los tipos de la lista del registro
+         * @param f Función invocada como f(Sensor&)
+         */
+        template <typename Sensor, typename F>
+        void paraCadaSensor(F f) {
+            ParticionSensores<Sensor>::paraCada(f);
+        }
+
+        /**
+         * @brief Cantidad de sensores de un tipo
+         * @tparam Sensor Uno de los tipos de la lista del registro
+         */
+        template <typename Sensor>
+        std::size_t obtenerTamanioDe() const { return ParticionSensores<Sensor>::obtenerTamanio(); }
+
+        /**
+         * @brief Obtiene la cantidad de sensores registrados
+         * @return Número de sensores de todos los tipos
+         */
+        int obtenerTamanio() const { return static_cast<int>(orden.size()); }
+
+        const_iterator begin() const { return orden.begin(); } ///< Primer sensor creado
+        const_iterator end() const { return orden.end(); }     ///< Fin del registro
+};
+
+/**
+ * @brief Registro de los dos sensores con historial en lista enlazada
+ */
+typedef RegistroSensores<SensorTemperatura, SensorPresion> RegistroSensoresLista;
+
+/**
+ * @brief Registro con todos los tipos de sensor del proyecto
+ *
+ * Admite lo que crean EnrutadorESP32 (con cualquier PoliticaRetencion) y
+ * cargarInstantanea, así que puede ocupar el lugar de una ListaGeneral
+ * en la ingesta, el diario y las instantáneas.
+ */
+typedef RegistroSensores<SensorTemperatura, SensorTemperaturaDesenrollado, SensorTemperaturaCircular,
+                         SensorTemperaturaTemporal, SensorTemperaturaComprimido, SensorTemperaturaInstantanea,
+                         SensorTemperaturaIndexado, SensorPresion, SensorPresionDesenrollado, SensorPresionCircular,
+                         SensorPresionTemporal, SensorPresionComprimido, SensorPresionInstantanea, SensorPresionIndexado>
+    RegistroSensoresCompleto;
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef RELOJMONOTONICO_H
+#define RELOJMONOTONICO_H
+
+#include <chrono>
+
+/**
+ * @file RelojMonotonico.h
+ * @brief Reloj común de las marcas de tiempo de las lecturas
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Instante actual del reloj monotónico en nanosegundos
+ * @return Nanosegundos desde una época arbitraria
+ */
+inline long long instanteActualNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
@@ -2,6 +2,9 @@
 #define SENSORBASE_H
 
 #include <iostream>
+#include "EstadisticasLecturas.h"
+#include "IndiceHash.h"
+#include "Bitacora.h"
 
 /**
  * @file SensorBase.h
@@ -21,6 +24,17 @@
 class SensorBase {
     protected:
         char nombre[50]; ///< Nombre identificador del sensor (máximo 49 caracteres)
+        unsigned int hashNombre; ///< Hash del nombre, precalculado para los índices
+        mutable EstadisticasLecturas estadisticas; ///< Estadísticas incrementales de las lecturas (mutable: ver expirarVencidas)
+        bool expiraAlConsultar; ///< true si el historial vence lecturas con el tiempo (lo fija la clase derivada)
+
+        /**
+         * @brief Desaloja del historial las lecturas que ya vencieron
+         *
+         * Sin efecto por defecto; los sensores cuyo historial tiene ventana
+         * de tiempo lo redefinen y encienden expiraAlConsultar.
+         */
+        virtual void expirarVencidas() const {}
         
     public:
         /**
@@ -28,15 +42,17 @@ class SensorBase {
          * @param nombreSensor Cadena de caracteres con el nombre del sensor
          * 
          * Copia el nombre del sensor carácter por carácter, asegurando
-         * no exceder el tamaño del arreglo (49 caracteres + terminador nulo)
+         * no exceder el tamaño del arreglo (49 caracteres + terminador nulo),
+         * y precalcula su hash
          */
-        SensorBase(const char* nombreSensor) {
+        SensorBase(const char* nombreSensor) : expiraAlConsultar(false) {
             int i = 0;
             while (nombreSensor[i] != '\0' && i < 49) {
                 nombre[i] = nombreSensor[i];
                 i++;
             } 
             nombre[i] = '\0';
+            hashNombre = hashCadena(nombre, i);
         }
         
         /**
@@ -46,14 +62,20 @@ class SensorBase {
          * polimórfica correcta de objetos derivados
          */
         virtual ~SensorBase() {
-            std::cout << "Sensor '" << obtenerNombre() << "' destruido" << std::endl;
+            IOT_INFO("Sensor '" << obtenerNombre() << "' destruido");
         }
         
         /**
          * @brief Procesa las lecturas almacenadas del sensor
+         * @param salida Stream donde se describe el procesamiento
          * @pure Método virtual puro - debe ser implementado por clases derivadas
          */
-        virtual void procesarLectura() = 0;
+        virtual void procesarLectura(std::ostream& salida) = 0;
+
+        /**
+         * @brief Procesa las lecturas almacenadas y lo describe en std::cout
+         */
+        void procesarLectura() { procesarLectura(std::cout); }
         
         /**
          * @brief Muestra la información del sensor
@@ -66,6 +88,41 @@ class SensorBase {
          * @return Puntero constante al nombre del sensor
          */
         const char* obtenerNombre() const { return nombre; }
+
+        /**
+         * @brief Obtiene el hash precalculado del nombre
+         * @return Hash FNV-1a del nombre
+         */
+        unsigned int obtenerHash() const { return hashNombre; }
+
+        /**
+         * @brief Obtiene las estadísticas incrementales del sensor
+         * @return Referencia constante al bloque de estadísticas
+         *
+         * Las clases derivadas lo actualizan en O(1) al registrar lecturas.
+         * Si el historial tiene ventana de tiempo, antes se quitan las
+         * lecturas vencidas.
+         */
+        const EstadisticasLecturas& obtenerEstadisticas() const {
+            if (expiraAlConsultar) expirarVencidas();
+            return estadisticas;
+        }
+
+        /**
+         * @brief Reemplaza las estadísticas sin recorrer las lecturas
+         * @param guardadas Estadísticas de las mismas lecturas que tiene el historial
+         *
+         * Lo usa la carga de instantáneas, que no lee las lecturas al arrancar.
+         */
+        void restaurarEstadisticas(const EstadisticasLecturas& guardadas) { estadisticas = guardadas; }
+
+        /**
+         * @brief Deja de leer lecturas de un archivo proyectado
+         *
+         * Sin efecto por defecto; los sensores cargados de una instantánea
+         * copian sus lecturas para que el archivo pueda reemplazarse.
+         */
+        virtual void soltarArchivo() {}
 };
 
 #endif
\ No newline at end of file
@@ -2,8 +2,16 @@
 #define SENSORPRESION_H
 
 #include <iostream>
+#include <utility>
 #include "SensorBase.h"
 #include "ListaSensor.h"
+#include "ListaSensorDesenrollada.h"
+#include "HistorialCircular.h"
+#include "SerieTemporal.h"
+#include "HistorialComprimido.h"
+#include "HistorialInstantanea.h"
+#include "HistorialIndexado.h"
+#include "Agregados.h"
 
 /**
  * @file SensorPresion.h
@@ -13,83 +21,255 @@
  */
 
 /**
- * @class SensorPresion
+ * @class SensorPresionT
  * @brief Sensor especializado para medir y procesar lecturas de presión
+ * @tparam Historial Contenedor de lecturas int (ListaSensor, ListaSensorDesenrollada, HistorialCircular, SerieTemporal, HistorialComprimido, HistorialInstantanea, HistorialIndexado, ...)
  * 
  * Esta clase hereda de SensorBase e implementa funcionalidad específica
  * para sensores de presión. Almacena lecturas en formato int y su
  * procesamiento calcula el promedio de todas las lecturas.
+ * El contenedor del historial se elige en tiempo de compilación.
  */
-class SensorPresion : public SensorBase {
+template <typename Historial>
+class SensorPresionT : public SensorBase {
     private:
-        ListaSensor<int> historial; ///< Lista enlazada con el historial de lecturas
+        mutable Historial historial; ///< Contenedor con el historial de lecturas (mutable: ver expirarVencidas)
+
+        /**
+         * @brief Quita del historial y de las estadísticas las lecturas fuera de la ventana de tiempo
+         *
+         * Se llama al comienzo de cada consulta: un sensor que dejó de
+         * reportar no debe seguir mostrando lecturas vencidas. Sin ventana
+         * no hace nada.
+         */
+        void expirarVencidas() const override {
+            RasgosHistorial<Historial>::expirar(historial, [this](int desalojado) {
+                estadisticas.quitar(desalojado);
+            });
+        }
+
+        /**
+         * @brief Estadísticas con mínimo y máximo recalculados si el historial desalojó un extremo
+         * @return Copia de las estadísticas lista para mostrar
+         */
+        EstadisticasLecturas estadisticasVigentes() const {
+            SensorPresionT::expirarVencidas();
+            EstadisticasLecturas vigentes = estadisticas;
+            if (!vigentes.extremosValidos && vigentes.cantidad > 0) {
+                bool primero = true;
+                historial.paraCadaBloque([&vigentes, &primero](const int* datos, int cantidad) {
+                    ExtremoIndice<int> minimo = Agregados::minimoConIndice(datos, cantidad);
+                    ExtremoIndice<int> maximo = Agregados::maximoConIndice(datos, cantidad);
+                    if (minimo.indice < 0) return;
+                    if (primero || minimo.valor < vigentes.minimo) vigentes.minimo = minimo.valor;
+                    if (primero || maximo.valor > vigentes.maximo) vigentes.maximo = maximo.valor;
+                    primero = false;
+                });
+                vigentes.extremosValidos = true;
+            }
+            return vigentes;
+        }
         
     public:
         /**
          * @brief Constructor del sensor de presión
          * @param nombreSensor Nombre identificador del sensor
-         * @post Crea un sensor de presión e imprime mensaje de log
+         * @param argsHistorial Argumentos para construir el historial (por
+         *        ejemplo capacidad y ventana de un HistorialCircular)
+         * @post Crea un sensor de presión y lo registra en la bitácora
          */
-        SensorPresion(const char* nombreSensor) : SensorBase(nombreSensor) {
-            std::cout << "Sensor de presión '" << obtenerNombre() << "' creado" << std::endl;
+        template <typename... ArgsHistorial>
+        SensorPresionT(const char* nombreSensor, ArgsHistorial&&... argsHistorial)
+            : SensorBase(nombreSensor), historial(std::forward<ArgsHistorial>(argsHistorial)...) {
+            expiraAlConsultar = expiraPorTiempo(historial);
+            IOT_INFO("Sensor de presión '" << obtenerNombre() << "' creado");
         }
 
         /**
          * @brief Destructor del sensor de presión
-         * @post Destruye el sensor e imprime mensaje de log
+         * @post Destruye el sensor y lo registra en la bitácora
          */
-        ~SensorPresion() {
-            std::cout << "Sensor de presión '" << obtenerNombre() << "' destruido" << std::endl;
+        ~SensorPresionT() {
+            IOT_INFO("Sensor de presión '" << obtenerNombre() << "' destruido");
         }
         
         /**
          * @brief Registra una nueva lectura de presión
          * @param valor Valor de presión a registrar
-         * @post Agrega la lectura al historial e imprime confirmación
+         * @post Agrega la lectura al historial, actualiza las estadísticas
+         *       en O(1) y registra el evento en la bitácora. Las lecturas
+         *       que el historial desaloje se quitan de las estadísticas.
          */
-        void registrarLectura(int valor) {
-            historial.insertar(valor);
-            std::cout << "Lectura registrada en sensor '" << obtenerNombre() << "': " << valor << std::endl;
+        void registrarLectura(int valor, long long marcaNs = 0) {
+            RasgosHistorial<Historial>::insertar(historial, valor, marcaNs, [this](int desalojado) {
+                estadisticas.quitar(desalojado);
+            });
+            estadisticas.agregar(valor);
+            IOT_DEPURACION("Lectura registrada en sensor '" << obtenerNombre() << "': " << valor);
         }
 
+        using SensorBase::procesarLectura; ///< procesarLectura() escribe en std::cout
+
         /**
          * @brief Procesa las lecturas del sensor de presión
+         * @param salida Stream donde se describe el procesamiento
          * @post Calcula e imprime el promedio de todas las lecturas
          * 
-         * Implementación específica del procesamiento para presión:
-         * suma todas las lecturas y calcula el promedio
+         * Implementación específica del procesamiento para presión: el
+         * promedio se obtiene de las estadísticas incrementales en O(1),
+         * sin recorrer el historial. Si el historial compactó lecturas, el
+         * promedio de todas las recibidas sale de los niveles de resumen.
          */
-        void procesarLectura() override {
-            std::cout << "\n[Procesando Sensor " << obtenerNombre() << " - Presión]" << std::endl;
+        void procesarLectura(std::ostream& salida) override {
+            salida << "\n[Procesando Sensor " << obtenerNombre() << " - Presión]" << std::endl;
+            SensorPresionT::expirarVencidas();
             
-            if (historial.obtenerTamanio() == 0) {
-                std::cout << "No hay lecturas para procesar." << std::endl;
+            if (estadisticas.cantidad == 0) {
+                salida << "No hay lecturas para procesar." << std::endl;
                 return;
             }
 
-            int suma = 0;
-            Nodo<int>* actual = historial.obtenerCabeza();
-            
-            while (actual != nullptr) {
-                suma += actual->dato;
-                actual = actual->sig;
+            float promedio = static_cast<float>(estadisticas.media);
+            salida << "Promedio de lecturas: " << promedio << std::endl;
+
+            ResumenVentana<int> recibidas;
+            if (resumenTotalRecibido(historial, recibidas) && recibidas.cantidad != estadisticas.cantidad) {
+                salida << "Promedio de las " << recibidas.cantidad << " lecturas recibidas (niveles): "
+                          << static_cast<float>(recibidas.media()) << std::endl;
             }
-            
-            float promedio = static_cast<float>(suma) / historial.obtenerTamanio();
-            std::cout << "Promedio de lecturas: " << promedio << std::endl;
         }
 
+        /**
+         * @brief Recalcula el promedio recorriendo todo el historial
+         * @return Promedio de las lecturas almacenadas (0 si no hay)
+         *
+         * Suma por bloques con los kernels de Agregados en un acumulador
+         * de 64 bits. Sirve para verificar las estadísticas incrementales.
+         */
+        double promedioHistorial() const {
+            SensorPresionT::expirarVencidas();
+            if (historial.obtenerTamanio() == 0) return 0.0;
+            long long suma = 0;
+            historial.paraCadaBloque([&suma](const int* datos, int cantidad) {
+                suma += Agregados::suma(datos, cantidad);
+            });
+            return static_cast<double>(suma) / historial.obtenerTamanio();
+        }
+
+        /**
+         * @brief Resume las lecturas con marca de tiempo en [t0, t1)
+         * @param t0 Inicio de la ventana en ns del reloj monotónico (incluido)
+         * @param t1 Fin de la ventana (excluido)
+         * @return Cantidad, suma, mínimo y máximo de la ventana
+         *
+         * Solo disponible si el historial guarda marcas (SerieTemporal).
+         */
+        ResumenVentana<int> resumenEntre(long long t0, long long t1) const {
+            return historial.resumenEntre(t0, t1);
+        }
+
+        /**
+         * @brief Cuenta las lecturas dentro de un rango cerrado
+         * @param desde Límite inferior (incluido)
+         * @param hasta Límite superior (incluido)
+         * @return Lecturas con desde <= valor <= hasta
+         *
+         * Solo disponible si el historial tiene índice ordenado
+         * (HistorialIndexado), que responde en O(log n).
+         */
+        int contarEntre(int desde, int hasta) const {
+            return historial.contarEntre(desde, hasta);
+        }
+
+        /**
+         * @brief Cuenta las lecturas mayores que un umbral
+         * @param umbral Valor de corte (excluido)
+         * @return Lecturas con valor > umbral
+         *
+         * Solo disponible si el historial tiene índice ordenado
+         * (HistorialIndexado), que responde en O(log n).
+         */
+        int contarMayoresQue(int umbral) const {
+            return historial.contarMayoresQue(umbral);
+        }
+
+        /**
+         * @brief Historial del sensor, para leer su configuración (capacidad, ventana, ...)
+         * @return Referencia constante, sin lecturas vencidas
+         */
+        const Historial& obtenerHistorial() const {
+            SensorPresionT::expirarVencidas();
+            return historial;
+        }
+
+        /**
+         * @brief Recorre las lecturas del historial por bloques, en orden de llegada
+         * @param f Función con firma f(const int* datos, int cantidad)
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            SensorPresionT::expirarVencidas();
+            historial.paraCadaBloque(f);
+        }
+
+        /**
+         * @brief Copia las lecturas que el historial lea de un archivo proyectado
+         */
+        void soltarArchivo() override { soltarArchivoDe(historial); }
+
         /**
          * @brief Muestra información detallada del sensor
          * @post Imprime tipo, nombre y cantidad de lecturas registradas
          */
         void mostrarInfo() const override {
+            SensorPresionT::expirarVencidas();
             std::cout << "\n=== INFORMACION DEL SENSOR ===" << std::endl;
             std::cout << "Tipo: Presión" << std::endl;
             std::cout << "Nombre: " << obtenerNombre() << std::endl;
             std::cout << "Cantidad de lecturas: " << historial.obtenerTamanio() << std::endl;
+            if (estadisticas.cantidad > 0) {
+                EstadisticasLecturas vigentes = estadisticasVigentes();
+                std::cout << "Mínimo: " << vigentes.minimo << "  Máximo: " << vigentes.maximo
+                          << "  Promedio: " << vigentes.media << std::endl;
+            }
+            mostrarDetalleHistorial(historial);
             std::cout << "===============================" << std::endl;
         }
 };
 
+/**
+ * @brief Sensor de presión con historial en lista enlazada simple
+ */
+typedef SensorPresionT<ListaSensor<int> > SensorPresion;
+
+/**
+ * @brief Sensor de presión con historial en lista desenrollada
+ */
+typedef SensorPresionT<ListaSensorDesenrollada<int> > SensorPresionDesenrollado;
+
+/**
+ * @brief Sensor de presión que conserva solo las últimas lecturas
+ */
+typedef SensorPresionT<HistorialCircular<int> > SensorPresionCircular;
+
+/**
+ * @brief Sensor de presión con marca de tiempo en cada lectura
+ */
+typedef SensorPresionT<SerieTemporal<int> > SensorPresionTemporal;
+
+/**
+ * @brief Sensor de presión con historial comprimido por bloques
+ */
+typedef SensorPresionT<HistorialComprimido<int> > SensorPresionComprimido;
+
+/**
+ * @brief Sensor de presión cargado de una instantánea proyectada en memoria
+ */
+typedef SensorPresionT<HistorialInstantanea<int> > SensorPresionInstantanea;
+
+/**
+ * @brief Sensor de presión con índice ordenado de sus lecturas
+ */
+typedef SensorPresionT<HistorialIndexado<int> > SensorPresionIndexado;
+
 #endif
\ No newline at end of file
@@ -2,8 +2,19 @@
 #define SENSORTEMPERATURA_H
 
 #include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
 #include "SensorBase.h"
 #include "ListaSensor.h"
+#include "ListaSensorDesenrollada.h"
+#include "HistorialCircular.h"
+#include "SerieTemporal.h"
+#include "HistorialComprimido.h"
+#include "HistorialInstantanea.h"
+#include "HistorialIndexado.h"
+#include "Agregados.h"
 
 /**
  * @file SensorTemperatura.h
@@ -13,86 +24,288 @@
  */
 
 /**
- * @class SensorTemperatura
+ * @class SensorTemperaturaT
  * @brief Sensor especializado para medir y procesar lecturas de temperatura
+ * @tparam Historial Contenedor de lecturas float (ListaSensor, ListaSensorDesenrollada, HistorialCircular, SerieTemporal, HistorialComprimido, HistorialInstantanea, HistorialIndexado, ...)
  * 
  * Esta clase hereda de SensorBase e implementa funcionalidad específica
  * para sensores de temperatura. Almacena lecturas en formato float y
  * su procesamiento consiste en encontrar y eliminar la lectura más baja.
+ * El contenedor del historial se elige en tiempo de compilación.
+ *
+ * Con HistorialIndexado buscar y quitar el mínimo son O(log n); por eso
+ * es el historial que PoliticaRetencion usa para los sensores sin límite.
+ * Con ListaSensor (y los demás historiales que conservan todo) el
+ * montículo da el mínimo en O(log n), pero quitarlo del historial sigue
+ * siendo un recorrido de eliminarValor, O(n). Si el historial desaloja
+ * lecturas o las comprime (monticuloMinimosEn() es false, por ejemplo un
+ * HistorialCircular o una SerieTemporal con horizonte) no se usa el
+ * montículo: el mínimo se busca recorriendo el historial.
  */
-class SensorTemperatura : public SensorBase {
+template <typename Historial>
+class SensorTemperaturaT : public SensorBase {
     private:
-        ListaSensor<float> historial; ///< Lista enlazada con el historial de lecturas
+        mutable Historial historial; ///< Contenedor con el historial de lecturas (mutable: ver expirarVencidas)
+        std::priority_queue<float, std::vector<float>, std::greater<float> > minimos; ///< Montículo de mínimos con las mismas lecturas que el historial
+        bool usaMonticulo; ///< monticuloMinimosEn(historial), fijo desde la construcción
+
+        /**
+         * @brief Quita del historial y de las estadísticas las lecturas fuera de la ventana de tiempo
+         *
+         * Se llama al comienzo de cada consulta: un sensor que dejó de
+         * reportar no debe seguir mostrando lecturas vencidas. Sin ventana
+         * no hace nada.
+         */
+        void expirarVencidas() const override {
+            RasgosHistorial<Historial>::expirar(historial, [this](float desalojado) {
+                estadisticas.quitar(desalojado);
+            });
+        }
+
+        /**
+         * @brief Estadísticas con mínimo y máximo recalculados si el historial desalojó un extremo
+         * @return Copia de las estadísticas lista para mostrar
+         */
+        EstadisticasLecturas estadisticasVigentes() const {
+            SensorTemperaturaT::expirarVencidas();
+            EstadisticasLecturas vigentes = estadisticas;
+            if (!vigentes.extremosValidos && vigentes.cantidad > 0) {
+                vigentes.minimo = minimoHistorial();
+                vigentes.maximo = -9999.9f;
+                historial.paraCadaBloque([&vigentes](const float* datos, int cantidad) {
+                    ExtremoIndice<float> maximo = Agregados::maximoConIndice(datos, cantidad);
+                    if (maximo.indice >= 0 && maximo.valor > vigentes.maximo) {
+                        vigentes.maximo = maximo.valor;
+                    }
+                });
+                vigentes.extremosValidos = true;
+            }
+            return vigentes;
+        }
         
     public:
         /**
          * @brief Constructor del sensor de temperatura
          * @param nombreSensor Nombre identificador del sensor
-         * @post Crea un sensor de temperatura e imprime mensaje de log
+         * @param argsHistorial Argumentos para construir el historial (por
+         *        ejemplo capacidad y ventana de un HistorialCircular)
+         * @post Crea un sensor de temperatura y lo registra en la bitácora
          */
-        SensorTemperatura(const char* nombreSensor) : SensorBase(nombreSensor) {
-            std::cout << "Sensor de temperatura '" << obtenerNombre() << "' creado" << std::endl;
+        template <typename... ArgsHistorial>
+        SensorTemperaturaT(const char* nombreSensor, ArgsHistorial&&... argsHistorial)
+            : SensorBase(nombreSensor), historial(std::forward<ArgsHistorial>(argsHistorial)...),
+              usaMonticulo(monticuloMinimosEn(historial)) {
+            expiraAlConsultar = expiraPorTiempo(historial);
+            IOT_INFO("Sensor de temperatura '" << obtenerNombre() << "' creado");
         }
         
         /**
          * @brief Destructor del sensor de temperatura
-         * @post Destruye el sensor e imprime mensaje de log
+         * @post Destruye el sensor y lo registra en la bitácora
          */
-        ~SensorTemperatura() {
-            std::cout << "Sensor de temperatura '" << obtenerNombre() << "' destruido" << std::endl;
+        ~SensorTemperaturaT() {
+            IOT_INFO("Sensor de temperatura '" << obtenerNombre() << "' destruido");
         }
         
         /**
          * @brief Registra una nueva lectura de temperatura
          * @param valor Valor de temperatura a registrar
-         * @post Agrega la lectura al historial e imprime confirmación
+         * @post Agrega la lectura al historial y al montículo de mínimos,
+         *       actualiza las estadísticas y registra el evento en la bitácora.
+         *       Las lecturas que el historial desaloje se quitan de las estadísticas.
          */
-        void registrarLectura(float valor) {
-            historial.insertar(valor);
-            std::cout << "Lectura registrada en sensor '" << obtenerNombre() << "': " << valor << std::endl;
+        void registrarLectura(float valor, long long marcaNs = 0) {
+            RasgosHistorial<Historial>::insertar(historial, valor, marcaNs, [this](float desalojado) {
+                estadisticas.quitar(desalojado);
+            });
+            if (usaMonticulo) {
+                minimos.push(valor);
+            }
+            estadisticas.agregar(valor);
+            IOT_DEPURACION("Lectura registrada en sensor '" << obtenerNombre() << "': " << valor);
         }
 
+        using SensorBase::procesarLectura; ///< procesarLectura() escribe en std::cout
+
         /**
          * @brief Procesa las lecturas del sensor de temperatura
+         * @param salida Stream donde se describe el procesamiento
          * @post Encuentra y elimina la lectura más baja del historial
          * 
-         * Implementación específica del procesamiento para temperatura:
-         * recorre el historial buscando el valor mínimo y lo elimina
+         * Implementación específica del procesamiento para temperatura.
+         * Con índice ordenado (HistorialIndexado) buscar y eliminar el
+         * mínimo es O(log n). Si no, el mínimo se toma del montículo en
+         * O(log n) o, sin montículo (historial que desaloja o comprime),
+         * recorriendo el historial; en ambos casos eliminarlo es una pasada
+         * de eliminarValor que termina en la primera coincidencia.
          */
-        void procesarLectura() override {
-            std::cout << "\n[Procesando Sensor " << obtenerNombre() << " - Temperatura]" << std::endl;
+        void procesarLectura(std::ostream& salida) override {
+            salida << "\n[Procesando Sensor " << obtenerNombre() << " - Temperatura]" << std::endl;
+            SensorTemperaturaT::expirarVencidas();
             
             if (historial.obtenerTamanio() == 0) {
-                std::cout << "No hay lecturas para procesar." << std::endl;
+                salida << "No hay lecturas para procesar." << std::endl;
                 return;
             }
             
-            float lecturaMasBaja = 9999.9f;
-            Nodo<float>* actual = historial.obtenerCabeza(); 
-            
-            while (actual != nullptr) {
-                if (actual->dato < lecturaMasBaja) {
-                    lecturaMasBaja = actual->dato;
-                }
-                actual = actual->sig;
+            float lecturaMasBaja;
+            bool indexado = false;
+            if (usaMonticulo) {
+                lecturaMasBaja = minimos.top();
+                minimos.pop();
+            } else if (minimoIndexado(historial, lecturaMasBaja)) {
+                indexado = true;
+            } else {
+                lecturaMasBaja = minimoHistorial();
             }
             
-            std::cout << "Lectura más baja encontrada: " << lecturaMasBaja << std::endl;
-            std::cout << "Eliminando lectura más baja..." << std::endl;
+            salida << "Lectura más baja encontrada: " << lecturaMasBaja << std::endl;
+            salida << "Eliminando lectura más baja..." << std::endl;
             historial.eliminarValor(lecturaMasBaja);
+            if (usaMonticulo) {
+                estadisticas.quitarMinimo(lecturaMasBaja, minimos.empty() ? 0.0f : minimos.top());
+            } else if (indexado) {
+                float siguiente = 0.0f;
+                minimoIndexado(historial, siguiente);
+                estadisticas.quitarMinimo(lecturaMasBaja, siguiente);
+            } else {
+                estadisticas.quitar(lecturaMasBaja);
+            }
+        }
+
+        /**
+         * @brief Busca la lectura más baja recorriendo todo el historial
+         * @return Mínimo del historial (9999.9 si está vacío)
+         *
+         * Recorre por bloques con los kernels de Agregados. Sirve para
+         * verificar el montículo y las estadísticas incrementales.
+         */
+        float minimoHistorial() const {
+            SensorTemperaturaT::expirarVencidas();
+            float lecturaMasBaja = 9999.9f;
+            historial.paraCadaBloque([&lecturaMasBaja](const float* datos, int cantidad) {
+                ExtremoIndice<float> minimo = Agregados::minimoConIndice(datos, cantidad);
+                if (minimo.indice >= 0 && minimo.valor < lecturaMasBaja) {
+                    lecturaMasBaja = minimo.valor;
+                }
+            });
+            return lecturaMasBaja;
+        }
+
+        /**
+         * @brief Resume las lecturas con marca de tiempo en [t0, t1)
+         * @param t0 Inicio de la ventana en ns del reloj monotónico (incluido)
+         * @param t1 Fin de la ventana (excluido)
+         * @return Cantidad, suma, mínimo y máximo de la ventana
+         *
+         * Solo disponible si el historial guarda marcas (SerieTemporal).
+         */
+        ResumenVentana<float> resumenEntre(long long t0, long long t1) const {
+            return historial.resumenEntre(t0, t1);
+        }
+
+        /**
+         * @brief Cuenta las lecturas dentro de un rango cerrado
+         * @param desde Límite inferior (incluido)
+         * @param hasta Límite superior (incluido)
+         * @return Lecturas con desde <= valor <= hasta
+         *
+         * Solo disponible si el historial tiene índice ordenado
+         * (HistorialIndexado), que responde en O(log n).
+         */
+        int contarEntre(float desde, float hasta) const {
+            return historial.contarEntre(desde, hasta);
+        }
+
+        /**
+         * @brief Cuenta las lecturas mayores que un umbral
+         * @param umbral Valor de corte (excluido)
+         * @return Lecturas con valor > umbral
+         *
+         * Solo disponible si el historial tiene índice ordenado
+         * (HistorialIndexado), que responde en O(log n).
+         */
+        int contarMayoresQue(float umbral) const {
+            return historial.contarMayoresQue(umbral);
         }
 
+        /**
+         * @brief Historial del sensor, para leer su configuración (capacidad, ventana, ...)
+         * @return Referencia constante, sin lecturas vencidas
+         */
+        const Historial& obtenerHistorial() const {
+            SensorTemperaturaT::expirarVencidas();
+            return historial;
+        }
+
+        /**
+         * @brief Recorre las lecturas del historial por bloques, en orden de llegada
+         * @param f Función con firma f(const float* datos, int cantidad)
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            SensorTemperaturaT::expirarVencidas();
+            historial.paraCadaBloque(f);
+        }
+
+        /**
+         * @brief Copia las lecturas que el historial lea de un archivo proyectado
+         */
+        void soltarArchivo() override { soltarArchivoDe(historial); }
+
         /**
          * @brief Muestra información detallada del sensor
          * @post Imprime tipo, nombre y cantidad de lecturas registradas
          */
         void mostrarInfo() const override {
+            SensorTemperaturaT::expirarVencidas();
             std::cout << "\n=== INFORMACION DEL SENSOR ===" << std::endl;
             std::cout << "Tipo: Temperatura" << std::endl;
             std::cout << "Nombre: " << obtenerNombre() << std::endl;
             std::cout << "Cantidad de lecturas: " << historial.obtenerTamanio() << std::endl;
+            if (estadisticas.cantidad > 0) {
+                EstadisticasLecturas vigentes = estadisticasVigentes();
+                std::cout << "Mínimo: " << vigentes.minimo << "  Máximo: " << vigentes.maximo
+                          << "  Promedio: " << vigentes.media << std::endl;
+            }
+            mostrarDetalleHistorial(historial);
             std::cout << "===============================" << std::endl;
         }
 };
 
+/**
+ * @brief Sensor de temperatura con historial en lista enlazada simple
+ */
+typedef SensorTemperaturaT<ListaSensor<float> > SensorTemperatura;
+
+/**
+ * @brief Sensor de temperatura con historial en lista desenrollada
+ */
+typedef SensorTemperaturaT<ListaSensorDesenrollada<float> > SensorTemperaturaDesenrollado;
+
+/**
+ * @brief Sensor de temperatura que conserva solo las últimas lecturas
+ */
+typedef SensorTemperaturaT<HistorialCircular<float> > SensorTemperaturaCircular;
+
+/**
+ * @brief Sensor de temperatura con marca de tiempo en cada lectura
+ */
+typedef SensorTemperaturaT<SerieTemporal<float> > SensorTemperaturaTemporal;
+
+/**
+ * @brief Sensor de temperatura con historial comprimido por bloques
+ */
+typedef SensorTemperaturaT<HistorialComprimido<float> > SensorTemperaturaComprimido;
+
+/**
+ * @brief Sensor de temperatura cargado de una instantánea proyectada en memoria
+ */
+typedef SensorTemperaturaT<HistorialInstantanea<float> > SensorTemperaturaInstantanea;
+
+/**
+ * @brief Sensor de temperatura con índice ordenado de sus lecturas
+ */
+typedef SensorTemperaturaT<HistorialIndexado<float> > SensorTemperaturaIndexado;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,510 @@
+#ifndef SERIETEMPORAL_H
+#define SERIETEMPORAL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "RasgosHistorial.h"
+#include "RelojMonotonico.h"
+#include "NivelesResumen.h"
+#include "Agregados.h"
+#include "Bitacora.h"
+
+/**
+ * @file SerieTemporal.h
+ * @brief Historial de lecturas con marca de tiempo y consultas por ventana
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class SerieTemporal
+ * @brief Lecturas con marca de tiempo en bloques ordenados por tiempo
+ * @tparam T Tipo de dato almacenado (int, float, etc.)
+ *
+ * Las lecturas llegan en orden de tiempo y se agregan al final del último
+ * bloque. Cada bloque guarda marcas y valores en arreglos separados (los
+ * valores quedan contiguos para los kernels de Agregados). La marca
+ * inicial y el resumen de cada bloque viven en arreglos propios, fuera de
+ * los bloques. Una consulta [t0, t1) busca por bisección el primer bloque
+ * y la posición de cada extremo, usa el resumen de los bloques intermedios
+ * sin tocarlos y solo recorre las lecturas de los dos bloques de los
+ * bordes: O(log n) para ubicar la ventana y O(k / TAMANIO_BLOQUE +
+ * TAMANIO_BLOQUE) para resumirla.
+ *
+ * Cada lectura también se suma a los NivelesResumen (1 s, 1 min, 1 h). Si
+ * se indica un horizonte, los bloques crudos cuya última lectura es más
+ * vieja que el horizonte se liberan completos (la compactación es por
+ * bloque, así que pueden quedar hasta TAMANIO_BLOQUE lecturas más viejas);
+ * esas lecturas siguen contando en los niveles. resumenAgregado() combina
+ * el nivel más grueso que cubre cada tramo de la ventana con los más
+ * finos y las lecturas crudas de los bordes. procesarLectura solo quita
+ * lecturas crudas: los niveles conservan todo lo que se recibió.
+ *
+ * Ofrece la misma interfaz que ListaSensor (insertar, busqueda,
+ * eliminarValor, obtenerTamanio, paraCadaBloque).
+ */
+template <typename T>
+class SerieTemporal {
+    public:
+        typedef T TipoValor; ///< Tipo de las lecturas
+
+        static const int TAMANIO_BLOQUE = 512; ///< Lecturas por bloque
+
+    private:
+        /**
+         * @struct Bloque
+         * @brief Tramo de lecturas consecutivas en el tiempo
+         */
+        struct Bloque {
+            long long marcas[TAMANIO_BLOQUE]; ///< Instante de cada lectura en ns
+            T valores[TAMANIO_BLOQUE];        ///< Lecturas
+            int cantidad;                     ///< Lecturas ocupadas
+
+            Bloque() : cantidad(0) {}
+        };
+
+        std::vector<Bloque*> bloques;    ///< Bloques en orden de tiempo
+        std::vector<long long> primeras; ///< Marca de la primera lectura de cada bloque
+        std::vector<ResumenVentana<T> > resumenes; ///< Resumen de las lecturas de cada bloque
+        int tamanio;                     ///< Lecturas crudas almacenadas
+        long long ultimaMarca;           ///< Marca de la lectura más reciente
+        long long horizonteNs;           ///< Antigüedad máxima de las lecturas crudas (0 = sin límite)
+        long long coberturaCrudaNs;      ///< Antes de esta marca se compactaron lecturas crudas
+        NivelesResumen<T> niveles;       ///< Resúmenes de 1 s, 1 min y 1 h
+
+        /**
+         * @brief Primera posición de un bloque con marca >= t
+         */
+        static int posicionDesde(const Bloque* bloque, long long t) {
+            return static_cast<int>(std::lower_bound(bloque->marcas, bloque->marcas + bloque->cantidad, t) - bloque->marcas);
+        }
+
+        /**
+         * @brief Primer bloque que puede tener lecturas con marca >= t
+         * @return Índice del bloque; el anterior al primero que empieza en
+         *         t o después, porque su final puede caer en la ventana
+         */
+        std::size_t bloqueDesde(long long t) const {
+            std::size_t b = static_cast<std::size_t>(std::lower_bound(primeras.begin(), primeras.end(), t) - primeras.begin());
+            return b > 0 ? b - 1 : 0;
+        }
+
+        /**
+         * @brief Recorre por tramos contiguos las lecturas con marca en [t0, t1)
+         * @param f Función f(const Bloque* bloque, int desde, int hasta)
+         */
+        template <typename F>
+        void paraCadaTramo(long long t0, long long t1, F f) const {
+            if (t0 >= t1) return;
+            for (std::size_t b = bloqueDesde(t0); b < bloques.size() && primeras[b] < t1; b++) {
+                const Bloque* bloque = bloques[b];
+                int desde = bloque->marcas[0] >= t0 ? 0 : posicionDesde(bloque, t0);
+                int hasta = bloque->marcas[bloque->cantidad - 1] < t1 ? bloque->cantidad : posicionDesde(bloque, t1);
+                if (desde < hasta) f(bloque, desde, hasta);
+            }
+        }
+
+        /**
+         * @brief Libera los bloques crudos más viejos que el horizonte
+         * @param alDesalojar Función llamada con cada lectura liberada
+         *
+         * En el caso común solo compara la última marca del bloque más
+         * viejo; los bloques vencidos se quitan del frente de una vez.
+         */
+        template <typename F>
+        void compactar(F alDesalojar) {
+            std::size_t vencidos = 0;
+            while (vencidos + 1 < bloques.size()) {
+                Bloque* bloque = bloques[vencidos];
+                if (bloque->marcas[bloque->cantidad - 1] >= ultimaMarca - horizonteNs) break;
+                for (int i = 0; i < bloque->cantidad; i++) {
+                    alDesalojar(bloque->valores[i]);
+                }
+                tamanio -= bloque->cantidad;
+                delete bloque;
+                vencidos++;
+            }
+            if (vencidos == 0) return;
+            coberturaCrudaNs = primeras[vencidos];
+            bloques.erase(bloques.begin(), bloques.begin() + vencidos);
+            primeras.erase(primeras.begin(), primeras.begin() + vencidos);
+            resumenes.erase(resumenes.begin(), resumenes.begin() + vencidos);
+        }
+
+        /**
+         * @brief Resume [t0, t1) con el nivel indicado y los más finos
+         * @param nivel Nivel a usar para los intervalos completos (-1 = crudo)
+         *
+         * Los intervalos del nivel que caben completos en la ventana aportan
+         * su cubeta; los bordes se resuelven con el nivel siguiente más fino
+         * si este todavía los cubre. Si no, el borde se extiende hasta la
+         * cubeta que lo contiene, así que la ventana puede crecer hasta un
+         * intervalo del nivel en datos más viejos que la retención del fino.
+         */
+        ResumenVentana<T> resumenNivel(long long t0, long long t1, int nivel) const {
+            if (t0 >= t1) return ResumenVentana<T>::vacio();
+            if (nivel < 0) return resumenEntre(t0, t1);
+
+            const NivelResumen<T>& grueso = niveles.nivel(nivel);
+            long long coberturaFina = nivel > 0 ? niveles.nivel(nivel - 1).coberturaDesde() : coberturaCrudaNs;
+            long long a = grueso.alinearArriba(t0);
+            long long b = grueso.alinearAbajo(t1);
+            if (a >= b) {
+                if (t0 >= coberturaFina) return resumenNivel(t0, t1, nivel - 1);
+                return grueso.resumenEntre(grueso.alinearAbajo(t0), grueso.alinearArriba(t1));
+            }
+            if (t0 < a && t0 < coberturaFina) a = grueso.alinearAbajo(t0);
+            if (b < t1 && b < coberturaFina) b = grueso.alinearArriba(t1);
+
+            ResumenVentana<T> resumen = grueso.resumenEntre(a, b);
+            if (t0 < a) resumen.combinar(resumenNivel(t0, a, nivel - 1));
+            if (b < t1) resumen.combinar(resumenNivel(b, t1, nivel - 1));
+            return resumen;
+        }
+
+        /**
+         * @brief Libera todos los bloques
+         */
+        void liberar() {
+            for (std::size_t i = 0; i < bloques.size(); i++) {
+                delete bloques[i];
+            }
+            bloques.clear();
+            primeras.clear();
+            resumenes.clear();
+            tamanio = 0;
+        }
+
+    public:
+        /**
+         * @brief Constructor, serie vacía sin bloques reservados
+         * @param horizonteSegundos Antigüedad máxima de las lecturas crudas
+         *        (0 = conservarlas todas)
+         */
+        explicit SerieTemporal(double horizonteSegundos = 0.0)
+            : tamanio(0), ultimaMarca(0), horizonteNs(static_cast<long long>(horizonteSegundos * 1e9)),
+              coberturaCrudaNs(std::numeric_limits<long long>::min()) {}
+
+        /**
+         * @brief Constructor de copia
+         * @param otra Serie a copiar
+         */
+        SerieTemporal(const SerieTemporal& otra)
+            : primeras(otra.primeras), resumenes(otra.resumenes), tamanio(otra.tamanio), ultimaMarca(otra.ultimaMarca),
+              horizonteNs(otra.horizonteNs), coberturaCrudaNs(otra.coberturaCrudaNs), niveles(otra.niveles) {
+            for (std::size_t i = 0; i < otra.bloques.size(); i++) {
+                bloques.push_back(new Bloque(*otra.bloques[i]));
+            }
+        }
+
+        /**
+         * @brief Operador de asignación
+         * @param otra Serie a copiar
+         * @return Referencia a esta serie
+         */
+        SerieTemporal& operator=(const SerieTemporal& otra) {
+            if (this != &otra) {
+                SerieTemporal copia(otra);
+                bloques.swap(copia.bloques);
+                primeras.swap(copia.primeras);
+                resumenes.swap(copia.resumenes);
+                std::swap(tamanio, copia.tamanio);
+                std::swap(ultimaMarca, copia.ultimaMarca);
+                std::swap(horizonteNs, copia.horizonteNs);
+                std::swap(coberturaCrudaNs, copia.coberturaCrudaNs);
+                std::swap(niveles, copia.niveles);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor, libera los bloques
+         */
+        ~SerieTemporal() {
+            IOT_DEPURACION("Serie temporal con " << tamanio << " valores destruida");
+            liberar();
+        }
+
+        /**
+         * @brief Inserta una lectura con su marca de tiempo
+         * @param valor Valor a insertar
+         * @param marcaNs Instante de la lectura; 0 = instante actual. Si es
+         *        anterior a la última marca se toma la última, para que la
+         *        serie siga ordenada.
+         * @param alDesalojar Función llamada con cada lectura cruda que se
+         *        compacta por el horizonte
+         * @post La lectura queda al final y en los niveles; O(1) amortizado
+         */
+        template <typename F>
+        void insertarEn(T valor, long long marcaNs, F alDesalojar) {
+            if (marcaNs == 0) marcaNs = instanteActualNs();
+            if (tamanio > 0 && marcaNs < ultimaMarca) marcaNs = ultimaMarca;
+            if (bloques.empty() || bloques.back()->cantidad == TAMANIO_BLOQUE) {
+                bloques.push_back(new Bloque());
+                primeras.push_back(marcaNs);
+                resumenes.push_back(ResumenVentana<T>::vacio());
+            }
+            Bloque* bloque = bloques.back();
+            bloque->marcas[bloque->cantidad] = marcaNs;
+            bloque->valores[bloque->cantidad] = valor;
+            bloque->cantidad++;
+            resumenes.back().agregar(valor);
+            tamanio++;
+            ultimaMarca = marcaNs;
+            niveles.agregar(marcaNs, valor);
+            if (horizonteNs > 0) compactar(alDesalojar);
+            IOT_DEPURACION("Valor insertado: " << valor);
+        }
+
+        /**
+         * @brief Inserta una lectura con su marca descartando lo compactado
+         * @param valor Valor a insertar
+         * @param marcaNs Instante de la lectura (0 = instante actual)
+         */
+        void insertarEn(T valor, long long marcaNs) {
+            insertarEn(valor, marcaNs, [](T) {});
+        }
+
+        /**
+         * @brief Inserta una lectura con el instante actual
+         * @param valor Valor a insertar
+         */
+        void insertar(T valor) {
+            insertarEn(valor, 0);
+        }
+
+        /**
+         * @brief Busca un valor en la serie
+         * @param valor Valor a buscar
+         * @return true si el valor existe
+         */
+        bool busqueda(T valor) const {
+            for (std::size_t b = 0; b < bloques.size(); b++) {
+                const Bloque* bloque = bloques[b];
+                for (int i = 0; i < bloque->cantidad; i++) {
+                    if (bloque->valores[i] == valor) return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Elimina la primera aparición (la más antigua) de un valor
+         * @param valor Valor a eliminar
+         * @return true si se eliminó, false si no se encontró
+         * @post El resumen del bloque se recalcula; un bloque vacío se libera
+         */
+        bool eliminarValor(T valor) {
+            for (std::size_t b = 0; b < bloques.size(); b++) {
+                Bloque* bloque = bloques[b];
+                int i = 0;
+                while (i < bloque->cantidad && bloque->valores[i] != valor) i++;
+                if (i == bloque->cantidad) continue;
+
+                for (int j = i; j < bloque->cantidad - 1; j++) {
+                    bloque->marcas[j] = bloque->marcas[j + 1];
+                    bloque->valores[j] = bloque->valores[j + 1];
+                }
+                bloque->cantidad--;
+                tamanio--;
+                if (bloque->cantidad == 0) {
+                    delete bloque;
+                    bloques.erase(bloques.begin() + b);
+                    primeras.erase(primeras.begin() + b);
+                    resumenes.erase(resumenes.begin() + b);
+                } else {
+                    resumenes[b] = ResumenVentana<T>::deBloque(bloque->valores, bloque->cantidad);
+                    primeras[b] = bloque->marcas[0];
+                }
+                IOT_DEPURACION("Nodo eliminado: " << valor);
+                return true;
+            }
+            IOT_DEPURACION("Valor no encontrado: " << valor);
+            return false;
+        }
+
+        /**
+         * @brief Resume las lecturas con marca en [t0, t1)
+         * @param t0 Inicio de la ventana (incluido), en ns del reloj monotónico
+         * @param t1 Fin de la ventana (excluido)
+         * @return Cantidad, suma, mínimo y máximo de la ventana
+         *
+         * Un bloque cae completo en la ventana si empieza en t0 o después y
+         * el siguiente empieza antes de t1; entonces aporta su resumen sin
+         * leer el bloque. Solo se recorren las lecturas de los bordes.
+         */
+        ResumenVentana<T> resumenEntre(long long t0, long long t1) const {
+            ResumenVentana<T> resumen = ResumenVentana<T>::vacio();
+            if (t0 >= t1) return resumen;
+            std::size_t total = bloques.size();
+            for (std::size_t b = bloqueDesde(t0); b < total && primeras[b] < t1; b++) {
+                bool empiezaDentro = primeras[b] >= t0;
+                bool terminaDentro = b + 1 < total ? primeras[b + 1] < t1 : ultimaMarca < t1;
+                if (empiezaDentro && terminaDentro) {
+                    resumen.combinar(resumenes[b]);
+                    continue;
+                }
+                const Bloque* bloque = bloques[b];
+                int desde = empiezaDentro ? 0 : posicionDesde(bloque, t0);
+                int hasta = terminaDentro ? bloque->cantidad : posicionDesde(bloque, t1);
+                if (desde < hasta) {
+                    resumen.combinar(ResumenVentana<T>::deBloque(bloque->valores + desde, hasta - desde));
+                }
+            }
+            return resumen;
+        }
+
+        /**
+         * @brief Resume [t0, t1) usando el nivel más grueso que cubre cada tramo
+         * @param t0 Inicio de la ventana (incluido)
+         * @param t1 Fin de la ventana (excluido)
+         * @return Resumen de todas las lecturas recibidas en la ventana,
+         *         incluidas las compactadas
+         *
+         * Una ventana de un mes combina unas 720 cubetas de 1 h más los
+         * bordes en minutos, segundos y lecturas crudas.
+         */
+        ResumenVentana<T> resumenAgregado(long long t0, long long t1) const {
+            return resumenNivel(t0, t1, NivelesResumen<T>::CANTIDAD - 1);
+        }
+
+        /**
+         * @brief Obtiene los niveles de resumen
+         */
+        const NivelesResumen<T>& obtenerNiveles() const { return niveles; }
+
+        /**
+         * @brief Recorre las lecturas con marca en [t0, t1) por tramos contiguos
+         * @param t0 Inicio de la ventana (incluido)
+         * @param t1 Fin de la ventana (excluido)
+         * @param f Función f(const long long* marcas, const T* valores, int cantidad)
+         */
+        template <typename F>
+        void paraCadaBloqueEntre(long long t0, long long t1, F f) const {
+            paraCadaTramo(t0, t1, [&f](const Bloque* bloque, int desde, int hasta) {
+                f(static_cast<const long long*>(bloque->marcas + desde),
+                  static_cast<const T*>(bloque->valores + desde), hasta - desde);
+            });
+        }
+
+        /**
+         * @brief Marca de la lectura más reciente (0 si la serie está vacía)
+         */
+        long long obtenerUltimaMarca() const { return tamanio > 0 ? ultimaMarca : 0; }
+
+        /**
+         * @brief Indica si las lecturas crudas viejas se compactan (hay horizonte)
+         */
+        bool compacta() const { return horizonteNs > 0; }
+
+        /**
+         * @brief Obtiene el horizonte de las lecturas crudas en segundos (0 = sin límite)
+         */
+        double obtenerHorizonteSegundos() const { return static_cast<double>(horizonteNs) / 1e9; }
+
+        /**
+         * @brief Obtiene el número de lecturas almacenadas
+         */
+        int obtenerTamanio() const { return tamanio; }
+
+        /**
+         * @brief Memoria reservada por los bloques crudos y los niveles
+         * @return Bytes
+         */
+        std::size_t bytesReservados() const { return bloques.size() * sizeof(Bloque) + niveles.bytesReservados(); }
+
+        /**
+         * @brief Recorre los valores por bloques contiguos, en orden de tiempo
+         * @param f Función con firma f(const T* datos, int cantidad)
+         */
+        template <typename F>
+        void paraCadaBloque(F f) const {
+            for (std::size_t b = 0; b < bloques.size(); b++) {
+                f(static_cast<const T*>(bloques[b]->valores), bloques[b]->cantidad);
+            }
+        }
+};
+
+/**
+ * @brief Rasgos de SerieTemporal: guarda la marca de cada lectura y puede
+ *        compactar lecturas crudas viejas
+ *
+ * Solo compacta si tiene horizonte; sin él conserva todas las lecturas y
+ * el sensor sigue usando el montículo (ver monticuloMinimosEn()).
+ */
+template <typename T>
+struct RasgosHistorial<SerieTemporal<T> > {
+    static const bool desaloja = true;
+    static const bool monticuloMinimos = true;
+
+    template <typename F>
+    static void insertar(SerieTemporal<T>& historial, T valor, long long marcaNs, F alDesalojar) {
+        historial.insertarEn(valor, marcaNs, alDesalojar);
+    }
+
+    template <typename F>
+    static void expirar(SerieTemporal<T>&, F) {}
+};
+
+/**
+ * @brief Con horizonte la serie compacta lecturas crudas y el montículo
+ *        quedaría con valores que ya no están en ella
+ */
+template <typename T>
+inline bool monticuloMinimosEn(const SerieTemporal<T>& historial) { return !historial.compacta(); }
+
+/**
+ * @brief Imprime una ventana resumida en una línea
+ * @param titulo Nombre de la ventana
+ * @param resumen Resumen a imprimir
+ */
+template <typename T>
+inline void imprimirResumenVentana(const char* titulo, const ResumenVentana<T>& resumen) {
+    std::cout << titulo << ": " << resumen.cantidad << " lecturas";
+    if (resumen.cantidad > 0) {
+        std::cout << "  Mínimo: " << resumen.minimo << "  Máximo: " << resumen.maximo
+                  << "  Promedio: " << resumen.media();
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Imprime el último minuto, la última hora, el último día y el total
+ * @param serie Historial con marcas de tiempo
+ *
+ * Las ventanas se cuentan hacia atrás desde la lectura más reciente y se
+ * resuelven con el nivel más grueso que las cubre (resumenAgregado).
+ */
+template <typename T>
+inline void mostrarDetalleHistorial(const SerieTemporal<T>& serie) {
+    const long long segundo = 1000000000LL;
+    long long fin = serie.obtenerUltimaMarca() + 1;
+    imprimirResumenVentana("Ultimo minuto", serie.resumenAgregado(fin - 60 * segundo, fin));
+    imprimirResumenVentana("Ultima hora", serie.resumenAgregado(fin - 3600 * segundo, fin));
+    imprimirResumenVentana("Ultimo dia", serie.resumenAgregado(fin - 24 * 3600 * segundo, fin));
+    imprimirResumenVentana("Total recibido", serie.resumenAgregado(0, fin));
+}
+
+/**
+ * @brief Resumen de todas las lecturas recibidas, incluidas las compactadas
+ * @return false si el historial no tiene niveles de resumen
+ */
+template <typename Historial>
+inline bool resumenTotalRecibido(const Historial&, ResumenVentana<typename Historial::TipoValor>&) { return false; }
+
+/**
+ * @brief Resumen de todas las lecturas recibidas por una serie temporal
+ * @param serie Historial con niveles de resumen
+ * @param total Resumen resultante
+ * @return true
+ */
+template <typename T>
+inline bool resumenTotalRecibido(const SerieTemporal<T>& serie, ResumenVentana<T>& total) {
+    total = serie.resumenAgregado(0, serie.obtenerUltimaMarca() + 1);
+    return true;
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Bitacora.h"
+
+/**
+ * @file Bench.h
+ * @brief Utilidades mínimas para los benchmarks del sistema IoT
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class Cronometro
+ * @brief Mide el tiempo transcurrido con un reloj monotónico
+ */
+class Cronometro {
+    private:
+        std::chrono::steady_clock::time_point inicio; ///< Instante de arranque
+
+    public:
+        /**
+         * @brief Constructor, arranca la medición
+         */
+        Cronometro() : inicio(std::chrono::steady_clock::now()) {}
+
+        /**
+         * @brief Reinicia la medición
+         */
+        void reiniciar() { inicio = std::chrono::steady_clock::now(); }
+
+        /**
+         * @brief Obtiene los segundos transcurridos desde el arranque
+         * @return Tiempo transcurrido en segundos
+         */
+        double segundos() const {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        }
+};
+
+/**
+ * @class SilenciarSalida
+ * @brief Apaga la bitácora y std::cout mientras el objeto exista (RAII)
+ *
+ * Los contenedores emiten mensajes por cada operación; para medir la
+ * estructura de datos se apaga la bitácora en ejecución (los mensajes no
+ * se formatean) y se pone std::cout en estado de error para lo que los
+ * sensores muestran directamente.
+ */
+class SilenciarSalida {
+    private:
+        NivelBitacora nivelAnterior; ///< Nivel a restaurar
+
+    public:
+        SilenciarSalida() : nivelAnterior(Bitacora::obtenerNivel()) {
+            Bitacora::establecerNivel(BITACORA_APAGADA);
+            std::cout.setstate(std::ios::badbit);
+        }
+        ~SilenciarSalida() {
+            std::cout.clear();
+            Bitacora::establecerNivel(nivelAnterior);
+        }
+};
+
+/**
+ * @struct OpcionesBench
+ * @brief Parámetros de línea de comandos del ejecutable de benchmarks
+ */
+struct OpcionesBench {
+    long maximo;          ///< Tamaño máximo de las pruebas (número de elementos)
+    const char* filtro;   ///< Solo se ejecutan los casos cuyo nombre contenga este texto
+    const char* json;     ///< Archivo donde escribir los resultados en JSON (nullptr = no se escriben)
+};
+
+/**
+ * @brief Obtiene las opciones globales de los benchmarks
+ * @return Referencia a las opciones compartidas
+ */
+inline OpcionesBench& opcionesBench() {
+    static OpcionesBench opciones = { 10000000L, "", nullptr };
+    return opciones;
+}
+
+/**
+ * @brief Indica si un caso debe ejecutarse según el filtro
+ * @param nombre Nombre del caso
+ * @return true si el nombre contiene el filtro
+ */
+inline bool casoHabilitado(const char* nombre) {
+    return std::strstr(nombre, opcionesBench().filtro) != nullptr;
+}
+
+/**
+ * @brief Contador global de asignaciones con operator new
+ * @return Referencia al contador (bench_main.cpp reemplaza operator new)
+ */
+inline std::atomic<long>& contadorAsignaciones() {
+    static std::atomic<long> contador(0);
+    return contador;
+}
+
+/**
+ * @struct ResultadoBench
+ * @brief Una fila reportada, guardada para el archivo JSON
+ */
+struct ResultadoBench {
+    std::string caso;   ///< Nombre del caso
+    long n;             ///< Tamaño de la prueba
+    double operaciones; ///< Operaciones medidas
+    double segundos;    ///< Tiempo total de las operaciones
+};
+
+/**
+ * @brief Filas reportadas en esta ejecución, en orden
+ */
+inline std::vector<ResultadoBench>& resultadosBench() {
+    static std::vector<ResultadoBench> resultados;
+    return resultados;
+}
+
+/**
+ * @brief Imprime una fila de resultados
+ * @param caso Nombre del caso medido
+ * @param n Tamaño de la prueba
+ * @param operaciones Número de operaciones medidas
+ * @param segundos Tiempo total de las operaciones
+ */
+inline void reportarBench(const char* caso, long n, double operaciones, double segundos) {
+    double nsPorOp = operaciones > 0 ? segundos * 1e9 / operaciones : 0.0;
+    double opsPorSeg = segundos > 0 ? operaciones / segundos : 0.0;
+    ResultadoBench resultado = { caso, n, operaciones, segundos };
+    resultadosBench().push_back(resultado);
+    std::cout << std::left << std::setw(40) << caso
+              << std::right << std::setw(12) << n
+              << std::setw(14) << std::fixed << std::setprecision(2) << nsPorOp << " ns/op"
+              << std::setw(16) << std::setprecision(0) << opsPorSeg << " op/s" << std::endl;
+}
+
+/**
+ * @brief Escribe los resultados reportados en el formato JSON de Google Benchmark
+ * @param ruta Archivo destino
+ * @return true si se escribió completo
+ *
+ * Cada fila es un benchmark "caso/n" con real_time en ns por operación e
+ * items_per_second, de modo que herramientas como compare.py de Google
+ * Benchmark pueden comparar dos ejecuciones. Solo se mide tiempo de
+ * reloj, así que no hay cpu_time.
+ */
+inline bool escribirResultadosJson(const char* ruta) {
+    std::ofstream salida(ruta);
+    if (!salida) return false;
+    char fecha[32];
+    std::time_t ahora = std::time(nullptr);
+    std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%S", std::localtime(&ahora));
+#ifdef NDEBUG
+    const char* compilacion = "release";
+#else
+    const char* compilacion = "debug";
+#endif
+    salida << "{\n  \"context\": {\n"
+           << "    \"date\": \"" << fecha << "\",\n"
+           << "    \"executable\": \"SistemaIoT_bench\",\n"
+           << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+           << "    \"library_build_type\": \"" << compilacion << "\",\n"
+           << "    \"maximo\": " << opcionesBench().maximo << "\n"
+           << "  },\n  \"benchmarks\": [";
+    const std::vector<ResultadoBench>& resultados = resultadosBench();
+    salida << std::setprecision(6) << std::scientific;
+    for (std::size_t i = 0; i < resultados.size(); i++) {
+        const ResultadoBench& r = resultados[i];
+        double nsPorOp = r.operaciones > 0 ? r.segundos * 1e9 / r.operaciones : 0.0;
+        double opsPorSeg = r.segundos > 0 ? r.operaciones / r.segundos : 0.0;
+        salida << (i == 0 ? "\n" : ",\n")
+               << "    {\n"
+               << "      \"name\": \"" << r.caso << "/" << r.n << "\",\n"
+               << "      \"run_name\": \"" << r.caso << "/" << r.n << "\",\n"
+               << "      \"run_type\": \"iteration\",\n"
+               << "      \"iterations\": " << static_cast<long long>(r.operaciones) << ",\n"
+               << "      \"real_time\": " << nsPorOp << ",\n"
+               << "      \"time_unit\": \"ns\",\n"
+               << "      \"items_per_second\": " << opsPorSeg << "\n"
+               << "    }";
+    }
+    salida << "\n  ]\n}\n";
+    return static_cast<bool>(salida);
+}
+
+#endif
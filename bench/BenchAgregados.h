@@ -0,0 +1,77 @@
+#ifndef BENCHAGREGADOS_H
+#define BENCHAGREGADOS_H
+
+#include <vector>
+#include <cmath>
+#include "Bench.h"
+#include "../Agregados.h"
+
+/**
+ * @file BenchAgregados.h
+ * @brief Benchmarks de los kernels de agregación por nivel SIMD
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Ejecuta todos los kernels sobre un arreglo y reporta el tiempo
+ * @tparam T float o int
+ * @param caso Nombre del caso en el reporte
+ * @param datos Lecturas contiguas
+ * @param umbral Umbral para el conteo
+ * @return Valor de control para comparar niveles
+ */
+template <typename T>
+double medirKernels(const char* caso, const std::vector<T>& datos, T umbral) {
+    const int n = static_cast<int>(datos.size());
+    const int repeticiones = 20;
+    double control = 0.0;
+
+    Cronometro reloj;
+    for (int r = 0; r < repeticiones; r++) {
+        control = static_cast<double>(Agregados::suma(&datos[0], n));
+        control += Agregados::minimoConIndice(&datos[0], n).valor;
+        control += Agregados::maximoConIndice(&datos[0], n).valor;
+        control += Agregados::varianza(&datos[0], n);
+        control += Agregados::contarMayoresQue(&datos[0], n, umbral);
+    }
+    reportarBench(caso, n, static_cast<double>(n) * repeticiones, reloj.segundos());
+    return control;
+}
+
+/**
+ * @brief Compara las rutas escalar, SSE2 y AVX2 sobre 1M lecturas
+ *
+ * Cada operación cuenta la pasada de los cinco kernels sobre un valor.
+ * Al final verifica que los tres niveles den el mismo resultado.
+ */
+inline void benchAgregados() {
+    if (!casoHabilitado("agregados")) return;
+
+    long n = opcionesBench().maximo < 1000000L ? opcionesBench().maximo : 1000000L;
+    std::vector<float> temperaturas(n);
+    std::vector<int> presiones(n);
+    for (long i = 0; i < n; i++) {
+        temperaturas[i] = 20.0f + static_cast<float>((i * 7919) % 151) / 10.0f;
+        presiones[i] = 80 + static_cast<int>((i * 7919) % 41);
+    }
+
+    const char* nombres[] = { "agregados_float_escalar", "agregados_float_sse2", "agregados_float_avx2" };
+    const char* nombresInt[] = { "agregados_int_escalar", "agregados_int_sse2", "agregados_int_avx2" };
+    double referenciaF = 0.0, referenciaI = 0.0;
+    for (int nivel = SIMD_ESCALAR; nivel <= SIMD_AVX2; nivel++) {
+        if (Agregados::forzarNivel(static_cast<NivelSimd>(nivel)) != nivel) continue;
+        double f = medirKernels(nombres[nivel], temperaturas, 30.0f);
+        double i = medirKernels(nombresInt[nivel], presiones, 110);
+        if (nivel == SIMD_ESCALAR) {
+            referenciaF = f;
+            referenciaI = i;
+        } else if (std::fabs(f - referenciaF) > 1e-6 * std::fabs(referenciaF) ||
+                   std::fabs(i - referenciaI) > 1e-6 * std::fabs(referenciaI)) {
+            std::cout << "ERROR: resultados distintos en nivel " << nivel << std::endl;
+        }
+    }
+    Agregados::forzarNivel(SIMD_AVX2);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef BENCHBITACORA_H
+#define BENCHBITACORA_H
+
+#include <fstream>
+#include "Bench.h"
+#include "../Bitacora.h"
+#include "../ListaSensor.h"
+
+/**
+ * @file BenchBitacora.h
+ * @brief Costo de los mensajes por nodo según el sumidero de la bitácora
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Inserta y destruye un historial de n lecturas con la bitácora activa
+ * @return Segundos empleados
+ */
+inline double medirHistorialConBitacora(long n) {
+    Cronometro reloj;
+    {
+        ListaSensor<float> lista;
+        for (long i = 0; i < n; i++) {
+            lista.insertar(static_cast<float>(i) * 0.5f);
+        }
+    }
+    return reloj.segundos();
+}
+
+/**
+ * @brief Compara el std::endl por mensaje original contra los sumideros
+ *
+ * Inserta y destruye un historial de hasta 1M lecturas (2 mensajes de
+ * depuración por lectura) escribiendo en el dispositivo nulo, de modo
+ * que se mide el formateo y las llamadas al sistema, no la terminal.
+ */
+inline void benchBitacora() {
+    if (!casoHabilitado("bitacora")) return;
+
+    long n = opcionesBench().maximo < 1000000L ? opcionesBench().maximo : 1000000L;
+#ifdef _WIN32
+    const char* nulo = "NUL";
+#else
+    const char* nulo = "/dev/null";
+#endif
+    std::ofstream destino(nulo);
+    NivelBitacora nivelAnterior = Bitacora::obtenerNivel();
+
+    // Comportamiento anterior: operator<< y std::endl directos por cada nodo
+    Cronometro reloj;
+    {
+        SilenciarSalida silencio;
+        ListaSensor<float> lista;
+        for (long i = 0; i < n; i++) {
+            float valor = static_cast<float>(i) * 0.5f;
+            lista.insertar(valor);
+            destino << "Nodo insertado: " << valor << std::endl;
+        }
+        for (long i = 0; i < n; i++) {
+            destino << "Nodo con valor: " << static_cast<float>(i) * 0.5f << " destruido" << std::endl;
+        }
+    }
+    reportarBench("bitacora_endl_directo", n, 2.0 * n, reloj.segundos());
+
+    Bitacora::establecerNivel(BITACORA_DEPURACION);
+    {
+        SumideroConsola consola(destino);
+        SumideroInstalado instalacion(&consola);
+        double segundos = medirHistorialConBitacora(n);
+        reportarBench("bitacora_sumidero_consola", n, 2.0 * n, segundos);
+    }
+    {
+        SumideroAsincrono asincrono(destino);
+        double segundos;
+        {
+            SumideroInstalado instalacion(&asincrono);
+            segundos = medirHistorialConBitacora(n);
+        }
+        reportarBench("bitacora_sumidero_asincrono", n, 2.0 * n, segundos);
+        if (asincrono.obtenerDescartados() > 0) {
+            std::cout << "  descartados: " << asincrono.obtenerDescartados() << std::endl;
+        }
+    }
+
+    Bitacora::establecerNivel(BITACORA_APAGADA);
+    reportarBench("bitacora_nivel_apagado", n, 2.0 * n, medirHistorialConBitacora(n));
+    Bitacora::establecerNivel(nivelAnterior);
+}
+
+#endif
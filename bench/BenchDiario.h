@@ -0,0 +1,183 @@
+#ifndef BENCHDIARIO_H
+#define BENCHDIARIO_H
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include "Bench.h"
+#include "../DiarioLecturas.h"
+
+/**
+ * @file BenchDiario.h
+ * @brief Costo del diario de lecturas por registro y en grupo, y su reproducción
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Registra lecturas como lo hace el consumidor de la ingesta
+ * @param enrutador Enrutador de la lista destino
+ * @param diario Diario abierto (nullptr = sin diario)
+ * @param n Número de lecturas
+ * @return Lecturas registradas
+ *
+ * Alterna 8 sensores de temperatura y 8 de presión.
+ */
+inline long registrarConDiario(EnrutadorESP32& enrutador, DiarioLecturas* diario, long n) {
+    char ids[16][8];
+    for (int s = 0; s < 16; s++) std::snprintf(ids[s], sizeof(ids[s]), "%c-%02d", s < 8 ? 'T' : 'P', s);
+    long registradas = 0;
+    for (long i = 0; i < n; i++) {
+        int s = static_cast<int>(i % 16);
+        LecturaESP32 lectura;
+        lectura.tipo = s < 8 ? LECTURA_TEMPERATURA : LECTURA_PRESION;
+        lectura.id.datos = ids[s];
+        lectura.id.longitud = 4;
+        lectura.valorTexto = vistaDe("");
+        lectura.temperatura = 20.0f + static_cast<float>(i % 50) * 0.1f;
+        lectura.presion = 900 + static_cast<int>(i % 200);
+        if (enrutador.registrar(lectura, i) != RUTA_REGISTRADA) continue;
+        registradas++;
+        if (diario != nullptr) {
+            diario->anotar(lectura.tipo, ids[s], 4, lectura.temperatura, lectura.presion, i);
+        }
+    }
+    return registradas;
+}
+
+/**
+ * @brief Mide un modo del diario y comprueba que se reproduzca completo
+ * @param caso Nombre del caso
+ * @param directorio Directorio temporal del diario
+ * @param modo Modo de sincronización
+ * @param n Número de lecturas
+ *
+ * El tiempo incluye cerrar el diario, es decir, esperar a que el último
+ * grupo llegue a disco.
+ */
+inline void medirDiario(const char* caso, const char* directorio, ModoDiario modo, long n) {
+    descartarDiario(directorio);
+    long anotadas, sincronizaciones, reproducidas;
+    double segundos;
+    {
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        EnrutadorESP32 enrutador(lista);
+        DiarioLecturas diario;
+        diario.abrir(directorio, modo, 10);
+        Cronometro reloj;
+        registrarConDiario(enrutador, &diario, n);
+        diario.cerrar();
+        segundos = reloj.segundos();
+        anotadas = diario.obtenerRegistros();
+        sincronizaciones = diario.obtenerSincronizaciones();
+
+        ListaGeneral recuperada;
+        EnrutadorESP32 enrutadorRecuperada(recuperada);
+        reproducidas = reproducirDiario(directorio, enrutadorRecuperada);
+    }
+    reportarBench(caso, n, static_cast<double>(n), segundos);
+    std::cout << "  " << sincronizaciones << " fdatasync, " << std::setprecision(1)
+              << (sincronizaciones > 0 ? static_cast<double>(anotadas) / sincronizaciones : 0.0)
+              << " lecturas por grupo" << std::endl;
+    if (reproducidas != anotadas) {
+        std::cout << "  ERROR: se anotaron " << anotadas << " lecturas y se reprodujeron " << reproducidas << std::endl;
+    }
+}
+
+/**
+ * @brief Agrega un registro cortado al último segmento y comprueba que se ignore
+ * @param directorio Directorio de un diario con lecturas
+ * @return true si la reproducción recupera lo mismo que antes
+ */
+inline bool verificarColaDanadaDiario(const char* directorio) {
+    SilenciarSalida silencio;
+    ListaGeneral antes;
+    EnrutadorESP32 enrutadorAntes(antes);
+    long esperadas = reproducirDiario(directorio, enrutadorAntes);
+
+    std::vector<unsigned long> segmentos = listarSegmentosDiario(directorio);
+    if (segmentos.empty()) return false;
+    {
+        std::ofstream salida(rutaSegmentoDiario(directorio, segmentos.back()).c_str(), std::ios::binary | std::ios::app);
+        const char cortado[] = "\x12\x34\x56\x78\x00\x04\x01\x02\x03";
+        salida.write(cortado, sizeof(cortado) - 1);
+    }
+    ListaGeneral despues;
+    EnrutadorESP32 enrutadorDespues(despues);
+    return esperadas > 0 && reproducirDiario(directorio, enrutadorDespues) == esperadas;
+}
+
+/**
+ * @brief Comprueba que la reproducción lleve las marcas al reloj monotónico actual
+ * @param directorio Directorio temporal del diario
+ * @return true si la lectura de hace 5 s conserva su antigüedad y la del
+ *         futuro queda en el instante de la reproducción
+ *
+ * La marca del futuro es la que dejaría un arranque anterior con el
+ * reloj monotónico más adelantado que el actual.
+ */
+inline bool verificarMarcasDiario(const char* directorio) {
+    SilenciarSalida silencio;
+    descartarDiario(directorio);
+    const long long segundo = 1000000000LL;
+    {
+        DiarioLecturas diario;
+        if (!diario.abrir(directorio, DIARIO_POR_REGISTRO)) return false;
+        long long ahora = instanteActualNs();
+        diario.anotar(LECTURA_TEMPERATURA, "T-01", 4, 20.0f, 0, ahora - 5 * segundo);
+        diario.anotar(LECTURA_TEMPERATURA, "T-01", 4, 21.0f, 0, ahora + 10 * 86400 * segundo);
+    }
+    PoliticaRetencion politica;
+    politica.serieTemporal = true;
+    ListaGeneral lista;
+    EnrutadorESP32 enrutador(lista, politica);
+    long long antes = instanteActualNs();
+    if (reproducirDiario(directorio, enrutador) != 2) return false;
+    long long despues = instanteActualNs();
+    SensorTemperaturaTemporal* sensor = dynamic_cast<SensorTemperaturaTemporal*>(lista.buscarSensor("T-01"));
+    descartarDiario(directorio);
+    return sensor != nullptr && sensor->resumenEntre(antes - 6 * segundo, antes - 4 * segundo).cantidad == 1 &&
+           sensor->resumenEntre(antes, despues + 1).cantidad == 1;
+}
+
+/**
+ * @brief Registro de lecturas sin diario, con fdatasync por lectura y en grupo
+ *
+ * fdatasync por lectura cuesta lo que tarde el disco en confirmar (cientos
+ * de µs o más), así que ese caso usa pocas lecturas. En grupo, el hilo de
+ * la ingesta solo copia el registro y el costo por lectura debe quedar en
+ * unos cuantos µs como máximo.
+ */
+inline void benchDiario() {
+    if (!casoHabilitado("diario")) return;
+
+    const char* directorio = "bench_diario";
+    const long maximo = opcionesBench().maximo;
+    long n = maximo < 1000000L ? maximo : 1000000L;
+    long nPorRegistro = n < 2000L ? n : 2000L;
+
+    double segSinDiario;
+    {
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        EnrutadorESP32 enrutador(lista);
+        Cronometro reloj;
+        registrarConDiario(enrutador, nullptr, n);
+        segSinDiario = reloj.segundos();
+    }
+    reportarBench("diario_sin_diario", n, static_cast<double>(n), segSinDiario);
+    medirDiario("diario_fdatasync_por_lectura", directorio, DIARIO_POR_REGISTRO, nPorRegistro);
+    medirDiario("diario_agrupado_10ms", directorio, DIARIO_AGRUPADO, n);
+
+    if (!verificarColaDanadaDiario(directorio)) {
+        std::cout << "  ERROR: un registro incompleto al final del diario altero la reproduccion" << std::endl;
+    }
+    if (!verificarMarcasDiario(directorio)) {
+        std::cout << "  ERROR: las marcas reproducidas no conservan su antiguedad en el reloj actual" << std::endl;
+    }
+    descartarDiario(directorio);
+    std::remove(directorio);
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef BENCHHISTORIALCOMPRIMIDO_H
+#define BENCHHISTORIALCOMPRIMIDO_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "../ListaSensor.h"
+#include "../HistorialComprimido.h"
+
+/**
+ * @file BenchHistorialComprimido.h
+ * @brief Benchmarks de razón de compresión y velocidad de decodificación
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Lecturas sintéticas con el perfil del firmware del ESP32
+ * @param n Número de lecturas
+ * @param temperaturas Temperaturas con un decimal que cambian poco entre lecturas
+ * @param presiones Presiones enteras entre 80 y 120
+ */
+inline void generarLecturasESP32(long n, std::vector<float>& temperaturas, std::vector<int>& presiones) {
+    temperaturas.resize(static_cast<std::size_t>(n));
+    presiones.resize(static_cast<std::size_t>(n));
+    unsigned int semilla = 2025;
+    int decimas = 250;
+    int presion = 100;
+    for (long i = 0; i < n; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        // La mitad de las lecturas repite la anterior, el resto sube o baja 0.1
+        if (azar % 4 == 1 && decimas < 350) decimas++;
+        if (azar % 4 == 2 && decimas > 150) decimas--;
+        presion += static_cast<int>((azar >> 4) % 5) - 2;
+        if (presion < 80) presion = 80;
+        if (presion > 120) presion = 120;
+        temperaturas[static_cast<std::size_t>(i)] = static_cast<float>(decimas) / 10.0f;
+        presiones[static_cast<std::size_t>(i)] = presion;
+    }
+}
+
+/**
+ * @brief Inserta, decodifica y verifica un historial comprimido
+ * @param nombre Prefijo de los casos en el reporte
+ * @param datos Lecturas a comprimir
+ */
+template <typename T>
+inline void medirHistorialComprimido(const char* nombre, const std::vector<T>& datos) {
+    const long n = static_cast<long>(datos.size());
+    std::string caso(nombre);
+    HistorialComprimido<T>* historial;
+    double segInsertar;
+    {
+        SilenciarSalida silencio;
+        historial = new HistorialComprimido<T>();
+        Cronometro reloj;
+        for (long i = 0; i < n; i++) historial->insertar(datos[static_cast<std::size_t>(i)]);
+        segInsertar = reloj.segundos();
+    }
+    reportarBench((caso + "_insertar").c_str(), n, static_cast<double>(n), segInsertar);
+
+    // Decodificación lectura por lectura, verificando contra los datos originales
+    long errores = 0;
+    double suma = 0.0;
+    Cronometro relojCursor;
+    typename HistorialComprimido<T>::Cursor cursor(*historial);
+    T valor;
+    long i = 0;
+    while (cursor.siguiente(valor)) {
+        if (i >= n || valor != datos[static_cast<std::size_t>(i)]) errores++;
+        suma += valor;
+        i++;
+    }
+    double segCursor = relojCursor.segundos();
+    if (i != n) errores++;
+    reportarBench((caso + "_decodificar_cursor").c_str(), n, static_cast<double>(n), segCursor);
+
+    // Decodificación por bloques, como la usan minimoHistorial() y promedioHistorial()
+    Cronometro relojBloques;
+    historial->paraCadaBloque([&suma](const T* bloque, int cantidad) {
+        suma += Agregados::suma(bloque, cantidad);
+    });
+    double segBloques = relojBloques.segundos();
+    reportarBench((caso + "_decodificar_bloques").c_str(), n, static_cast<double>(n), segBloques);
+
+    if (errores > 0) {
+        std::cout << "  ERROR: " << errores << " lecturas decodificadas no coinciden con las originales" << std::endl;
+    }
+    double mibPorSeg = segCursor > 0 ? n * sizeof(T) / segCursor / (1024.0 * 1024.0) : 0.0;
+    std::cout << "  " << historial->bytesComprimidos() << " bytes para " << n << " lecturas ("
+              << std::setprecision(2) << static_cast<double>(historial->bytesComprimidos()) * 8.0 / (n > 0 ? n : 1)
+              << " bits/lectura), razon " << historial->razonCompresion() << ":1 frente a un arreglo y "
+              << historial->razonCompresion() * sizeof(Nodo<T>) / sizeof(T) << ":1 frente a ListaSensor; "
+              << std::setprecision(0) << mibPorSeg << " MiB/s decodificados" << std::endl;
+    if (suma < 0.0) std::cout << suma << std::endl; // evita que se descarte el cálculo
+
+    SilenciarSalida silencio;
+    delete historial;
+}
+
+/**
+ * @brief Comprime lecturas con su columna de marcas y verifica las ventanas de tiempo
+ * @param temperaturas Lecturas a comprimir
+ *
+ * Las marcas imitan la ingesta: una lectura cada 100 ms con hasta 200 µs
+ * de variación, y una de cada cuatro llega en la misma lectura del puerto
+ * que la anterior y comparte su marca.
+ */
+inline void medirMarcasComprimidas(const std::vector<float>& temperaturas) {
+    const long n = static_cast<long>(temperaturas.size());
+    std::vector<long long> marcas(temperaturas.size());
+    unsigned int semilla = 7;
+    long long marca = 1000000000LL;
+    for (long i = 0; i < n; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 8;
+        if (i == 0 || azar % 4 != 0) marca += 100000000LL + static_cast<long long>(azar % 200000u);
+        marcas[static_cast<std::size_t>(i)] = marca;
+    }
+
+    HistorialComprimido<float>* historial;
+    double segInsertar;
+    {
+        SilenciarSalida silencio;
+        historial = new HistorialComprimido<float>(true);
+        Cronometro reloj;
+        for (long i = 0; i < n; i++) {
+            historial->insertarEn(temperaturas[static_cast<std::size_t>(i)], marcas[static_cast<std::size_t>(i)]);
+        }
+        segInsertar = reloj.segundos();
+    }
+    reportarBench("historial_comprimido_marcas_insertar", n, static_cast<double>(n), segInsertar);
+
+    // Todas las lecturas con sus marcas, en orden
+    long errores = 0;
+    std::size_t i = 0;
+    Cronometro reloj;
+    historial->paraCadaBloqueEntre(marcas.front(), marcas.back() + 1,
+                                   [&](const long long* m, const float* d, int cantidad) {
+        for (int k = 0; k < cantidad; k++, i++) {
+            if (i >= marcas.size() || m[k] != marcas[i] || d[k] != temperaturas[i]) errores++;
+        }
+    });
+    double segRecorrer = reloj.segundos();
+    if (i != marcas.size()) errores++;
+    reportarBench("historial_comprimido_marcas_decodificar", n, static_cast<double>(n), segRecorrer);
+
+    // Una ventana en medio de la serie contra un recorrido directo
+    long long t0 = marcas[marcas.size() / 3];
+    long long t1 = marcas[marcas.size() / 3 * 2] + 1;
+    long esperadas = 0;
+    for (std::size_t k = 0; k < marcas.size(); k++) esperadas += marcas[k] >= t0 && marcas[k] < t1;
+    if (historial->resumenEntre(t0, t1).cantidad != esperadas) errores++;
+
+    if (errores > 0) {
+        std::cout << "  ERROR: " << errores << " lecturas o marcas decodificadas no coinciden con las originales" << std::endl;
+    }
+    std::cout << "  " << historial->bytesMarcas() << " bytes de marcas para " << n << " lecturas ("
+              << std::setprecision(2) << static_cast<double>(historial->bytesMarcas()) * 8.0 / (n > 0 ? n : 1)
+              << " bits/marca frente a 64), razon total " << historial->razonCompresion() << ":1" << std::endl;
+
+    SilenciarSalida silencio;
+    delete historial;
+}
+
+/**
+ * @brief Compresión de hasta 10M lecturas de temperatura (XOR) y presión (delta)
+ *
+ * Reporta la razón de compresión frente a un arreglo de T y frente a los
+ * nodos de ListaSensor, y la velocidad de decodificación con Cursor y con
+ * paraCadaBloque(), y el costo de la columna de marcas de tiempo. Antes
+ * de reportar se comprueba que la decodificación reproduzca exactamente
+ * las lecturas y marcas originales.
+ */
+inline void benchHistorialComprimido() {
+    if (!casoHabilitado("historial_comprimido")) return;
+
+    const long n = opcionesBench().maximo < 10000000L ? opcionesBench().maximo : 10000000L;
+    std::vector<float> temperaturas;
+    std::vector<int> presiones;
+    generarLecturasESP32(n, temperaturas, presiones);
+    medirHistorialComprimido("historial_comprimido_float", temperaturas);
+    medirHistorialComprimido("historial_comprimido_int", presiones);
+    medirMarcasComprimidas(temperaturas);
+}
+
+#endif
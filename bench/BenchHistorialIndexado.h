@@ -0,0 +1,181 @@
+#ifndef BENCHHISTORIALINDEXADO_H
+#define BENCHHISTORIALINDEXADO_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Bench.h"
+#include "BenchHistorialComprimido.h"
+#include "../ListaSensor.h"
+#include "../HistorialIndexado.h"
+#include "../SensorTemperatura.h"
+#include "../SensorPresion.h"
+
+/**
+ * @file BenchHistorialIndexado.h
+ * @brief Benchmarks del índice ordenado contra los recorridos lineales de ListaSensor
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Comprueba el índice contra la lista: conteos, orden de llegada y extracción
+ * @param temperaturas Lecturas de temperatura (con muchos valores repetidos)
+ * @param presiones Lecturas de presión entre 80 y 120
+ * @return Número de diferencias encontradas
+ */
+inline int verificarHistorialIndexado(const std::vector<float>& temperaturas, const std::vector<int>& presiones) {
+    int errores = 0;
+    HistorialIndexado<int> indice;
+    for (std::size_t i = 0; i < presiones.size(); i++) indice.insertar(presiones[i]);
+    int mayores = 0, entre = 0;
+    for (std::size_t i = 0; i < presiones.size(); i++) {
+        if (presiones[i] > 110) mayores++;
+        if (presiones[i] >= 90 && presiones[i] <= 110) entre++;
+    }
+    if (indice.contarMayoresQue(110) != mayores || indice.contarEntre(90, 110) != entre ||
+        indice.contarMenoresQue(90) + entre + mayores != indice.obtenerTamanio()) {
+        errores++;
+    }
+
+    // Mismas eliminaciones en la lista y en el índice: el orden de llegada debe coincidir
+    ListaSensor<float> lista;
+    HistorialIndexado<float> indexado;
+    for (std::size_t i = 0; i < temperaturas.size(); i++) {
+        lista.insertar(temperaturas[i]);
+        indexado.insertar(temperaturas[i]);
+    }
+    for (std::size_t i = 0; i < temperaturas.size(); i += 7) {
+        if (lista.eliminarValor(temperaturas[i]) != indexado.eliminarValor(temperaturas[i])) errores++;
+    }
+    std::vector<float> enLista(lista.begin(), lista.end());
+    std::vector<float> enIndice;
+    indexado.paraCadaBloque([&enIndice](const float* datos, int cantidad) {
+        enIndice.insert(enIndice.end(), datos, datos + cantidad);
+    });
+    if (enLista != enIndice) errores++;
+
+    std::sort(enLista.begin(), enLista.end());
+    for (std::size_t i = 0; i < enLista.size() && errores == 0; i++) {
+        if (indexado.extraerMinimo() != enLista[i]) errores++;
+    }
+    if (indexado.obtenerTamanio() != 0) errores++;
+    return errores;
+}
+
+/**
+ * @brief Compara ListaSensor contra HistorialIndexado en búsqueda, procesamiento y conteo
+ *
+ * 100k lecturas con el perfil del ESP32. Mide busqueda de umbrales
+ * ausentes, procesar un sensor de temperatura (quitar el mínimo, que
+ * en la lista cuesta un recorrido de eliminarValor) y contar presiones
+ * mayores que 110 (recorrido completo contra contarMayoresQue). Los
+ * recorridos de la lista se repiten menos veces para acotar el tiempo.
+ */
+inline void benchHistorialIndexado() {
+    if (!casoHabilitado("historial_indexado")) return;
+
+    const long n = opcionesBench().maximo < 100000L ? opcionesBench().maximo : 100000L;
+    std::vector<float> temperaturas;
+    std::vector<int> presiones;
+    generarLecturasESP32(n, temperaturas, presiones);
+
+    const long consultas = 100000L;
+    const long consultasLineales = 2000L;
+    const int procesados = 1000;
+    double segInsLista, segInsIndice, segBusLista, segBusIndice, segProcLista, segProcIndice, segContarLista, segContarIndice;
+    long encontrados = 0;
+    bool mismosMinimos = true;
+    {
+        SilenciarSalida silencio;
+        ListaSensor<float> lista;
+        Cronometro reloj;
+        for (long i = 0; i < n; i++) lista.insertar(temperaturas[static_cast<std::size_t>(i)]);
+        segInsLista = reloj.segundos();
+
+        HistorialIndexado<float> indexado;
+        reloj.reiniciar();
+        for (long i = 0; i < n; i++) indexado.insertar(temperaturas[static_cast<std::size_t>(i)]);
+        segInsIndice = reloj.segundos();
+
+        // Umbrales de alarma fuera del rango registrado: la lista recorre todo el historial
+        std::vector<float> umbrales(static_cast<std::size_t>(consultas));
+        unsigned long semilla = 77;
+        for (std::size_t c = 0; c < umbrales.size(); c++) {
+            semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+            umbrales[c] = 40.0f + static_cast<float>((semilla >> 33) % 20) / 10.0f;
+        }
+        reloj.reiniciar();
+        for (long c = 0; c < consultasLineales; c++) encontrados += lista.busqueda(umbrales[static_cast<std::size_t>(c)]);
+        segBusLista = reloj.segundos();
+
+        reloj.reiniciar();
+        for (long c = 0; c < consultas; c++) encontrados += indexado.busqueda(umbrales[static_cast<std::size_t>(c)]);
+        segBusIndice = reloj.segundos();
+
+        SensorTemperatura sensorLista("lista");
+        SensorTemperaturaIndexado sensorIndice("indexado");
+        for (long i = 0; i < n; i++) {
+            sensorLista.registrarLectura(temperaturas[static_cast<std::size_t>(i)]);
+            sensorIndice.registrarLectura(temperaturas[static_cast<std::size_t>(i)]);
+        }
+        reloj.reiniciar();
+        for (int p = 0; p < procesados; p++) sensorLista.procesarLectura(std::cout);
+        segProcLista = reloj.segundos();
+
+        reloj.reiniciar();
+        for (int p = 0; p < procesados; p++) sensorIndice.procesarLectura(std::cout);
+        segProcIndice = reloj.segundos();
+
+        const EstadisticasLecturas& a = sensorLista.obtenerEstadisticas();
+        const EstadisticasLecturas& b = sensorIndice.obtenerEstadisticas();
+        mismosMinimos = a.cantidad == b.cantidad && a.minimo == b.minimo && std::fabs(a.suma - b.suma) < 1e-6 * std::fabs(a.suma) &&
+                        sensorLista.minimoHistorial() == sensorIndice.minimoHistorial();
+
+        SensorPresion presionLista("lista");
+        SensorPresionIndexado presionIndice("indexado");
+        for (long i = 0; i < n; i++) {
+            presionLista.registrarLectura(presiones[static_cast<std::size_t>(i)]);
+            presionIndice.registrarLectura(presiones[static_cast<std::size_t>(i)]);
+        }
+        long conteoLista = 0, conteoIndice = 0;
+        reloj.reiniciar();
+        for (long c = 0; c < consultasLineales; c++) {
+            presionLista.paraCadaBloque([&conteoLista](const int* datos, int cantidad) {
+                for (int i = 0; i < cantidad; i++) conteoLista += datos[i] > 110;
+            });
+        }
+        segContarLista = reloj.segundos();
+
+        reloj.reiniciar();
+        for (long c = 0; c < consultas; c++) conteoIndice += presionIndice.contarMayoresQue(110);
+        segContarIndice = reloj.segundos();
+        if (conteoLista / consultasLineales != conteoIndice / consultas) mismosMinimos = false;
+    }
+    reportarBench("historial_indexado_lista_insertar", n, static_cast<double>(n), segInsLista);
+    reportarBench("historial_indexado_insertar", n, static_cast<double>(n), segInsIndice);
+    reportarBench("historial_indexado_lista_buscar", n, static_cast<double>(consultasLineales), segBusLista);
+    reportarBench("historial_indexado_buscar", n, static_cast<double>(consultas), segBusIndice);
+    reportarBench("historial_indexado_lista_procesar", n, static_cast<double>(procesados), segProcLista);
+    reportarBench("historial_indexado_procesar", n, static_cast<double>(procesados), segProcIndice);
+    reportarBench("historial_indexado_lista_contar", n, static_cast<double>(consultasLineales), segContarLista);
+    reportarBench("historial_indexado_contar", n, static_cast<double>(consultas), segContarIndice);
+    if (encontrados != 0) {
+        std::cout << "  ERROR: se encontraron " << encontrados << " umbrales que no estan en el historial" << std::endl;
+    }
+    if (!mismosMinimos) {
+        std::cout << "  ERROR: el sensor indexado no coincide con el de lista" << std::endl;
+    }
+
+    std::vector<float> tVerificar(temperaturas.begin(), temperaturas.begin() + (n < 20000L ? n : 20000L));
+    int errores;
+    {
+        SilenciarSalida silencio;
+        errores = verificarHistorialIndexado(tVerificar, presiones);
+    }
+    if (errores != 0) {
+        std::cout << "  ERROR: " << errores << " diferencias entre el indice y los recorridos lineales" << std::endl;
+    }
+}
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef BENCHINGESTA_H
+#define BENCHINGESTA_H
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include "Bench.h"
+#include "BenchLectorLineas.h"
+#include "../ColaSPSC.h"
+#include "../IngestaESP32.h"
+
+/**
+ * @file BenchIngesta.h
+ * @brief Benchmarks de la cola SPSC y de la ingesta en dos hilos, con uno o varios puertos
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @class FuenteMemoria
+ * @brief FuenteSerial que entrega una captura en memoria lo más rápido posible
+ */
+class FuenteMemoria : public FuenteSerial {
+    private:
+        const std::string& captura; ///< Bytes a repetir
+        std::size_t total;          ///< Bytes a entregar en total
+        std::size_t entregados;     ///< Bytes ya entregados
+
+    public:
+        FuenteMemoria(const std::string& datos, std::size_t bytes) : captura(datos), total(bytes), entregados(0) {}
+
+        bool abrir() override { return true; }
+
+        long leer(char* buffer, std::size_t capacidad, int) override {
+            if (entregados >= total) return -1;
+            std::size_t desde = entregados % captura.size();
+            std::size_t n = captura.size() - desde;
+            if (n > capacidad) n = capacidad;
+            if (n > total - entregados) n = total - entregados;
+            std::memcpy(buffer, captura.data() + desde, n);
+            entregados += n;
+            return static_cast<long>(n);
+        }
+
+        void cerrar() override {}
+
+        const char* obtenerRuta() const override { return "memoria"; }
+};
+
+/**
+ * @class ColaMutex
+ * @brief Cola con std::mutex + std::deque, para comparar contra ColaSPSC
+ */
+template <typename T>
+class ColaMutex {
+    private:
+        std::mutex candado;
+        std::deque<T> elementos;
+        std::size_t capacidad;
+
+    public:
+        explicit ColaMutex(std::size_t capacidadMaxima) : capacidad(capacidadMaxima) {}
+
+        bool intentarEncolar(const T& elemento) {
+            std::lock_guard<std::mutex> guarda(candado);
+            if (elementos.size() == capacidad) return false;
+            elementos.push_back(elemento);
+            return true;
+        }
+
+        std::size_t extraerLote(T* destino, std::size_t maximo) {
+            std::lock_guard<std::mutex> guarda(candado);
+            std::size_t n = elementos.size() < maximo ? elementos.size() : maximo;
+            for (std::size_t i = 0; i < n; i++) {
+                destino[i] = elementos.front();
+                elementos.pop_front();
+            }
+            return n;
+        }
+};
+
+/**
+ * @brief Pasa n registros de un hilo productor a uno consumidor
+ * @param cola Cola a medir
+ * @param n Registros a pasar
+ * @param reintentos Veces que el productor encontró la cola llena
+ * @return Segundos empleados
+ *
+ * Ambos lados ceden el procesador al encontrar la cola llena o vacía,
+ * para que la medición tenga sentido también con un solo núcleo.
+ */
+template <typename Cola>
+double medirTraspaso(Cola& cola, long n, long& reintentos) {
+    RegistroLectura registro;
+    std::memset(&registro, 0, sizeof(registro));
+    reintentos = 0;
+    long recibidos = 0;
+    Cronometro reloj;
+    std::thread consumidor([&cola, n, &recibidos]() {
+        RegistroLectura lote[IngestaESP32::TAMANIO_LOTE];
+        while (recibidos < n) {
+            std::size_t extraidos = cola.extraerLote(lote, IngestaESP32::TAMANIO_LOTE);
+            if (extraidos == 0) std::this_thread::yield();
+            recibidos += static_cast<long>(extraidos);
+        }
+    });
+    for (long i = 0; i < n; i++) {
+        registro.presion = static_cast<int>(i);
+        while (!cola.intentarEncolar(registro)) {
+            reintentos++;
+            std::this_thread::yield();
+        }
+    }
+    consumidor.join();
+    return reloj.segundos();
+}
+
+/**
+ * @brief Mide el traspaso entre hilos con ColaSPSC y con mutex + deque
+ */
+inline void benchColaSPSC() {
+    if (!casoHabilitado("cola_spsc")) return;
+
+    long n = opcionesBench().maximo < 10000000L ? opcionesBench().maximo : 10000000L;
+    long reintentos;
+    ColaSPSC<RegistroLectura> spsc(16384);
+    double segSpsc = medirTraspaso(spsc, n, reintentos);
+    reportarBench("cola_spsc_traspaso", n, static_cast<double>(n), segSpsc);
+    std::cout << "  cola llena " << reintentos << " veces" << std::endl;
+
+    ColaMutex<RegistroLectura> conMutex(16384);
+    double segMutex = medirTraspaso(conMutex, n, reintentos);
+    reportarBench("cola_mutex_traspaso", n, static_cast<double>(n), segMutex);
+    std::cout << "  cola llena " << reintentos << " veces" << std::endl;
+}
+
+/**
+ * @brief Ingesta completa: fuente en memoria -> lector -> cola -> sensores
+ *
+ * La fuente entrega bytes sin pausas, muy por encima de cualquier puerto
+ * serial, para encontrar el límite de cada hilo. Las lecturas que el
+ * consumidor no alcanza a aplicar se descartan y se reportan.
+ */
+inline void benchIngestaESP32() {
+    if (!casoHabilitado("ingesta_esp32")) return;
+
+    std::size_t total = static_cast<std::size_t>(opcionesBench().maximo) * 8;
+    if (total > 64u * 1024u * 1024u) total = 64u * 1024u * 1024u;
+    std::string captura = generarCapturaESP32(4u * 1024u * 1024u);
+
+    long lineas, registradas, descartadas, profundidad;
+    double segundos;
+    {
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        EnrutadorESP32 enrutador(lista);
+        FuenteMemoria fuente(captura, total);
+        IngestaESP32 ingesta(fuente, enrutador, 16384);
+        Cronometro reloj;
+        ingesta.iniciar();
+        while (!ingesta.lecturaTerminada()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ingesta.detener();
+        segundos = reloj.segundos();
+        const ContadoresIngesta& c = ingesta.obtenerContadores();
+        lineas = c.lineas;
+        registradas = c.registradas;
+        descartadas = c.descartadas;
+        profundidad = c.profundidadMaxima;
+    }
+    reportarBench("ingesta_esp32_lineas", lineas, static_cast<double>(lineas), segundos);
+    reportarBench("ingesta_esp32_registradas", registradas, static_cast<double>(registradas), segundos);
+    std::cout << "  " << std::setprecision(1) << total / segundos / 1e6 << " MB/s de entrada ("
+              << std::setprecision(0) << total / segundos / 11520.0 << "x un puerto a 115200 baudios), "
+              << descartadas << " descartadas, profundidad maxima " << profundidad << std::endl;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Pasa una captura por varios pipes leídos por una sola ingesta
+ * @param captura Bytes que recibe cada puerto
+ * @param puertos Número de pipes
+ * @param segundos Tiempo desde iniciar hasta que se aplicó la última lectura
+ * @return Diferencias entre lo escrito y los contadores de cada puerto (-1 si no se pudieron crear los pipes)
+ *
+ * Cada pipe se abre como puerto con FuenteSerialPosix (por /dev/fd), así
+ * que con varios puertos la ingesta los espera con el MultiplexorPuertos.
+ * Un hilo escribe la captura en trozos de 4 KiB repartidos entre los
+ * pipes y los cierra al final.
+ */
+inline int medirIngestaPipes(const std::string& captura, std::size_t puertos, double& segundos) {
+    std::vector<int> escritura;
+    std::vector<std::unique_ptr<FuenteSerial> > fuentes;
+    std::vector<FuenteSerial*> abiertas;
+    for (std::size_t i = 0; i < puertos; i++) {
+        int extremos[2];
+        if (::pipe(extremos) != 0) break;
+        char ruta[32];
+        std::snprintf(ruta, sizeof(ruta), "/dev/fd/%d", extremos[0]);
+        std::unique_ptr<FuenteSerial> fuente(new FuenteSerialPosix(ruta, 115200));
+        bool abierta = fuente->abrir();
+        ::close(extremos[0]);
+        if (!abierta) {
+            ::close(extremos[1]);
+            break;
+        }
+        escritura.push_back(extremos[1]);
+        abiertas.push_back(fuente.get());
+        fuentes.push_back(std::move(fuente));
+    }
+    if (abiertas.size() != puertos) {
+        for (std::size_t i = 0; i < escritura.size(); i++) ::close(escritura[i]);
+        return -1;
+    }
+
+    long lineasPorPuerto = static_cast<long>(std::count(captura.begin(), captura.end(), '\n'));
+    int diferencias = 0;
+    {
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        EnrutadorESP32 enrutador(lista);
+        IngestaESP32 ingesta(abiertas, enrutador, 16384);
+        ingesta.esperarSiColaLlena(true);
+        Cronometro reloj;
+        ingesta.iniciar();
+        std::thread escritor([&captura, &escritura]() {
+            for (std::size_t desde = 0; desde < captura.size(); desde += 4096) {
+                std::size_t n = captura.size() - desde < 4096 ? captura.size() - desde : 4096;
+                for (std::size_t i = 0; i < escritura.size(); i++) {
+                    for (std::size_t escritos = 0; escritos < n; ) {
+                        ssize_t r = ::write(escritura[i], captura.data() + desde + escritos, n - escritos);
+                        if (r <= 0) break;
+                        escritos += static_cast<std::size_t>(r);
+                    }
+                }
+            }
+            for (std::size_t i = 0; i < escritura.size(); i++) ::close(escritura[i]);
+        });
+        while (!ingesta.lecturaTerminada()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ingesta.detener();
+        segundos = reloj.segundos();
+        escritor.join();
+        for (std::size_t i = 0; i < ingesta.obtenerPuertos(); i++) {
+            const ContadoresPuerto& c = ingesta.obtenerContadoresPuerto(i);
+            if (c.bytes != static_cast<long>(captura.size()) || c.lineas != lineasPorPuerto || c.errores != 0 || !c.cerrado) {
+                diferencias++;
+            }
+        }
+        if (ingesta.obtenerContadores().registradas != lineasPorPuerto * static_cast<long>(puertos)) diferencias++;
+    }
+    return diferencias;
+}
+
+/**
+ * @brief Ingesta de 1 y de 8 puertos con un solo hilo lector
+ *
+ * Con 8 puertos el lector espera en epoll (poll fuera de Linux) y lee
+ * solo los pipes con datos. Se reportan líneas por segundo en total, y
+ * se verifica que los contadores de cada puerto coincidan con lo escrito.
+ */
+inline void benchIngestaMultipuerto() {
+    if (!casoHabilitado("ingesta_multipuerto")) return;
+
+    std::size_t porPuerto = static_cast<std::size_t>(opcionesBench().maximo) * 4;
+    if (porPuerto > 2u * 1024u * 1024u) porPuerto = 2u * 1024u * 1024u;
+    std::string captura = generarCapturaESP32(porPuerto);
+    long lineas = static_cast<long>(std::count(captura.begin(), captura.end(), '\n'));
+
+    const std::size_t casos[] = { 1, 8 };
+    for (std::size_t c = 0; c < 2; c++) {
+        double segundos = 0.0;
+        int diferencias = medirIngestaPipes(captura, casos[c], segundos);
+        char nombre[48];
+        std::snprintf(nombre, sizeof(nombre), "ingesta_multipuerto_%lu", static_cast<unsigned long>(casos[c]));
+        long total = lineas * static_cast<long>(casos[c]);
+        if (diferencias < 0) {
+            std::cout << "  ERROR: no se pudieron abrir los pipes de " << nombre << std::endl;
+            continue;
+        }
+        reportarBench(nombre, total, static_cast<double>(total), segundos);
+        if (diferencias != 0) {
+            std::cout << "  ERROR: " << diferencias << " puertos con contadores distintos a lo escrito" << std::endl;
+        }
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef BENCHINSTANTANEA_H
+#define BENCHINSTANTANEA_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "../Instantanea.h"
+
+/**
+ * @file BenchInstantanea.h
+ * @brief Verificación de ida y vuelta y tiempo de arranque de las instantáneas
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Copia las lecturas de un sensor a un arreglo
+ * @param sensor Sensor de alguno de los tipos que usa la verificación
+ * @param temperaturas Destino si es de temperatura
+ * @param presiones Destino si es de presión
+ */
+inline void lecturasDeSensor(const SensorBase* sensor, std::vector<float>& temperaturas, std::vector<int>& presiones) {
+    temperaturas.clear();
+    presiones.clear();
+    if (const SensorTemperaturaInstantanea* t = dynamic_cast<const SensorTemperaturaInstantanea*>(sensor)) {
+        t->paraCadaBloque([&temperaturas](const float* d, int n) { temperaturas.insert(temperaturas.end(), d, d + n); });
+    } else if (const SensorPresionInstantanea* p = dynamic_cast<const SensorPresionInstantanea*>(sensor)) {
+        p->paraCadaBloque([&presiones](const int* d, int n) { presiones.insert(presiones.end(), d, d + n); });
+    } else if (const SensorTemperatura* t2 = dynamic_cast<const SensorTemperatura*>(sensor)) {
+        t2->paraCadaBloque([&temperaturas](const float* d, int n) { temperaturas.insert(temperaturas.end(), d, d + n); });
+    } else if (const SensorPresion* p2 = dynamic_cast<const SensorPresion*>(sensor)) {
+        p2->paraCadaBloque([&presiones](const int* d, int n) { presiones.insert(presiones.end(), d, d + n); });
+    } else if (const SensorTemperaturaComprimido* t3 = dynamic_cast<const SensorTemperaturaComprimido*>(sensor)) {
+        t3->paraCadaBloque([&temperaturas](const float* d, int n) { temperaturas.insert(temperaturas.end(), d, d + n); });
+    } else if (const SensorPresionCircular* p3 = dynamic_cast<const SensorPresionCircular*>(sensor)) {
+        p3->paraCadaBloque([&presiones](const int* d, int n) { presiones.insert(presiones.end(), d, d + n); });
+    }
+}
+
+/**
+ * @brief Llena una lista con sensores de temperatura y presión
+ * @param lista Lista destino
+ * @param sensores Número de sensores (la mitad de cada tipo)
+ * @param lecturasPorSensor Lecturas de cada sensor
+ */
+inline void llenarListaInstantanea(ListaGeneral& lista, int sensores, long lecturasPorSensor) {
+    char nombre[32];
+    for (int s = 0; s < sensores; s++) {
+        std::snprintf(nombre, sizeof(nombre), "S-%03d", s);
+        if (s % 2 == 0) {
+            SensorTemperatura* sensor = new SensorTemperatura(nombre);
+            for (long i = 0; i < lecturasPorSensor; i++) sensor->registrarLectura(static_cast<float>((i * 7 + s) % 400) * 0.1f);
+            lista.insertarSensor(sensor);
+        } else {
+            SensorPresion* sensor = new SensorPresion(nombre);
+            for (long i = 0; i < lecturasPorSensor; i++) sensor->registrarLectura(80 + static_cast<int>((i * 3 + s) % 41));
+            lista.insertarSensor(sensor);
+        }
+    }
+}
+
+/**
+ * @brief Guarda una lista mixta, la carga y compara sensor por sensor
+ * @param ruta Archivo temporal
+ * @return Número de diferencias encontradas
+ *
+ * Incluye un sensor comprimido y uno circular (que guardan lo que
+ * conservan y deben volver con su mismo historial y capacidad) y
+ * comprueba que eliminar una lectura cargada copie las lecturas sin
+ * alterar las demás.
+ */
+inline long verificarIdaYVueltaInstantanea(const char* ruta) {
+    long errores = 0;
+    ListaGeneral original;
+    llenarListaInstantanea(original, 4, 3000);
+    SensorTemperaturaComprimido* comprimido = new SensorTemperaturaComprimido("C-000");
+    for (int i = 0; i < 2500; i++) comprimido->registrarLectura(20.0f + static_cast<float>(i % 13) * 0.1f);
+    original.insertarSensor(comprimido);
+    SensorPresionCircular* circular = new SensorPresionCircular("R-000", 100);
+    for (int i = 0; i < 250; i++) circular->registrarLectura(i);
+    original.insertarSensor(circular);
+    original.insertarSensor(new SensorTemperatura("V-000"));
+    if (!guardarInstantanea(original, ruta)) return 1;
+
+    ListaGeneral cargada;
+    int cargados = 0;
+    if (!cargarInstantanea(ruta, cargada, cargados) || cargados != original.obtenerTamanio()) return 1;
+
+    std::vector<float> tOriginal, tCargada;
+    std::vector<int> pOriginal, pCargada;
+    ListaGeneral::iterator a = original.begin();
+    ListaGeneral::iterator b = cargada.begin();
+    for (; a != original.end() && b != cargada.end(); ++a, ++b) {
+        lecturasDeSensor(*a, tOriginal, pOriginal);
+        lecturasDeSensor(*b, tCargada, pCargada);
+        if (std::strcmp((*a)->obtenerNombre(), (*b)->obtenerNombre()) != 0 ||
+            tOriginal != tCargada || pOriginal != pCargada ||
+            (*a)->obtenerEstadisticas().cantidad != (*b)->obtenerEstadisticas().cantidad ||
+            (*a)->obtenerEstadisticas().suma != (*b)->obtenerEstadisticas().suma) {
+            errores++;
+        }
+    }
+    if (a != original.end() || b != cargada.end()) errores++;
+
+    // El circular sigue descartando pasadas sus 100 lecturas
+    if (dynamic_cast<SensorTemperaturaComprimido*>(cargada.buscarSensor("C-000")) == nullptr) errores++;
+    SensorPresionCircular* circularCargado = dynamic_cast<SensorPresionCircular*>(cargada.buscarSensor("R-000"));
+    if (circularCargado == nullptr) return errores + 1;
+    for (int i = 0; i < 50; i++) circularCargado->registrarLectura(1000 + i);
+    if (circularCargado->obtenerHistorial().obtenerTamanio() != 100 || circularCargado->obtenerEstadisticas().cantidad != 100) {
+        errores++;
+    }
+
+    // Copia al escribir: procesar el sensor cargado elimina su mínimo
+    SensorTemperaturaInstantanea* primero = dynamic_cast<SensorTemperaturaInstantanea*>(*cargada.begin());
+    if (primero == nullptr) return errores + 1;
+    primero->procesarLectura();
+    primero->registrarLectura(99.5f);
+    lecturasDeSensor(primero, tCargada, pCargada);
+    lecturasDeSensor(*original.begin(), tOriginal, pOriginal);
+    std::vector<float>::iterator minimo = tOriginal.begin();
+    for (std::vector<float>::iterator it = tOriginal.begin(); it != tOriginal.end(); ++it) {
+        if (*it < *minimo) minimo = it;
+    }
+    tOriginal.erase(minimo);
+    tOriginal.push_back(99.5f);
+    if (tOriginal != tCargada) errores++;
+    return errores;
+}
+
+/**
+ * @brief Comprueba que se rechace una entrada cuyas lecturas caen fuera del archivo
+ * @param ruta Archivo temporal
+ * @return true si solo se cargó el sensor con la entrada intacta
+ *
+ * El desplazamiento dañado está cerca de 2^64, de modo que sumarle las
+ * lecturas daría la vuelta y pasaría una comprobación ingenua.
+ */
+inline bool verificarInstantaneaDaniada(const char* ruta) {
+    {
+        ListaGeneral original;
+        llenarListaInstantanea(original, 2, 100);
+        if (!guardarInstantanea(original, ruta)) return false;
+    }
+    std::fstream archivo(ruta, std::ios::binary | std::ios::in | std::ios::out);
+    EntradaInstantanea entrada;
+    archivo.seekg(sizeof(CabeceraInstantanea));
+    archivo.read(reinterpret_cast<char*>(&entrada), sizeof(entrada));
+    entrada.desplazamiento = 0xFFFFFFFFFFFFFFF8ULL;
+    archivo.seekp(sizeof(CabeceraInstantanea));
+    archivo.write(reinterpret_cast<const char*>(&entrada), sizeof(entrada));
+    archivo.close();
+    if (!archivo) return false;
+
+    ListaGeneral cargada;
+    int cargados = 0;
+    return cargarInstantanea(ruta, cargada, cargados) && cargados == 1 && cargada.buscarSensor("S-000") == nullptr;
+}
+
+/**
+ * @brief Guarda una lista cargada encima de la instantánea de la que se cargó
+ * @param ruta Archivo temporal
+ * @return Número de diferencias encontradas
+ *
+ * Es lo que hace la opción 6 tras arrancar con --instantanea. Antes de
+ * guardar se sueltan las proyecciones como en Windows (donde el archivo
+ * proyectado no puede reemplazarse), así que también comprueba que la
+ * copia conserve las lecturas.
+ */
+inline long verificarGuardarSobreCargada(const char* ruta) {
+    long errores = 0;
+    ListaGeneral original;
+    llenarListaInstantanea(original, 4, 500);
+    if (!guardarInstantanea(original, ruta)) return 1;
+
+    ListaGeneral cargada;
+    int cargados = 0;
+    if (!cargarInstantanea(ruta, cargada, cargados)) return 1;
+    std::vector<float> tOriginal, tCargada;
+    std::vector<int> pOriginal, pCargada;
+    for (SensorBase* sensor : cargada) {
+        sensor->soltarArchivo();
+        SensorTemperaturaInstantanea* t = dynamic_cast<SensorTemperaturaInstantanea*>(sensor);
+        SensorPresionInstantanea* p = dynamic_cast<SensorPresionInstantanea*>(sensor);
+        if ((t != nullptr && t->obtenerHistorial().leeDeInstantanea()) ||
+            (p != nullptr && p->obtenerHistorial().leeDeInstantanea())) {
+            errores++;
+        }
+    }
+    if (!guardarInstantanea(cargada, ruta)) return errores + 1;
+
+    ListaGeneral recargada;
+    if (!cargarInstantanea(ruta, recargada, cargados) || cargados != original.obtenerTamanio()) return errores + 1;
+    ListaGeneral::iterator a = original.begin();
+    ListaGeneral::iterator b = recargada.begin();
+    for (; a != original.end() && b != recargada.end(); ++a, ++b) {
+        lecturasDeSensor(*a, tOriginal, pOriginal);
+        lecturasDeSensor(*b, tCargada, pCargada);
+        if (tOriginal != tCargada || pOriginal != pCargada) errores++;
+    }
+    return errores;
+}
+
+/**
+ * @brief Tiempo de carga de una instantánea frente a reconstruir las listas
+ * @param ruta Archivo temporal
+ * @param sensores Número de sensores
+ * @param lecturasPorSensor Lecturas de cada sensor
+ */
+inline void medirArranqueInstantanea(const char* ruta, int sensores, long lecturasPorSensor) {
+    long total = static_cast<long>(sensores) * lecturasPorSensor;
+    {
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        llenarListaInstantanea(lista, sensores, lecturasPorSensor);
+        guardarInstantanea(lista, ruta);
+    }
+
+    const int repeticiones = 20;
+    double segCarga;
+    {
+        SilenciarSalida silencio;
+        Cronometro reloj;
+        for (int r = 0; r < repeticiones; r++) {
+            ListaGeneral lista;
+            int cargados = 0;
+            cargarInstantanea(ruta, lista, cargados);
+        }
+        segCarga = reloj.segundos();
+    }
+    reportarBench("instantanea_cargar", total, repeticiones, segCarga);
+
+    // Referencia: leer las lecturas y volver a registrarlas en ListaSensor
+    double segReconstruir;
+    {
+        SilenciarSalida silencio;
+        Cronometro reloj;
+        ListaGeneral cargada;
+        int cargados = 0;
+        cargarInstantanea(ruta, cargada, cargados);
+        ListaGeneral reconstruida;
+        for (SensorBase* sensor : cargada) {
+            if (SensorTemperaturaInstantanea* t = dynamic_cast<SensorTemperaturaInstantanea*>(sensor)) {
+                SensorTemperatura* copia = new SensorTemperatura(t->obtenerNombre());
+                t->paraCadaBloque([copia](const float* d, int n) { for (int i = 0; i < n; i++) copia->registrarLectura(d[i]); });
+                reconstruida.insertarSensor(copia);
+            } else if (SensorPresionInstantanea* p = dynamic_cast<SensorPresionInstantanea*>(sensor)) {
+                SensorPresion* copia = new SensorPresion(p->obtenerNombre());
+                p->paraCadaBloque([copia](const int* d, int n) { for (int i = 0; i < n; i++) copia->registrarLectura(d[i]); });
+                reconstruida.insertarSensor(copia);
+            }
+        }
+        segReconstruir = reloj.segundos();
+    }
+    reportarBench("instantanea_reconstruir", total, 1, segReconstruir);
+}
+
+/**
+ * @brief Ida y vuelta de una instantánea y arranque con 1K, 100K y 10M lecturas
+ *
+ * La carga solo lee la tabla de sensores, así que su tiempo debe ser el
+ * mismo para cualquier cantidad de lecturas; reconstruir las listas, en
+ * cambio, crece con ellas.
+ */
+inline void benchInstantanea() {
+    if (!casoHabilitado("instantanea")) return;
+
+    const char* ruta = "bench_instantanea.iot";
+    long errores;
+    {
+        SilenciarSalida silencio;
+        errores = verificarIdaYVueltaInstantanea(ruta);
+    }
+    if (errores > 0) {
+        std::cout << "  ERROR: " << errores << " sensores no coinciden tras guardar y cargar la instantanea" << std::endl;
+    }
+    bool rechazada;
+    {
+        SilenciarSalida silencio;
+        rechazada = verificarInstantaneaDaniada(ruta);
+    }
+    if (!rechazada) {
+        std::cout << "  ERROR: se cargo una entrada de instantanea con lecturas fuera del archivo" << std::endl;
+    }
+    {
+        SilenciarSalida silencio;
+        errores = verificarGuardarSobreCargada(ruta);
+    }
+    if (errores > 0) {
+        std::cout << "  ERROR: " << errores << " sensores no coinciden tras guardar encima de la instantanea cargada" << std::endl;
+    }
+
+    const int sensores = 16;
+    const long maximo = opcionesBench().maximo;
+    const long tamanios[] = { 1000L, 100000L, 10000000L };
+    for (int i = 0; i < 3; i++) {
+        long total = tamanios[i] < maximo ? tamanios[i] : maximo;
+        medirArranqueInstantanea(ruta, sensores, total / sensores);
+        if (total == maximo) break;
+    }
+    std::remove(ruta);
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef BENCHLECTORLINEAS_H
+#define BENCHLECTORLINEAS_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "../LectorLineas.h"
+#include "../ProtocoloESP32.h"
+
+/**
+ * @file BenchLectorLineas.h
+ * @brief Benchmark de separación y parseo de líneas del ESP32
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Genera una captura sintética con el formato del firmware
+ * @param bytes Tamaño aproximado de la captura
+ * @return Texto con líneas TEMP/PRES terminadas en \r\n
+ */
+inline std::string generarCapturaESP32(std::size_t bytes) {
+    std::string captura;
+    captura.reserve(bytes + 64);
+    char linea[64];
+    unsigned long semilla = 7;
+    while (captura.size() < bytes) {
+        semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+        unsigned long r = semilla >> 33;
+        int n = (r & 1) ? std::snprintf(linea, sizeof(linea), "TEMP,T-%03lu,%lu.%02lu\r\n", r % 16, 20 + r % 15, r % 100)
+                        : std::snprintf(linea, sizeof(linea), "PRES,P-%03lu,%lu\r\n", r % 16, 80 + r % 41);
+        captura.append(linea, n);
+    }
+    return captura;
+}
+
+/**
+ * @brief Procesamiento original: std::string + substr + stof/stoi
+ * @return Lecturas reconocidas
+ */
+inline long procesarCapturaConString(const std::string& captura, std::size_t total) {
+    std::string datosAcumulados;
+    long lecturas = 0;
+    double control = 0.0;
+    for (std::size_t enviado = 0; enviado < total; ) {
+        std::size_t desde = enviado % captura.size();
+        std::size_t n = captura.size() - desde < 255 ? captura.size() - desde : 255;
+        datosAcumulados.append(captura, desde, n);
+        enviado += n;
+
+        size_t pos;
+        while ((pos = datosAcumulados.find('\n')) != std::string::npos) {
+            std::string linea = datosAcumulados.substr(0, pos);
+            datosAcumulados = datosAcumulados.substr(pos + 1);
+            if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+            if (linea.find("TEMP,") == 0 || linea.find("PRES,") == 0) {
+                std::string valorStr = linea.substr(linea.find_last_of(",") + 1);
+                control += linea[0] == 'T' ? std::stof(valorStr) : std::stoi(valorStr);
+                lecturas++;
+            }
+        }
+    }
+    return control > 0 ? lecturas : 0;
+}
+
+/**
+ * @brief Procesamiento con LectorLineas + parsearLineaESP32
+ * @return Lecturas reconocidas
+ */
+inline long procesarCapturaConLector(const std::string& captura, std::size_t total) {
+    LectorLineas lector(4096);
+    long lecturas = 0;
+    double control = 0.0;
+    for (std::size_t enviado = 0; enviado < total; ) {
+        std::size_t disponible;
+        char* zona = lector.zonaEscritura(disponible);
+        std::size_t desde = enviado % captura.size();
+        std::size_t n = captura.size() - desde < disponible ? captura.size() - desde : disponible;
+        std::memcpy(zona, captura.data() + desde, n);
+        lector.confirmarEscritura(n);
+        enviado += n;
+
+        VistaCadena linea;
+        while (lector.siguienteLinea(linea)) {
+            LecturaESP32 lectura;
+            if (parsearLineaESP32(linea, lectura) == PARSEO_OK) {
+                control += lectura.tipo == LECTURA_TEMPERATURA ? lectura.temperatura : lectura.presion;
+                lecturas++;
+            }
+        }
+    }
+    return control > 0 ? lecturas : 0;
+}
+
+/**
+ * @brief Alimenta cientos de MB de salida del ESP32 por el separador de líneas
+ *
+ * Reporta líneas por segundo, MB/s y asignaciones de memoria por línea
+ * (que deben ser 0 con LectorLineas).
+ */
+inline void benchLectorLineas() {
+    if (!casoHabilitado("lineas_esp32")) return;
+
+    std::size_t total = static_cast<std::size_t>(opcionesBench().maximo) * 32;
+    if (total > 512u * 1024u * 1024u) total = 512u * 1024u * 1024u;
+    std::string captura = generarCapturaESP32(4u * 1024u * 1024u);
+
+    std::size_t totalString = total / 8;
+    long asignaciones = contadorAsignaciones();
+    Cronometro reloj;
+    long lineasString = procesarCapturaConString(captura, totalString);
+    double segString = reloj.segundos();
+    long asignacionesString = contadorAsignaciones() - asignaciones;
+
+    asignaciones = contadorAsignaciones();
+    reloj.reiniciar();
+    long lineasLector = procesarCapturaConLector(captura, total);
+    double segLector = reloj.segundos();
+    long asignacionesLector = contadorAsignaciones() - asignaciones;
+
+    reportarBench("lineas_esp32_string", lineasString, static_cast<double>(lineasString), segString);
+    reportarBench("lineas_esp32_lector", lineasLector, static_cast<double>(lineasLector), segLector);
+    std::cout << "  string: " << std::setprecision(1) << totalString / segString / 1e6 << " MB/s, "
+              << std::setprecision(2) << static_cast<double>(asignacionesString) / lineasString << " asignaciones/linea" << std::endl;
+    std::cout << "  lector: " << std::setprecision(1) << total / segLector / 1e6 << " MB/s, "
+              << std::setprecision(2) << static_cast<double>(asignacionesLector) / lineasLector << " asignaciones/linea ("
+              << asignacionesLector << " en total)" << std::endl;
+}
+
+#endif
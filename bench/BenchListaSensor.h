@@ -0,0 +1,471 @@
+#ifndef BENCHLISTASENSOR_H
+#define BENCHLISTASENSOR_H
+
+#include "Bench.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../ListaSensor.h"
+#include "../ListaSensorDesenrollada.h"
+#include "../PoliticaRetencion.h"
+
+/**
+ * @file BenchListaSensor.h
+ * @brief Benchmarks de inserción, búsqueda, eliminación, liberación y recorrido de los historiales
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Mide el throughput de inserción a medida que crece la lista
+ *
+ * Inserta hasta el máximo configurado y reporta el costo por inserción
+ * en cada tramo de crecimiento (1e3, 1e4, ...). Con la inserción por la
+ * cola el costo por nodo debe mantenerse plano.
+ */
+inline void benchInsercionListaSensor() {
+    if (!casoHabilitado("lista_sensor_insertar")) return;
+
+    const long maximo = opcionesBench().maximo;
+    ListaSensor<float> lista;
+    long insertados = 0;
+
+    for (long tramo = 1000; tramo <= maximo; tramo *= 10) {
+        long antes = insertados;
+        double segundos;
+        {
+            SilenciarSalida silencio;
+            Cronometro reloj;
+            while (insertados < tramo) {
+                lista.insertar(static_cast<float>(insertados));
+                insertados++;
+            }
+            segundos = reloj.segundos();
+        }
+        reportarBench("lista_sensor_insertar", tramo, static_cast<double>(insertados - antes), segundos);
+    }
+
+    // La liberación también imprime por nodo
+    SilenciarSalida silencio;
+    lista = ListaSensor<float>();
+}
+
+/**
+ * @brief Mide búsqueda, eliminación y recorrido de ListaSensor en un tamaño
+ * @param n Lecturas en la lista
+ *
+ * Las consultas se reparten para que cada tamaño recorra unos 2e7 nodos,
+ * así el costo por operación crece con n pero el tiempo total no.
+ */
+inline void medirOperacionesListaSensor(long n) {
+    const long presupuesto = 20000000L;
+    long consultas = presupuesto / n > 5 ? presupuesto / n : 5;
+    long eliminaciones = consultas < n / 2 ? consultas : n / 2;
+    long recorridos = presupuesto / n > 1 ? presupuesto / n : 1;
+    double segBuscar, segAusente, segEliminar, segRecorrer;
+    long encontrados = 0;
+    double suma = 0.0;
+    {
+        SilenciarSalida silencio;
+        ListaSensor<float> lista;
+        for (long i = 0; i < n; i++) lista.insertar(static_cast<float>(i));
+
+        unsigned long semilla = 2025;
+        Cronometro reloj;
+        for (long c = 0; c < consultas; c++) {
+            semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+            encontrados += lista.busqueda(static_cast<float>((semilla >> 33) % n));
+        }
+        segBuscar = reloj.segundos();
+
+        reloj.reiniciar();
+        for (long c = 0; c < consultas; c++) {
+            encontrados += lista.busqueda(-1.0f);
+        }
+        segAusente = reloj.segundos();
+
+        reloj.reiniciar();
+        for (long r = 0; r < recorridos; r++) {
+            lista.paraCadaBloque([&suma](const float* datos, int cantidad) {
+                for (int i = 0; i < cantidad; i++) suma += datos[i];
+            });
+        }
+        segRecorrer = reloj.segundos();
+
+        // Valores distintos en cada eliminación: e * paso recorre la lista sin repetir
+        long paso = n / eliminaciones;
+        reloj.reiniciar();
+        for (long e = 0; e < eliminaciones; e++) {
+            encontrados += lista.eliminarValor(static_cast<float>(e * paso));
+        }
+        segEliminar = reloj.segundos();
+    }
+    reportarBench("lista_sensor_buscar", n, static_cast<double>(consultas), segBuscar);
+    reportarBench("lista_sensor_buscar_ausente", n, static_cast<double>(consultas), segAusente);
+    reportarBench("lista_sensor_eliminar", n, static_cast<double>(eliminaciones), segEliminar);
+    reportarBench("lista_sensor_recorrer", n, static_cast<double>(n) * recorridos, segRecorrer);
+    if (encontrados < 0 || suma < 0) std::cout << encontrados << suma << std::endl;
+}
+
+/**
+ * @brief Búsqueda, eliminación y recorrido de ListaSensor de 1e3 a 1e7 lecturas
+ *
+ * busqueda y eliminarValor son lineales: el costo por operación debe
+ * crecer 10x por tramo. El recorrido se reporta por nodo y debe
+ * mantenerse plano mientras la lista quepa en caché.
+ */
+inline void benchOperacionesListaSensor() {
+    if (!casoHabilitado("lista_sensor_ops")) return;
+
+    const long maximo = opcionesBench().maximo;
+    for (long n = 1000; n <= maximo && n <= 10000000L; n *= 10) {
+        medirOperacionesListaSensor(n);
+    }
+}
+
+/**
+ * @brief Compara eliminar lecturas con eliminarValor una a una contra eliminarSi
+ *
+ * Elimina las lecturas de un rango (una de cada diez) de una lista de n
+ * lecturas distintas. Con eliminarValor cada eliminación recorre la
+ * lista, así que el caso se limita a 1e5 lecturas; eliminarSi lo hace en
+ * una pasada. También recorre la lista con std::accumulate sobre sus
+ * iteradores y comprueba que el resultado coincida.
+ */
+inline void benchEliminarSiListaSensor() {
+    if (!casoHabilitado("lista_sensor_eliminar_si")) return;
+
+    const long n = opcionesBench().maximo < 100000L ? opcionesBench().maximo : 100000L;
+    const long eliminar = n / 10;
+    double segUnoAUno, segEliminarSi, segAcumular;
+    bool correcto = true;
+    double total = 0.0;
+    {
+        SilenciarSalida silencio;
+        ListaSensor<int> unoAUno;
+        ListaSensor<int> enUnaPasada;
+        for (long i = 0; i < n; i++) {
+            unoAUno.insertar(static_cast<int>(i));
+            enUnaPasada.insertar(static_cast<int>(i));
+        }
+
+        Cronometro reloj;
+        for (long i = 0; i < eliminar; i++) unoAUno.eliminarValor(static_cast<int>(i * 10));
+        segUnoAUno = reloj.segundos();
+
+        reloj.reiniciar();
+        int eliminados = enUnaPasada.eliminarSi([eliminar](const int& v) { return v % 10 == 0 && v / 10 < eliminar; });
+        segEliminarSi = reloj.segundos();
+
+        reloj.reiniciar();
+        total = static_cast<double>(std::accumulate(enUnaPasada.begin(), enUnaPasada.end(), 0LL));
+        segAcumular = reloj.segundos();
+
+        correcto = eliminados == eliminar && unoAUno.obtenerTamanio() == enUnaPasada.obtenerTamanio() &&
+                   std::equal(unoAUno.begin(), unoAUno.end(), enUnaPasada.begin());
+        enUnaPasada.insertar(-1);
+        long long suma = 0;
+        enUnaPasada.paraCadaBloque([&suma](const int* datos, int cantidad) {
+            for (int i = 0; i < cantidad; i++) suma += datos[i];
+        });
+        if (static_cast<double>(suma + 1) != total) correcto = false;
+    }
+    reportarBench("lista_sensor_eliminar_si_uno_a_uno", n, static_cast<double>(eliminar), segUnoAUno);
+    reportarBench("lista_sensor_eliminar_si_una_pasada", n, static_cast<double>(eliminar), segEliminarSi);
+    reportarBench("lista_sensor_eliminar_si_accumulate", n - eliminar, static_cast<double>(n - eliminar), segAcumular);
+    if (!correcto) {
+        std::cout << "  ERROR: eliminarSi, los iteradores o la cola no coinciden con eliminarValor" << std::endl;
+    }
+}
+
+/**
+ * @brief Compara insertar contra insertarLote, copiar contra mover y el empalme
+ *
+ * Inserta lotes de 256 lecturas (lo que entrega un ciclo de la ingesta)
+ * uno a uno y con insertarLote, y después copia, mueve y empalma la
+ * lista completa. Mover y empalmar no dependen de n ni asignan memoria;
+ * se verifica que el contenido no cambie.
+ */
+inline void benchLoteListaSensor() {
+    if (!casoHabilitado("lista_sensor_lote")) return;
+
+    const long n = opcionesBench().maximo < 1000000L ? opcionesBench().maximo : 1000000L;
+    const long lote = 256;
+    std::vector<float> valores(static_cast<size_t>(lote));
+    for (long i = 0; i < lote; i++) valores[static_cast<size_t>(i)] = static_cast<float>(i) * 0.5f;
+
+    double segUno, segLote, segCopia, segMover, segEmpalmar;
+    long asignacionesMover, asignacionesEmpalmar;
+    bool correcto = true;
+    {
+        SilenciarSalida silencio;
+        // Ambas mediciones reutilizan la memoria que liberó la anterior, sin fallos de página
+        ListaSensor<float> porUno;
+        for (long i = 0; i < n; i += lote) porUno.insertarLote(&valores[0], valores.size());
+        porUno = ListaSensor<float>();
+        Cronometro reloj;
+        for (long i = 0; i < n; i += lote) {
+            for (long j = 0; j < lote; j++) porUno.insertar(valores[static_cast<size_t>(j)]);
+        }
+        segUno = reloj.segundos();
+
+        ListaSensor<float> porLote;
+        {
+            ListaSensor<float> calentar(porUno);
+        }
+        reloj.reiniciar();
+        for (long i = 0; i < n; i += lote) porLote.insertarLote(&valores[0], valores.size());
+        segLote = reloj.segundos();
+
+        reloj.reiniciar();
+        ListaSensor<float> copia(porLote);
+        segCopia = reloj.segundos();
+
+        asignacionesMover = contadorAsignaciones();
+        reloj.reiniciar();
+        ListaSensor<float> movida(std::move(copia));
+        segMover = reloj.segundos();
+        asignacionesMover = contadorAsignaciones() - asignacionesMover;
+
+        // porUno y movida tienen los mismos valores: empalmar duplica el historial
+        int esperado = porUno.obtenerTamanio() + movida.obtenerTamanio();
+        asignacionesEmpalmar = contadorAsignaciones();
+        reloj.reiniciar();
+        porUno.empalmar(movida);
+        segEmpalmar = reloj.segundos();
+        asignacionesEmpalmar = contadorAsignaciones() - asignacionesEmpalmar;
+
+        correcto = copia.obtenerTamanio() == 0 && movida.obtenerTamanio() == 0 &&
+                   porUno.obtenerTamanio() == esperado;
+        ListaSensor<float>::const_iterator a = porLote.begin();
+        long posicion = 0;
+        for (float valor : porUno) {
+            if (a == porLote.end()) a = porLote.begin();
+            if (*a != valor) correcto = false;
+            ++a;
+            posicion++;
+        }
+        if (posicion != esperado) correcto = false;
+    }
+    long total = (n + lote - 1) / lote * lote;
+    reportarBench("lista_sensor_lote_insertar_uno", total, static_cast<double>(total), segUno);
+    reportarBench("lista_sensor_lote_insertar_lote", total, static_cast<double>(total), segLote);
+    reportarBench("lista_sensor_lote_copiar", total, static_cast<double>(total), segCopia);
+    reportarBench("lista_sensor_lote_mover", total, 1.0, segMover);
+    reportarBench("lista_sensor_lote_empalmar", total, 1.0, segEmpalmar);
+    if (asignacionesMover != 0 || asignacionesEmpalmar != 0) {
+        std::cout << "  ERROR: mover y empalmar asignaron memoria (" << asignacionesMover << " y "
+                  << asignacionesEmpalmar << " asignaciones)" << std::endl;
+    }
+    if (!correcto) {
+        std::cout << "  ERROR: el contenido de la lista cambio al copiar, mover o empalmar" << std::endl;
+    }
+}
+
+/**
+ * @brief Mide inserción y destrucción de muchas listas con un asignador dado
+ * @tparam Asignador Política de memoria a medir
+ * @param nombre Prefijo del caso en el reporte
+ * @param listas Número de listas (sensores) a crear
+ * @param porLista Lecturas por lista
+ */
+template <typename Asignador>
+void medirAsignador(const char* nombre, long listas, long porLista) {
+    typedef ListaSensor<int, Asignador> Lista;
+    SilenciarSalida silencio;
+
+    std::vector<Lista*> historiales;
+    Cronometro reloj;
+    for (long i = 0; i < listas; i++) {
+        Lista* lista = new Lista();
+        for (long j = 0; j < porLista; j++) {
+            lista->insertar(static_cast<int>(j));
+        }
+        historiales.push_back(lista);
+    }
+    double insercion = reloj.segundos();
+
+    reloj.reiniciar();
+    for (size_t i = 0; i < historiales.size(); i++) {
+        delete historiales[i];
+    }
+    double liberacion = reloj.segundos();
+
+    std::cout.clear();
+    std::string caso(nombre);
+    reportarBench((caso + "_insertar").c_str(), listas * porLista, static_cast<double>(listas * porLista), insercion);
+    reportarBench((caso + "_liberar").c_str(), listas * porLista, static_cast<double>(listas * porLista), liberacion);
+    std::cout.setstate(std::ios::badbit);
+}
+
+/**
+ * @brief Compara el asignador por nodo (new/delete) contra el pool por losas
+ *
+ * Simula miles de sensores con historiales largos: se crean todas las
+ * listas y después se destruyen, como al salir del programa.
+ */
+inline void benchAsignadores() {
+    if (!casoHabilitado("asignador")) return;
+
+    long total = opcionesBench().maximo < 4000000L ? opcionesBench().maximo : 4000000L;
+    long listas = 2000;
+    long porLista = total / listas > 0 ? total / listas : 1;
+    medirAsignador<AsignadorHeap<Nodo<int> > >("asignador_heap", listas, porLista);
+    medirAsignador<AsignadorPool<Nodo<int> > >("asignador_pool", listas, porLista);
+}
+
+/**
+ * @brief Mide recorridos completos de un historial con paraCadaBloque()
+ * @tparam Historial Contenedor a medir
+ * @param caso Nombre del caso en el reporte
+ * @param n Número de lecturas
+ */
+template <typename Historial>
+void medirRecorrido(const char* caso, long n) {
+    SilenciarSalida silencio;
+    Historial historial;
+    for (long i = 0; i < n; i++) {
+        historial.insertar(static_cast<float>(i % 1000) * 0.1f);
+    }
+
+    const int repeticiones = 10;
+    double total = 0.0;
+    Cronometro reloj;
+    for (int r = 0; r < repeticiones; r++) {
+        float suma = 0.0f;
+        historial.paraCadaBloque([&suma](const float* datos, int cantidad) {
+            for (int i = 0; i < cantidad; i++) {
+                suma += datos[i];
+            }
+        });
+        total += suma;
+    }
+    double segundos = reloj.segundos();
+
+    std::cout.clear();
+    reportarBench(caso, n, static_cast<double>(n) * repeticiones, segundos);
+    if (total < 0) std::cout << total << std::endl;
+    std::cout.setstate(std::ios::badbit);
+}
+
+/**
+ * @brief Compara el recorrido completo de la lista simple contra la desenrollada
+ *
+ * Incluye la lista simple con new/delete por nodo (asignación original)
+ * y con el pool por losas, como referencia.
+ */
+inline void benchRecorridoHistorial() {
+    if (!casoHabilitado("recorrido")) return;
+
+    long n = opcionesBench().maximo < 1000000L ? opcionesBench().maximo : 1000000L;
+    medirRecorrido<ListaSensor<float, AsignadorHeap<Nodo<float> > > >("recorrido_lista_heap", n);
+    medirRecorrido<ListaSensor<float> >("recorrido_lista_pool", n);
+    medirRecorrido<ListaSensorDesenrollada<float> >("recorrido_desenrollada_64", n);
+    medirRecorrido<ListaSensorDesenrollada<float, 256> >("recorrido_desenrollada_256", n);
+}
+
+/**
+ * @brief Mide registrarLectura con un sensor dado y cuenta sus asignaciones
+ * @tparam Sensor Sensor de temperatura a medir
+ * @param sensor Sensor ya construido
+ * @param n Lecturas a registrar
+ * @param asignaciones Asignaciones de memoria hechas durante las inserciones
+ * @return Segundos empleados
+ */
+template <typename Sensor>
+double medirRegistroSensor(Sensor& sensor, long n, long& asignaciones) {
+    asignaciones = contadorAsignaciones();
+    Cronometro reloj;
+    for (long i = 0; i < n; i++) {
+        sensor.registrarLectura(static_cast<float>(i % 1000) * 0.1f);
+    }
+    double segundos = reloj.segundos();
+    asignaciones = contadorAsignaciones() - asignaciones;
+    return segundos;
+}
+
+/**
+ * @brief Comprueba que un sensor con ventana de tiempo vence lecturas sin recibir otras
+ * @return Número de diferencias encontradas
+ *
+ * Registra lecturas con marcas de hace 5 s en sensores con ventana de
+ * 1 s y no inserta nada más: al insertar aún estaban dentro de la ventana
+ * de su propia marca, así que solo las consultas pueden vencerlas. Ni el
+ * historial ni las estadísticas deben seguir mostrándolas.
+ */
+inline int verificarVentanaAlConsultar() {
+    int errores = 0;
+    long long hace5s = instanteActualNs() - 5000000000LL;
+    SensorTemperaturaCircular temperatura("T-vencida", 16, 1.0);
+    SensorPresionCircular presion("P-vencida", 16, 1.0);
+    for (int i = 0; i < 4; i++) {
+        temperatura.registrarLectura(10.0f + static_cast<float>(i), hace5s);
+        presion.registrarLectura(900 + i, hace5s);
+    }
+
+    int vigentes = 0;
+    temperatura.paraCadaBloque([&vigentes](const float*, int cantidad) { vigentes += cantidad; });
+    if (vigentes != 0 || temperatura.obtenerEstadisticas().cantidad != 0) errores++;
+    if (presion.obtenerEstadisticas().cantidad != 0 || presion.promedioHistorial() != 0.0) errores++;
+
+    // Una lectura nueva después de vencer las viejas: las estadísticas solo la cuentan a ella
+    temperatura.registrarLectura(25.0f);
+    const EstadisticasLecturas& t = temperatura.obtenerEstadisticas();
+    if (t.cantidad != 1 || t.media != 25.0 || temperatura.minimoHistorial() != 25.0f) errores++;
+    return errores;
+}
+
+/**
+ * @brief Compara el historial sin límite contra el circular de capacidad fija
+ *
+ * Registra el máximo configurado de lecturas en un SensorTemperatura
+ * (lista + montículo) y en un SensorTemperaturaCircular de 1024 lecturas,
+ * con y sin ventana de tiempo. El circular no debe asignar memoria
+ * después de construirse y su memoria no depende de n.
+ */
+inline void benchHistorialCircular() {
+    if (!casoHabilitado("historial_circular")) return;
+
+    const long n = opcionesBench().maximo;
+    const int capacidad = 1024;
+    long asignacionesLista, asignacionesCircular, asignacionesVentana;
+    double segLista, segCircular, segVentana;
+    {
+        SilenciarSalida silencio;
+        SensorTemperatura sensor("lista");
+        segLista = medirRegistroSensor(sensor, n, asignacionesLista);
+    }
+    {
+        SilenciarSalida silencio;
+        SensorTemperaturaCircular sensor("circular", capacidad);
+        segCircular = medirRegistroSensor(sensor, n, asignacionesCircular);
+    }
+    {
+        SilenciarSalida silencio;
+        SensorTemperaturaCircular sensor("ventana", capacidad, 1.0);
+        segVentana = medirRegistroSensor(sensor, n, asignacionesVentana);
+    }
+
+    reportarBench("historial_lista_registrar", n, static_cast<double>(n), segLista);
+    reportarBench("historial_circular_registrar", n, static_cast<double>(n), segCircular);
+    reportarBench("historial_circular_ventana_registrar", n, static_cast<double>(n), segVentana);
+    std::cout << "  lista: " << asignacionesLista << " asignaciones, ~"
+              << static_cast<long>(n * sizeof(Nodo<float>) / 1024) << " KiB de nodos" << std::endl;
+    std::cout << "  circular: " << asignacionesCircular << " asignaciones, "
+              << PoliticaRetencion(capacidad).bytesPorSensor(sizeof(float)) << " bytes fijos; con ventana: "
+              << asignacionesVentana << " asignaciones, "
+              << PoliticaRetencion(capacidad, 1.0).bytesPorSensor(sizeof(float)) << " bytes fijos" << std::endl;
+
+    int errores;
+    {
+        SilenciarSalida silencio;
+        errores = verificarVentanaAlConsultar();
+    }
+    if (errores != 0) {
+        std::cout << "  ERROR: " << errores << " consultas vieron lecturas fuera de la ventana de tiempo" << std::endl;
+    }
+}
+
+#endif
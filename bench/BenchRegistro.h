@@ -0,0 +1,469 @@
+#ifndef BENCHREGISTRO_H
+#define BENCHREGISTRO_H
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "../ListaGeneral.h"
+#include "../SensorTemperatura.h"
+#include "../SensorPresion.h"
+#include "../EnrutadorESP32.h"
+#include "../Instantanea.h"
+#include "../RegistroSensores.h"
+
+/**
+ * @file BenchRegistro.h
+ * @brief Benchmarks de búsqueda y procesamiento de sensores en ListaGeneral y RegistroSensores
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Búsqueda lineal original, para comparar contra el índice hash
+ * @param lista Lista de sensores
+ * @param nombre Nombre a buscar
+ * @return Sensor encontrado o nullptr
+ */
+inline SensorBase* buscarSensorLineal(const ListaGeneral& lista, const char* nombre) {
+    for (SensorBase* sensor : lista) {
+        const char* nombreSensor = sensor->obtenerNombre();
+        int i = 0;
+        while (nombre[i] != '\0' && nombreSensor[i] != '\0' && nombre[i] == nombreSensor[i]) {
+            i++;
+        }
+        if (nombre[i] == '\0' && nombreSensor[i] == '\0') {
+            return sensor;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Mide buscarSensor (hash) contra la búsqueda lineal
+ *
+ * Registra 10, 1k y 100k sensores y busca nombres existentes elegidos
+ * de forma pseudoaleatoria, como llegan las líneas de un bus compartido.
+ */
+inline void benchBuscarSensor() {
+    if (!casoHabilitado("buscar_sensor")) return;
+
+    const long tamanios[] = { 10, 1000, 100000 };
+    for (int t = 0; t < 3; t++) {
+        long n = tamanios[t];
+        if (n > opcionesBench().maximo) break;
+
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        std::vector<std::string> nombres;
+        char nombre[32];
+        for (long i = 0; i < n; i++) {
+            std::snprintf(nombre, sizeof(nombre), "S-%06ld", i);
+            nombres.push_back(nombre);
+            lista.insertarSensor(new SensorPresion(nombre));
+        }
+
+        long consultas = 1000000L;
+        long consultasLineales = 200000000L / n < consultas ? 200000000L / n : consultas;
+        long encontrados = 0;
+        unsigned long semilla = 12345;
+
+        Cronometro reloj;
+        for (long i = 0; i < consultasLineales; i++) {
+            semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+            encontrados += buscarSensorLineal(lista, nombres[(semilla >> 33) % n].c_str()) != nullptr;
+        }
+        double lineal = reloj.segundos();
+
+        reloj.reiniciar();
+        for (long i = 0; i < consultas; i++) {
+            semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+            encontrados += lista.buscarSensor(nombres[(semilla >> 33) % n].c_str()) != nullptr;
+        }
+        double hash = reloj.segundos();
+
+        std::cout.clear();
+        reportarBench("buscar_sensor_lineal", n, static_cast<double>(consultasLineales), lineal);
+        reportarBench("buscar_sensor_hash", n, static_cast<double>(consultas), hash);
+        if (encontrados != consultas + consultasLineales) std::cout << "ERROR: sensores no encontrados" << std::endl;
+        std::cout.setstate(std::ios::badbit);
+    }
+}
+
+/**
+ * @brief Mide la resolución identificador -> sensor de las líneas del ESP32
+ *
+ * Con 10, 1k y 10k identificadores distintos mezclados en el flujo,
+ * compara buscarSensor + dynamic_cast por línea (copiando el id a una
+ * cadena terminada en '\0') contra el manejador tipado que guarda
+ * EnrutadorESP32. Solo se mide la resolución, no el registro.
+ */
+inline void benchEnrutarESP32() {
+    if (!casoHabilitado("enrutar_esp32")) return;
+
+    const long tamanios[] = { 10, 1000, 10000 };
+    for (int t = 0; t < 3; t++) {
+        long n = tamanios[t];
+        if (n > opcionesBench().maximo) break;
+
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        EnrutadorESP32 enrutador(lista);
+        std::string flujo;
+        char linea[48];
+        for (long i = 0; i < n; i++) {
+            std::snprintf(linea, sizeof(linea), "PRES,BOARD-%05ld-P,%ld\n", i, 80 + i % 41);
+            flujo += linea;
+        }
+        std::vector<LecturaESP32> lecturas;
+        const char* inicio = flujo.c_str();
+        for (const char* fin; (fin = std::strchr(inicio, '\n')) != nullptr; inicio = fin + 1) {
+            LecturaESP32 lectura;
+            VistaCadena vista = { inicio, static_cast<std::size_t>(fin - inicio) };
+            parsearLineaESP32(vista, lectura);
+            lecturas.push_back(lectura);
+            enrutador.obtenerRuta(lectura.tipo, lectura.id); // crea los sensores
+        }
+
+        long consultas = 2000000L;
+        long resueltos = 0;
+        unsigned long semilla = 12345;
+
+        Cronometro reloj;
+        for (long i = 0; i < consultas; i++) {
+            semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+            const LecturaESP32& lectura = lecturas[(semilla >> 33) % n];
+            char nombre[50];
+            std::memcpy(nombre, lectura.id.datos, lectura.id.longitud);
+            nombre[lectura.id.longitud] = '\0';
+            resueltos += dynamic_cast<SensorPresion*>(lista.buscarSensor(nombre)) != nullptr;
+        }
+        double porNombre = reloj.segundos();
+
+        reloj.reiniciar();
+        for (long i = 0; i < consultas; i++) {
+            semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+            const LecturaESP32& lectura = lecturas[(semilla >> 33) % n];
+            resueltos += enrutador.obtenerRuta(lectura.tipo, lectura.id)->registrarPresion != nullptr;
+        }
+        double enrutado = reloj.segundos();
+
+        std::cout.clear();
+        reportarBench("enrutar_esp32_buscar_cast", n, static_cast<double>(consultas), porNombre);
+        reportarBench("enrutar_esp32_ruta_tipada", n, static_cast<double>(consultas), enrutado);
+        if (resueltos != 2 * consultas) std::cout << "ERROR: lecturas sin sensor" << std::endl;
+        std::cout.setstate(std::ios::badbit);
+    }
+}
+
+/**
+ * @brief Crea el sensor número i de una lista mixta
+ * @param i Posición del sensor; el tipo rota entre seis historiales
+ * @param lecturas Lecturas a registrar en el sensor
+ * @return Sensor nuevo; quien llama es dueño del puntero
+ */
+inline SensorBase* crearSensorMixto(long i, int lecturas) {
+    char nombre[32];
+    std::snprintf(nombre, sizeof(nombre), "M-%06ld", i);
+    switch (i % 6) {
+        case 0: {
+            SensorTemperatura* s = new SensorTemperatura(nombre);
+            for (int k = 0; k < lecturas; k++) s->registrarLectura(static_cast<float>((k * 7 + i) % 400) * 0.1f);
+            return s;
+        }
+        case 1: {
+            SensorPresion* s = new SensorPresion(nombre);
+            for (int k = 0; k < lecturas; k++) s->registrarLectura(900 + static_cast<int>((k * 3 + i) % 200));
+            return s;
+        }
+        case 2: {
+            SensorTemperaturaCircular* s = new SensorTemperaturaCircular(nombre, 128);
+            for (int k = 0; k < lecturas; k++) s->registrarLectura(static_cast<float>((k * 11 + i) % 400) * 0.1f);
+            return s;
+        }
+        case 3: {
+            SensorPresionTemporal* s = new SensorPresionTemporal(nombre);
+            for (int k = 0; k < lecturas; k++) s->registrarLectura(900 + static_cast<int>((k * 5 + i) % 200));
+            return s;
+        }
+        case 4: {
+            SensorTemperaturaComprimido* s = new SensorTemperaturaComprimido(nombre);
+            for (int k = 0; k < lecturas; k++) s->registrarLectura(20.0f + static_cast<float>((k + i) % 50) * 0.1f);
+            return s;
+        }
+        default: {
+            SensorPresionDesenrollado* s = new SensorPresionDesenrollado(nombre);
+            for (int k = 0; k < lecturas; k++) s->registrarLectura(900 + static_cast<int>((k * 13 + i) % 200));
+            return s;
+        }
+    }
+}
+
+/**
+ * @brief Mide procesarTodos sobre listas de sensores de varios tipos
+ *
+ * Con 12, 1 200 y 12 000 sensores de 256 lecturas, rotando entre lista,
+ * circular, serie temporal, comprimido y desenrollada, repite
+ * procesarTodos tres veces (cada pasada quita el mínimo de los sensores
+ * de temperatura) y reporta el costo por sensor procesado.
+ */
+inline void benchProcesarTodos() {
+    if (!casoHabilitado("procesar_todos")) return;
+
+    const long tamanios[] = { 12, 1200, 12000 };
+    const int lecturas = 256;
+    const int pasadas = 3;
+    for (int t = 0; t < 3; t++) {
+        long n = tamanios[t];
+        if (n * lecturas > opcionesBench().maximo && t > 0) break;
+        double segundos;
+        {
+            SilenciarSalida silencio;
+            ListaGeneral lista;
+            for (long i = 0; i < n; i++) lista.insertarSensor(crearSensorMixto(i, lecturas));
+            Cronometro reloj;
+            for (int p = 0; p < pasadas; p++) lista.procesarTodos();
+            segundos = reloj.segundos();
+        }
+        reportarBench("procesar_todos_mixto", n, static_cast<double>(n) * pasadas, segundos);
+    }
+}
+
+/**
+ * @brief Ejecuta procesarTodos (en serie o con un pool) capturando std::cout
+ * @param lista Lista a procesar
+ * @param pool Pool a usar, o nullptr para la versión en serie
+ * @param segundos Tiempo del procesamiento
+ * @return Texto que se habría mostrado
+ */
+inline std::string procesarCapturando(ListaGeneral& lista, PoolTrabajo* pool, double& segundos) {
+    std::ostringstream captura;
+    std::streambuf* anterior = std::cout.rdbuf(captura.rdbuf());
+    // reportarBench deja std::cout en notación fija; se procesa con el formato por defecto
+    std::ios::fmtflags formato = std::cout.flags(std::ios::dec | std::ios::skipws);
+    std::streamsize precision = std::cout.precision(6);
+    Cronometro reloj;
+    if (pool != nullptr) {
+        lista.procesarTodos(*pool);
+    } else {
+        lista.procesarTodos();
+    }
+    segundos = reloj.segundos();
+    std::cout.flags(formato);
+    std::cout.precision(precision);
+    std::cout.rdbuf(anterior);
+    return captura.str();
+}
+
+/**
+ * @brief procesarTodos con el pool de robo de trabajo frente a la versión en serie
+ *
+ * 1 200 sensores mixtos de 4 096 lecturas (los circulares y comprimidos
+ * recorren su historial para hallar el mínimo, así que el costo por
+ * sensor es desigual). Mide 1, 2, 4, ... hilos hasta los núcleos de la
+ * máquina y comprueba que la salida sea idéntica a la versión en serie.
+ * Con un solo núcleo solo se mide 1 hilo, es decir, el costo de los
+ * búferes por sensor; el escalamiento requiere una máquina con varios.
+ */
+inline void benchProcesarTodosParalelo() {
+    if (!casoHabilitado("procesar_todos_paralelo")) return;
+
+    const long n = 1200;
+    const int lecturas = opcionesBench().maximo < 4096 ? static_cast<int>(opcionesBench().maximo) : 4096;
+    NivelBitacora nivelAnterior = Bitacora::obtenerNivel();
+    Bitacora::establecerNivel(BITACORA_APAGADA);
+
+    std::string referencia;
+    double segSerie;
+    {
+        ListaGeneral lista;
+        for (long i = 0; i < n; i++) lista.insertarSensor(crearSensorMixto(i, lecturas));
+        referencia = procesarCapturando(lista, nullptr, segSerie);
+    }
+    reportarBench("procesar_todos_paralelo_serie", n, static_cast<double>(n), segSerie);
+
+    unsigned nucleos = std::thread::hardware_concurrency();
+    if (nucleos == 0) nucleos = 1;
+    if (nucleos == 1) {
+        std::cout << "  un solo nucleo: se mide el costo de los buferes, no el escalamiento" << std::endl;
+    }
+    for (unsigned hilos = 1; ; hilos *= 2) {
+        if (hilos > nucleos) hilos = nucleos;
+        ListaGeneral lista;
+        for (long i = 0; i < n; i++) lista.insertarSensor(crearSensorMixto(i, lecturas));
+        PoolTrabajo pool(hilos);
+        double segundos;
+        std::string salida = procesarCapturando(lista, &pool, segundos);
+        char caso[64];
+        std::snprintf(caso, sizeof(caso), "procesar_todos_paralelo_%uh", hilos);
+        reportarBench(caso, n, static_cast<double>(n), segundos);
+        std::cout << "  aceleracion " << std::setprecision(2) << segSerie / segundos << "x, "
+                  << pool.obtenerRobos() << " robos" << std::endl;
+        if (salida != referencia) {
+            std::cout << "  ERROR: la salida con " << hilos << " hilos no coincide con la version en serie" << std::endl;
+        }
+        if (hilos == nucleos) break;
+    }
+    Bitacora::establecerNivel(nivelAnterior);
+}
+
+/**
+ * @brief Usa RegistroSensoresCompleto como almacén del enrutador y de la instantánea
+ * @param ruta Archivo temporal
+ * @return Número de diferencias encontradas
+ *
+ * Enruta lecturas con dos políticas (circular e indexada), comprueba que
+ * cada sensor quedó en la partición de su tipo, guarda el registro y lo
+ * carga en otro, que debe tener las mismas estadísticas.
+ */
+inline int verificarRegistroCompleto(const char* ruta) {
+    int errores = 0;
+    RegistroSensoresCompleto registro;
+    PoliticaRetencion indexada;
+    indexada.indexado = true;
+    EnrutadorESP32 circular(registro, PoliticaRetencion(16));
+    EnrutadorESP32 ordenado(registro, indexada);
+    LecturaESP32 lectura = LecturaESP32();
+    for (int k = 0; k < 40; k++) {
+        lectura.tipo = LECTURA_TEMPERATURA;
+        lectura.id = vistaDe("T-01");
+        lectura.temperatura = 20.0f + static_cast<float>(k % 7);
+        if (circular.registrar(lectura) != RUTA_REGISTRADA) errores++;
+        lectura.id = vistaDe("T-02");
+        if (ordenado.registrar(lectura) != RUTA_REGISTRADA) errores++;
+        lectura.tipo = LECTURA_PRESION;
+        lectura.id = vistaDe("P-01");
+        lectura.presion = 1000 + k;
+        if (circular.registrar(lectura) != RUTA_REGISTRADA) errores++;
+    }
+    if (registro.obtenerTamanio() != 3 || registro.obtenerTamanioDe<SensorTemperaturaCircular>() != 1 ||
+        registro.obtenerTamanioDe<SensorTemperaturaIndexado>() != 1 || registro.obtenerTamanioDe<SensorPresionCircular>() != 1 ||
+        registro.buscar<SensorTemperaturaCircular>("T-01") == nullptr) {
+        errores++;
+    }
+
+    if (!guardarInstantanea(registro, ruta)) return errores + 1;
+    RegistroSensoresCompleto cargado;
+    int cargados = 0;
+    if (!cargarInstantanea(ruta, cargado, cargados) || cargados != 3 ||
+        cargado.obtenerTamanioDe<SensorTemperaturaCircular>() != 1 || cargado.obtenerTamanioDe<SensorTemperaturaIndexado>() != 1 ||
+        cargado.obtenerTamanioDe<SensorPresionCircular>() != 1) {
+        return errores + 1;
+    }
+    for (SensorBase* sensor : registro) {
+        SensorBase* otro = cargado.buscarSensor(sensor->obtenerNombre());
+        if (otro == nullptr || otro->obtenerEstadisticas().cantidad != sensor->obtenerEstadisticas().cantidad ||
+            otro->obtenerEstadisticas().suma != sensor->obtenerEstadisticas().suma) {
+            errores++;
+        }
+    }
+    return errores;
+}
+
+/**
+ * @brief Compara ListaGeneral contra el registro separado por tipo
+ *
+ * 100k sensores (la mitad de temperatura y la mitad de presión,
+ * alternados) con 8 lecturas cada uno, para que pese el costo de llegar
+ * a cada sensor y no el de su historial. Mide procesarTodos (vtable y
+ * saltos de nodo contra un lazo por tipo sobre losas contiguas) y un
+ * recorrido que solo lee las estadísticas de cada sensor. Al final
+ * comprueba que ambos contenedores quedaron con las mismas estadísticas.
+ */
+inline void benchRegistroPorTipo() {
+    if (!casoHabilitado("registro_por_tipo")) return;
+
+    const long n = opcionesBench().maximo < 100000L ? opcionesBench().maximo : 100000L;
+    const int lecturas = 8;
+    const int pasadas = 3;
+    const int recorridos = 20;
+    double segLista, segRegistro, segRecorrerLista, segRecorrerRegistro;
+    double sumaLista = 0.0, sumaRegistro = 0.0;
+    long distintos = 0;
+    {
+        SilenciarSalida silencio;
+        ListaGeneral lista;
+        RegistroSensoresLista registro;
+        char nombre[32];
+        for (long i = 0; i < n; i++) {
+            std::snprintf(nombre, sizeof(nombre), "R-%06ld", i);
+            if (i % 2 == 0) {
+                SensorTemperatura* enLista = new SensorTemperatura(nombre);
+                SensorTemperatura& enRegistro = registro.crear<SensorTemperatura>(nombre);
+                for (int k = 0; k < lecturas; k++) {
+                    float valor = static_cast<float>((k * 7 + i) % 400) * 0.1f;
+                    enLista->registrarLectura(valor);
+                    enRegistro.registrarLectura(valor);
+                }
+                lista.insertarSensor(enLista);
+            } else {
+                SensorPresion* enLista = new SensorPresion(nombre);
+                SensorPresion& enRegistro = registro.crear<SensorPresion>(nombre);
+                for (int k = 0; k < lecturas; k++) {
+                    int valor = 900 + static_cast<int>((k * 3 + i) % 200);
+                    enLista->registrarLectura(valor);
+                    enRegistro.registrarLectura(valor);
+                }
+                lista.insertarSensor(enLista);
+            }
+        }
+
+        Cronometro reloj;
+        for (int p = 0; p < pasadas; p++) lista.procesarTodos();
+        segLista = reloj.segundos();
+
+        reloj.reiniciar();
+        for (int p = 0; p < pasadas; p++) registro.procesarTodos();
+        segRegistro = reloj.segundos();
+
+        reloj.reiniciar();
+        for (int r = 0; r < recorridos; r++) {
+            for (SensorBase* sensor : lista) sumaLista += sensor->obtenerEstadisticas().suma;
+        }
+        segRecorrerLista = reloj.segundos();
+
+        reloj.reiniciar();
+        for (int r = 0; r < recorridos; r++) {
+            registro.paraCadaSensor<SensorTemperatura>([&sumaRegistro](SensorTemperatura& sensor) {
+                sumaRegistro += sensor.obtenerEstadisticas().suma;
+            });
+            registro.paraCadaSensor<SensorPresion>([&sumaRegistro](SensorPresion& sensor) {
+                sumaRegistro += sensor.obtenerEstadisticas().suma;
+            });
+        }
+        segRecorrerRegistro = reloj.segundos();
+
+        for (SensorBase* sensor : lista) {
+            SensorBase* otro = registro.buscarSensor(sensor->obtenerNombre());
+            if (otro == nullptr || otro->obtenerEstadisticas().cantidad != sensor->obtenerEstadisticas().cantidad ||
+                otro->obtenerEstadisticas().suma != sensor->obtenerEstadisticas().suma) {
+                distintos++;
+            }
+        }
+        if (registro.obtenerTamanio() != lista.obtenerTamanio()) distintos++;
+    }
+    reportarBench("registro_por_tipo_lista_procesar", n, static_cast<double>(n) * pasadas, segLista);
+    reportarBench("registro_por_tipo_procesar", n, static_cast<double>(n) * pasadas, segRegistro);
+    reportarBench("registro_por_tipo_lista_recorrer", n, static_cast<double>(n) * recorridos, segRecorrerLista);
+    reportarBench("registro_por_tipo_recorrer", n, static_cast<double>(n) * recorridos, segRecorrerRegistro);
+    // Las sumas se acumulan en distinto orden, así que solo deben coincidir hasta el redondeo
+    if (distintos != 0 || std::fabs(sumaLista - sumaRegistro) > 1e-9 * std::fabs(sumaLista)) {
+        std::cout << "  ERROR: " << distintos << " sensores del registro no coinciden con la lista" << std::endl;
+    }
+
+    const char* ruta = "bench_registro.iot";
+    int errores;
+    {
+        SilenciarSalida silencio;
+        errores = verificarRegistroCompleto(ruta);
+    }
+    std::remove(ruta);
+    if (errores != 0) {
+        std::cout << "  ERROR: " << errores << " diferencias al usar el registro completo con el enrutador y la instantanea" << std::endl;
+    }
+}
+
+#endif
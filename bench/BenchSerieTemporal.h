@@ -0,0 +1,224 @@
+#ifndef BENCHSERIETEMPORAL_H
+#define BENCHSERIETEMPORAL_H
+
+#include <iostream>
+#include <limits>
+#include "Bench.h"
+#include "../SerieTemporal.h"
+#include "../SensorTemperatura.h"
+
+/**
+ * @file BenchSerieTemporal.h
+ * @brief Benchmarks de consultas por ventana de tiempo y niveles de resumen
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ */
+
+/**
+ * @brief Resume una ventana recorriendo toda la serie, para comparar
+ * @param serie Serie a recorrer
+ * @param t0 Inicio de la ventana (incluido)
+ * @param t1 Fin de la ventana (excluido)
+ * @return Resumen de la ventana
+ */
+template <typename T>
+ResumenVentana<T> resumenLineal(const SerieTemporal<T>& serie, long long t0, long long t1) {
+    ResumenVentana<T> resumen = ResumenVentana<T>::vacio();
+    serie.paraCadaBloqueEntre(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max(),
+                             [&resumen, t0, t1](const long long* marcas, const T* valores, int n) {
+        for (int i = 0; i < n; i++) {
+            if (marcas[i] >= t0 && marcas[i] < t1) resumen.agregar(valores[i]);
+        }
+    });
+    return resumen;
+}
+
+/**
+ * @brief Mide consultas [t0, t1) de un ancho dado en posiciones pseudoaleatorias
+ * @param caso Nombre del caso en el reporte
+ * @param serie Serie con una lectura por milisegundo
+ * @param anchoMs Ancho de la ventana en milisegundos
+ * @param consultas Número de consultas
+ * @param lineal true para recorrer toda la serie en lugar de usar el índice
+ */
+inline void medirVentanas(const char* caso, const SerieTemporal<float>& serie, long anchoMs, int consultas, bool lineal) {
+    const long long ms = 1000000LL;
+    long n = serie.obtenerTamanio();
+    unsigned int semilla = 12345;
+    double acumulado = 0.0;
+    Cronometro reloj;
+    for (int q = 0; q < consultas; q++) {
+        semilla = semilla * 1103515245u + 12345u;
+        long inicio = n > anchoMs ? static_cast<long>(semilla % static_cast<unsigned int>(n - anchoMs)) : 0;
+        long long t0 = (inicio + 1) * ms;
+        long long t1 = t0 + anchoMs * ms;
+        ResumenVentana<float> r = lineal ? resumenLineal(serie, t0, t1) : serie.resumenEntre(t0, t1);
+        acumulado += r.media();
+    }
+    double segundos = reloj.segundos();
+    reportarBench(caso, anchoMs, static_cast<double>(consultas), segundos);
+    if (acumulado < 0.0) std::cout << acumulado << std::endl; // evita que se descarte el cálculo
+}
+
+/**
+ * @brief Consultas por ventana sobre una serie de hasta 10M lecturas
+ *
+ * La serie tiene una lectura por milisegundo (10M = 2.8 horas). Se miden
+ * ventanas de 1 s, 5 min y 1 h con resumenEntre() y, como referencia, la
+ * ventana de 5 min recorriendo toda la serie. Antes de medir se comprueba
+ * que ambos caminos den el mismo resumen.
+ */
+inline void benchSerieTemporal() {
+    if (!casoHabilitado("serie_temporal")) return;
+
+    const long n = opcionesBench().maximo < 10000000L ? opcionesBench().maximo : 10000000L;
+    const long long ms = 1000000LL;
+    SerieTemporal<float>* serie;
+    double segundos;
+    {
+        SilenciarSalida silencio;
+        serie = new SerieTemporal<float>();
+        Cronometro reloj;
+        for (long i = 0; i < n; i++) {
+            serie->insertarEn(static_cast<float>((i * 7) % 1000) * 0.1f, (i + 1) * ms);
+        }
+        segundos = reloj.segundos();
+    }
+    reportarBench("serie_temporal_insertar", n, static_cast<double>(n), segundos);
+
+    long long t0 = (n / 3 + 1) * ms + ms / 2;
+    long long t1 = t0 + 300000 * ms;
+    ResumenVentana<float> indice = serie->resumenEntre(t0, t1);
+    ResumenVentana<float> lineal = resumenLineal(*serie, t0, t1);
+    if (indice.cantidad != lineal.cantidad || indice.minimo != lineal.minimo || indice.maximo != lineal.maximo) {
+        std::cout << "  ERROR: resumenEntre (" << indice.cantidad << ") no coincide con el recorrido ("
+                  << lineal.cantidad << ")" << std::endl;
+    }
+
+    medirVentanas("serie_ventana_1s", *serie, 1000, 10000, false);
+    medirVentanas("serie_ventana_5min", *serie, 300000, 1000, false);
+    medirVentanas("serie_ventana_1h", *serie, 3600000, 100, false);
+    medirVentanas("serie_ventana_5min_lineal", *serie, 300000, 5, true);
+    std::cout << "  " << serie->bytesReservados() / (1024 * 1024) << " MiB para " << n << " lecturas con marca" << std::endl;
+
+    SilenciarSalida silencio;
+    delete serie;
+}
+
+/**
+ * @brief Procesar un sensor con serie temporal, sin horizonte (montículo) y con él (recorrido)
+ *
+ * 100k lecturas y 1000 procesamientos. Sin horizonte la serie conserva
+ * todas las lecturas y el sensor toma el mínimo del montículo, como con
+ * ListaSensor; se comprueba que quite los mismos mínimos que ese sensor.
+ * En ambos casos eliminarValor() sigue recorriendo la serie hasta la
+ * primera aparición del mínimo; el montículo solo ahorra buscarlo.
+ */
+inline void benchSerieTemporalProcesar() {
+    if (!casoHabilitado("serie_temporal_procesar")) return;
+
+    const long n = opcionesBench().maximo < 100000L ? opcionesBench().maximo : 100000L;
+    const long long ms = 1000000LL;
+    const int procesados = 1000;
+    double segMonticulo, segRecorrido;
+    bool coinciden;
+    {
+        SilenciarSalida silencio;
+        SensorTemperatura lista("lista");
+        SensorTemperaturaTemporal sinHorizonte("serie");
+        SensorTemperaturaTemporal conHorizonte("horizonte", 3600.0);
+        for (long i = 0; i < n; i++) {
+            float valor = static_cast<float>((i * 7919) % 1000) * 0.1f;
+            lista.registrarLectura(valor);
+            sinHorizonte.registrarLectura(valor, (i + 1) * ms);
+            conHorizonte.registrarLectura(valor, (i + 1) * ms);
+        }
+        Cronometro reloj;
+        for (int p = 0; p < procesados; p++) sinHorizonte.procesarLectura(std::cout);
+        segMonticulo = reloj.segundos();
+        reloj.reiniciar();
+        for (int p = 0; p < procesados; p++) conHorizonte.procesarLectura(std::cout);
+        segRecorrido = reloj.segundos();
+        for (int p = 0; p < procesados; p++) lista.procesarLectura(std::cout);
+        coinciden = lista.minimoHistorial() == sinHorizonte.minimoHistorial() &&
+                    lista.obtenerEstadisticas().minimo == sinHorizonte.obtenerEstadisticas().minimo &&
+                    lista.obtenerEstadisticas().cantidad == sinHorizonte.obtenerEstadisticas().cantidad;
+    }
+    reportarBench("serie_temporal_procesar_monticulo", n, static_cast<double>(procesados), segMonticulo);
+    reportarBench("serie_temporal_procesar_recorrido", n, static_cast<double>(procesados), segRecorrido);
+    if (!coinciden) {
+        std::cout << "  ERROR: la serie sin horizonte no quito los mismos minimos que la lista" << std::endl;
+    }
+}
+
+/**
+ * @brief Mide consultas resumenAgregado() de un ancho dado que terminan en la última lectura
+ * @param caso Nombre del caso en el reporte
+ * @param serie Serie compactada
+ * @param anchoSeg Ancho de la ventana en segundos
+ * @param consultas Número de consultas
+ */
+inline void medirVentanasAgregadas(const char* caso, const SerieTemporal<float>& serie, long anchoSeg, int consultas) {
+    const long long segundo = 1000000000LL;
+    long long fin = serie.obtenerUltimaMarca() + 1;
+    double acumulado = 0.0;
+    Cronometro reloj;
+    for (int q = 0; q < consultas; q++) {
+        long long t1 = fin - (q % 100) * segundo;
+        acumulado += serie.resumenAgregado(t1 - anchoSeg * segundo, t1).media();
+    }
+    double segundos = reloj.segundos();
+    reportarBench(caso, anchoSeg, static_cast<double>(consultas), segundos);
+    if (acumulado < 0.0) std::cout << acumulado << std::endl; // evita que se descarte el cálculo
+}
+
+/**
+ * @brief Niveles de 1 s / 1 min / 1 h con compactación de las lecturas crudas
+ *
+ * Inserta hasta 10M lecturas, una cada 100 ms (10M = 11.6 días), en una
+ * serie con horizonte de una hora y mide la memoria que queda frente a
+ * guardar todas las lecturas crudas, y consultas de 1 h, 1 día y 7 días
+ * resueltas con el nivel más grueso que las cubre.
+ */
+inline void benchNivelesResumen() {
+    if (!casoHabilitado("serie_niveles")) return;
+
+    const long n = opcionesBench().maximo < 10000000L ? opcionesBench().maximo : 10000000L;
+    const long long paso = 100000000LL;
+    SerieTemporal<float>* serie;
+    long compactadas = 0;
+    double segundos;
+    {
+        SilenciarSalida silencio;
+        serie = new SerieTemporal<float>(3600.0);
+        Cronometro reloj;
+        for (long i = 0; i < n; i++) {
+            serie->insertarEn(static_cast<float>((i * 7) % 1000) * 0.1f, (i + 1) * paso,
+                              [&compactadas](float) { compactadas++; });
+        }
+        segundos = reloj.segundos();
+    }
+    reportarBench("serie_niveles_insertar", n, static_cast<double>(n), segundos);
+
+    // Dentro de la retención de todos los niveles el resultado es exacto
+    long long fin = serie->obtenerUltimaMarca() + 1;
+    long mediaHora = serie->resumenAgregado(fin - 1800 * 1000000000LL, fin).cantidad;
+    long esperadas = n < 18000 ? n : 18000;
+    if (mediaHora != esperadas) {
+        std::cout << "  ERROR: la ultima media hora tiene " << mediaHora << " lecturas, se esperaban " << esperadas << std::endl;
+    }
+
+    medirVentanasAgregadas("serie_niveles_ventana_1h", *serie, 3600, 10000);
+    medirVentanasAgregadas("serie_niveles_ventana_1d", *serie, 24 * 3600, 10000);
+    medirVentanasAgregadas("serie_niveles_ventana_7d", *serie, 7 * 24 * 3600, 1000);
+
+    double crudoMiB = static_cast<double>(n) * (sizeof(long long) + sizeof(float)) / (1024.0 * 1024.0);
+    std::cout << "  " << serie->obtenerTamanio() << " lecturas crudas (" << compactadas << " compactadas), "
+              << std::setprecision(2) << serie->bytesReservados() / (1024.0 * 1024.0) << " MiB frente a "
+              << crudoMiB << " MiB sin compactar" << std::endl;
+
+    SilenciarSalida silencio;
+    delete serie;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "Bench.h"
+#include "BenchListaSensor.h"
+#include "BenchSerieTemporal.h"
+#include "BenchHistorialComprimido.h"
+#include "BenchHistorialIndexado.h"
+#include "BenchInstantanea.h"
+#include "BenchAgregados.h"
+#include "BenchRegistro.h"
+#include "BenchLectorLineas.h"
+#include "BenchIngesta.h"
+#include "BenchDiario.h"
+#include "BenchBitacora.h"
+
+/**
+ * @file bench_main.cpp
+ * @brief Punto de entrada de los benchmarks del sistema IoT
+ * @author Angel Gabriel Coronado Sánchez
+ * @date 2025
+ *
+ * Uso: SistemaIoT_bench [--max N] [--filtro texto] [--json ARCHIVO]
+ *
+ * Con --json, además de la tabla se escriben todos los resultados en
+ * ARCHIVO (formato JSON de Google Benchmark) para comparar versiones.
+ */
+
+// Reemplazo de operator new para contar asignaciones durante las mediciones
+void* operator new(std::size_t bytes) {
+    contadorAsignaciones().fetch_add(1, std::memory_order_relaxed);
+    void* memoria = std::malloc(bytes > 0 ? bytes : 1);
+    if (memoria == nullptr) throw std::bad_alloc();
+    return memoria;
+}
+
+// GCC no reconoce que este delete corresponde al new reemplazado arriba
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* memoria) noexcept { std::free(memoria); }
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            opcionesBench().maximo = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filtro") == 0 && i + 1 < argc) {
+            opcionesBench().filtro = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            opcionesBench().json = argv[++i];
+        } else {
+            std::cout << "Uso: " << argv[0] << " [--max N] [--filtro texto] [--json ARCHIVO]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "=== BENCHMARKS SISTEMA IoT ===" << std::endl;
+    benchInsercionListaSensor();
+    benchOperacionesListaSensor();
+    benchLoteListaSensor();
+    benchEliminarSiListaSensor();
+    benchAsignadores();
+    benchRecorridoHistorial();
+    benchHistorialCircular();
+    benchSerieTemporal();
+    benchSerieTemporalProcesar();
+    benchNivelesResumen();
+    benchHistorialComprimido();
+    benchHistorialIndexado();
+    benchInstantanea();
+    benchAgregados();
+    benchBuscarSensor();
+    benchProcesarTodos();
+    benchProcesarTodosParalelo();
+    benchRegistroPorTipo();
+    benchEnrutarESP32();
+    benchLectorLineas();
+    benchColaSPSC();
+    benchIngestaESP32();
+#ifndef _WIN32
+    benchIngestaMultipuerto();
+#endif
+    benchDiario();
+    benchBitacora();
+
+    if (opcionesBench().json != nullptr && !escribirResultadosJson(opcionesBench().json)) {
+        std::cout << "ERROR: no se pudo escribir " << opcionesBench().json << std::endl;
+        return 1;
+    }
+    return 0;
+}
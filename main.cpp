@@ -1,6 +1,21 @@
 #include <iostream>
-#include <windows.h>
 #include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Bitacora.h"
+#include "ControlConsola.h"
+#include "FuenteSerial.h"
+#include "EnrutadorESP32.h"
+#include "PoliticaRetencion.h"
+#include "IngestaESP32.h"
+#include "FuenteArchivo.h"
+#include "MemoriaProceso.h"
+#include "Instantanea.h"
 #include "SensorTemperatura.h"
 #include "SensorPresion.h"
 #include "ListaGeneral.h"
@@ -12,184 +27,421 @@
  * @date 2025
  * 
  * Sistema de monitoreo que lee datos de sensores desde un dispositivo ESP32
- * conectado por puerto serial (COM6) y los procesa mediante polimorfismo
+ * conectado por puerto serial y los procesa mediante polimorfismo.
+ *
+ * Uso: SistemaIoT [--puerto RUTA]... [--baudios N] [--bitacora NIVEL] [--bitacora-asincrona]
+ *                   [--retencion N] [--ventana SEGUNDOS] [--serie-temporal] [--horizonte SEGUNDOS] [--comprimido]
+ *                   [--indexado]
+ *                   [--instantanea ARCHIVO] [--diario DIRECTORIO] [--diario-intervalo MS]
+ *                   [--reproducir CAPTURA [--ritmo]] [--hilos N]
+ * (por defecto COM6 en Windows y /dev/ttyUSB0 en Linux, 9600 baudios).
+ * --puerto se puede repetir para leer varios ESP32 a la vez: un solo hilo
+ * espera en todos los puertos (epoll en Linux) y cada uno tiene sus
+ * propios contadores. La opción 3 lee hasta que se presiona Enter, llega
+ * Ctrl+C o todos los dispositivos cierran la conexión.
+ * NIVEL es depuracion (por defecto), info, advertencia, error o apagada.
+ * --retencion y --ventana limitan el historial de cada sensor nuevo a las
+ * últimas N lecturas o a las de los últimos SEGUNDOS (sin límite por defecto).
+ * --serie-temporal guarda cada lectura con su instante de llegada para
+ * consultar ventanas de tiempo (no se combina con --retencion ni --ventana);
+ * --horizonte activa la serie y compacta las lecturas más viejas que
+ * SEGUNDOS en resúmenes de 1 s, 1 min y 1 h.
+ * --comprimido conserva todas las lecturas en bloques comprimidos (no se
+ * combina con las opciones anteriores, salvo --serie-temporal: entonces
+ * también guarda comprimido el instante de cada lectura).
+ * Sin ninguna de ellas los sensores de temperatura ya conservan sus
+ * lecturas con un índice ordenado por valor, de modo que procesarlos
+ * (quitar su mínimo) es O(log n); --indexado lo aplica también a los de
+ * presión (tampoco se combina con las anteriores).
+ * --instantanea carga los sensores guardados en ARCHIVO al iniciar y guarda
+ * todos los sensores en él al salir con la opción 6. Cada sensor vuelve con
+ * su historial y su retención; los que guardan sus lecturas en lista las
+ * leen del archivo proyectado en memoria, sin reconstruirlas.
+ * --diario anota cada lectura recibida del ESP32 en un diario de escritura
+ * anticipada y, al iniciar, vuelve a registrar las que contiene; con
+ * --instantanea el diario se vacía cada vez que se guarda la instantánea.
+ * Las lecturas se fuerzan a disco en grupos cada MS milisegundos (10 por
+ * defecto) o una por una con --diario-intervalo 0.
+ * --reproducir no muestra el menú: pasa las líneas del archivo CAPTURA por
+ * la misma ingesta que la opción 3 (lo más rápido posible, o con --ritmo
+ * a su ritmo grabado), informa lecturas por segundo, percentiles de
+ * latencia y memoria máxima, guarda la instantánea si se indicó y termina.
+ * Para medir conviene agregar --bitacora apagada.
+ * --hilos procesa los sensores (opción 5) en N hilos con robo de trabajo;
+ * la salida sale en el orden de la lista, seguida del tiempo total y del
+ * sensor más lento.
+ * En Linux RUTA puede ser también una pty o un FIFO para pruebas sin hardware.
  */
 
+/**
+ * @struct ConfiguracionSerial
+ * @brief Parámetros de conexión con el ESP32 tomados de la línea de comandos
+ */
+struct ConfiguracionSerial {
+    std::vector<const char*> puertos; ///< Rutas de los puertos seriales (al menos una)
+    int baudios;         ///< Velocidad de los puertos
+    const char* captura; ///< Captura a reproducir en lugar del puerto (nullptr = puerto)
+    bool ritmo;          ///< Reproducir la captura a su ritmo grabado
+};
+
+/**
+ * @struct ConfiguracionBitacora
+ * @brief Nivel y modo de los mensajes de diagnóstico
+ */
+struct ConfiguracionBitacora {
+    NivelBitacora nivel; ///< Nivel mínimo que se muestra
+    bool asincrona;      ///< Escribir desde un hilo propio (SumideroAsincrono)
+};
+
+/**
+ * @struct ConfiguracionProcesamiento
+ * @brief Cómo se procesan los sensores con la opción 5
+ */
+struct ConfiguracionProcesamiento {
+    int hilos; ///< Hilos que reparten los sensores (1 = en el hilo principal)
+};
+
+/**
+ * @struct ConfiguracionPersistencia
+ * @brief Dónde se guardan los sensores y las lecturas entre ejecuciones
+ */
+struct ConfiguracionPersistencia {
+    const char* instantanea; ///< Archivo de la instantánea (nullptr = no se guarda)
+    const char* diario;      ///< Directorio del diario de lecturas (nullptr = sin diario)
+    int intervaloDiarioMs;   ///< Espera máxima de un grupo del diario (0 = fdatasync por lectura)
+};
+
 // Prototipos de funciones
-int mostrarMenu();
-void crearSensorTemperatura(ListaGeneral& lista);
-void crearSensorPresion(ListaGeneral& lista);
-void leerDatosESP32(ListaGeneral& lista);
+int mostrarMenu(const ConfiguracionSerial& config);
+bool leerArgumentos(int argc, char* argv[], ConfiguracionSerial& config, ConfiguracionBitacora& bitacora,
+                    PoliticaRetencion& retencion, ConfiguracionPersistencia& persistencia,
+                    ConfiguracionProcesamiento& procesamiento);
+bool leerNivelBitacora(const char* texto, NivelBitacora& nivel);
+void crearSensorTemperatura(ListaGeneral& lista, const PoliticaRetencion& retencion);
+void crearSensorPresion(ListaGeneral& lista, const PoliticaRetencion& retencion);
+void leerDatosESP32(ListaGeneral& lista, const ConfiguracionSerial& config, const PoliticaRetencion& retencion,
+                    DiarioLecturas* diario);
+int reproducirCaptura(ListaGeneral& lista, const ConfiguracionSerial& config, const PoliticaRetencion& retencion,
+                      DiarioLecturas* diario);
+void imprimirResumenIngesta(const IngestaESP32& ingesta, const EnrutadorESP32& enrutador);
+void guardarAlSalir(ListaGeneral& lista, const ConfiguracionPersistencia& persistencia, DiarioLecturas& diario);
+void procesarEnParalelo(ListaGeneral& lista, PoolTrabajo& pool);
+void mostrarPuertos(const ConfiguracionSerial& config);
 void imprimirMensaje(const char* tipo, const char* mensaje);
 void limpiarBuffer();
 bool esEntradaValida();
 
 /**
- * @brief Lee datos en tiempo real desde el dispositivo ESP32
+ * @brief Lee datos en tiempo real desde uno o varios dispositivos ESP32
  * @param lista Referencia a la lista general de sensores
- * @post Lee datos del puerto COM6 durante 30 segundos y los registra en los sensores
+ * @param config Puertos y velocidad de la conexión serial
+ * @param retencion Historial de los sensores que se creen durante la lectura
+ * @param diario Diario abierto donde anotar cada lectura registrada (nullptr = sin diario)
+ * @post Lee datos de los puertos hasta que se presiona Enter, llega Ctrl+C
+ *       o todos los dispositivos cierran la conexión, y los registra en los sensores
  * 
- * Establece comunicación serial con ESP32, configura parámetros del puerto,
- * lee datos en formato CSV (TEMP,timestamp,valor o PRES,timestamp,valor)
- * y los registra en los sensores correspondientes
+ * Abre la fuente serial de la plataforma (Win32 o POSIX) de cada puerto,
+ * lee datos en formato CSV (TEMP,id,valor o PRES,id,valor) y los
+ * registra en el sensor indicado por el campo id, creándolo la primera
+ * vez que aparece. Un hilo lee todos los puertos y encola las lecturas
+ * interpretadas; otro las registra por lotes (ver IngestaESP32.h), así
+ * que imprimir o insertar en las listas no retrasa la lectura. Si algún
+ * puerto no abre, se lee de los demás.
  */
-void leerDatosESP32(ListaGeneral& lista) {
-    std::cout << "\n=== LECTURA DESDE ESP32 (COM6) ===" << std::endl;
+void leerDatosESP32(ListaGeneral& lista, const ConfiguracionSerial& config, const PoliticaRetencion& retencion,
+                    DiarioLecturas* diario) {
+    std::cout << "\n=== LECTURA DESDE ESP32 (";
+    mostrarPuertos(config);
+    std::cout << ") ===" << std::endl;
     std::cout << "Conectando con dispositivo IoT..." << std::endl;
     
-    HANDLE hSerial = CreateFileA("\\\\.\\COM6", GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    std::vector<std::unique_ptr<FuenteSerial> > abiertas;
+    std::vector<FuenteSerial*> fuentes;
+    for (std::size_t i = 0; i < config.puertos.size(); i++) {
+        std::unique_ptr<FuenteSerial> fuente(crearFuenteSerial(config.puertos[i], config.baudios));
+        if (!fuente->abrir()) {
+            std::cout << "[Error] No se pudo abrir " << config.puertos[i] << std::endl;
+            continue;
+        }
+        fuentes.push_back(fuente.get());
+        abiertas.push_back(std::move(fuente));
+    }
     
-    if (hSerial == INVALID_HANDLE_VALUE) {
-        imprimirMensaje("Error", "No se pudo conectar con ESP32 en COM6");
+    if (fuentes.empty()) {
+        imprimirMensaje("Error", "No se pudo conectar con ESP32");
         std::cout << "Verifica que:" << std::endl;
         std::cout << "1. La ESP32 este conectada por USB" << std::endl;
         std::cout << "2. Este programada con el codigo de sensores" << std::endl;
-        std::cout << "3. El puerto COM6 este disponible" << std::endl;
+        std::cout << "3. El puerto " << config.puertos[0] << " este disponible a " << config.baudios << " baudios" << std::endl;
         return;
     }
     
-    // Configurar puerto serial
-    DCB dcbSerialParams = {0};
-    dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
-    if (!GetCommState(hSerial, &dcbSerialParams)) {
-        imprimirMensaje("Error", "Error en configuracion serial");
-        CloseHandle(hSerial);
-        return;
+    if (fuentes.size() == 1) {
+        std::cout << "Conectado a ESP32" << std::endl;
+    } else {
+        std::cout << "Conectado a " << fuentes.size() << " puertos" << std::endl;
     }
-    
-    dcbSerialParams.BaudRate = 9600;
-    dcbSerialParams.ByteSize = 8;
-    dcbSerialParams.StopBits = ONESTOPBIT;
-    dcbSerialParams.Parity = NOPARITY;
-    
-    if (!SetCommState(hSerial, &dcbSerialParams)) {
-        imprimirMensaje("Error", "Error configurando puerto serial");
-        CloseHandle(hSerial);
-        return;
+    std::cout << "Leyendo datos; presione Enter (o Ctrl+C) para detener..." << std::endl;
+    if (retencion.acotada()) {
+        std::cout << "Historial por sensor nuevo: ultimas " << retencion.capacidadEfectiva() << " lecturas";
+        if (retencion.ventanaSegundos > 0.0) {
+            std::cout << " de los ultimos " << retencion.ventanaSegundos << " s";
+        }
+        std::cout << " (" << retencion.bytesPorSensor(sizeof(float)) << " bytes)" << std::endl;
+    } else if (retencion.comprimido) {
+        std::cout << "Historial por sensor nuevo: comprimido en bloques de "
+                  << HistorialComprimido<float>::TAMANIO_BLOQUE << " lecturas"
+                  << (retencion.serieTemporal ? ", con marcas de tiempo" : "") << std::endl;
+    } else if (retencion.serieTemporal) {
+        std::cout << "Historial por sensor nuevo: serie temporal";
+        if (retencion.horizonteSegundos > 0.0) {
+            std::cout << ", lecturas crudas de los ultimos " << retencion.horizonteSegundos << " s";
+        }
+        std::cout << std::endl;
+    } else if (retencion.indexado) {
+        std::cout << "Historial por sensor nuevo: indexado por valor" << std::endl;
     }
-    
-    // Configurar timeouts
-    COMMTIMEOUTS timeouts = {0};
-    timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
-    timeouts.ReadTotalTimeoutMultiplier = 10;
-    SetCommTimeouts(hSerial, &timeouts);
-    
-    std::cout << "Conectado a ESP32" << std::endl;
-    std::cout << "Leyendo datos por 30 segundos..." << std::endl;
     std::cout << "----------------------------------------" << std::endl;
     
-    char buffer[256];
-    DWORD bytesRead;
-    std::string datosAcumulados = "";
-    int lecturasRegistradas = 0;
+    EnrutadorESP32 enrutador(lista, retencion);
+    IngestaESP32 ingesta(fuentes, enrutador, 16384, diario);
+    InterrupcionConsola interrupcion;
+    std::cin.ignore(1000, '\n'); // resto de la línea de la opción
+    ingesta.iniciar();
     
-    // Crear sensores por defecto si no existen
-    if (lista.buscarSensor("T-001") == nullptr) {
-        SensorTemperatura* tempSensor = new SensorTemperatura("T-001");
-        lista.insertarSensor(tempSensor);
-        std::cout << "Sensor T-001 (Temperatura) creado" << std::endl;
-    }
-    if (lista.buscarSensor("P-001") == nullptr) {
-        SensorPresion* presSensor = new SensorPresion("P-001");
-        lista.insertarSensor(presSensor);
-        std::cout << "Sensor P-001 (Presion) creado" << std::endl;
-    }
-    
-    auto startTime = std::chrono::steady_clock::now();
-    
-    // Leer datos durante 30 segundos
-    while (std::chrono::steady_clock::now() - startTime < std::chrono::seconds(30)) {
-        if (ReadFile(hSerial, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-            buffer[bytesRead] = '\0';
-            datosAcumulados += buffer;
-            
-            // Procesar lineas completas
-            size_t pos;
-            while ((pos = datosAcumulados.find('\n')) != std::string::npos) {
-                std::string linea = datosAcumulados.substr(0, pos);
-                datosAcumulados = datosAcumulados.substr(pos + 1);
-                
-                // Limpiar retorno de carro si existe
-                if (!linea.empty() && linea.back() == '\r') {
-                    linea.pop_back();
-                }
-                
-                if (!linea.empty()) {
-                    std::cout << "[ESP32] " << linea << std::endl;
-                    
-                    // Procesar datos de temperatura
-                    if (linea.find("TEMP,") == 0) {
-                        size_t lastComma = linea.find_last_of(",");
-                        if (lastComma != std::string::npos) {
-                            std::string valorStr = linea.substr(lastComma + 1);
-                            try {
-                                float temp = std::stof(valorStr);
-                                SensorBase* sensor = lista.buscarSensor("T-001");
-                                if (sensor) {
-                                    SensorTemperatura* tempSensor = dynamic_cast<SensorTemperatura*>(sensor);
-                                    if (tempSensor) {
-                                        tempSensor->registrarLectura(temp);
-                                        std::cout << "Temperatura registrada: " << temp << std::endl;
-                                        lecturasRegistradas++;
-                                    }
-                                }
-                            } catch (const std::exception& e) {
-                                std::cout << "Error en dato de temperatura: " << valorStr << std::endl;
-                            }
-                        }
-                    }
-                    // Procesar datos de presion
-                    else if (linea.find("PRES,") == 0) {
-                        size_t lastComma = linea.find_last_of(",");
-                        if (lastComma != std::string::npos) {
-                            std::string valorStr = linea.substr(lastComma + 1);
-                            try {
-                                int pres = std::stoi(valorStr);
-                                SensorBase* sensor = lista.buscarSensor("P-001");
-                                if (sensor) {
-                                    SensorPresion* presSensor = dynamic_cast<SensorPresion*>(sensor);
-                                    if (presSensor) {
-                                        presSensor->registrarLectura(pres);
-                                        std::cout << "Presion registrada: " << pres << std::endl;
-                                        lecturasRegistradas++;
-                                    }
-                                }
-                            } catch (const std::exception& e) {
-                                std::cout << "Error en dato de presion: " << valorStr << std::endl;
-                            }
-                        }
-                    }
-                }
-            }
+    // Leer hasta Enter, Ctrl+C o hasta que todos los dispositivos cierren la conexion
+    bool entradaAbierta = true;
+    while (true) {
+        if (interrupcion.recibida()) {
+            imprimirMensaje("Info", "Lectura detenida con Ctrl+C");
+            break;
+        }
+        if (ingesta.lecturaTerminada()) {
+            imprimirMensaje("Advertencia", fuentes.size() == 1 ? "El dispositivo cerro la conexion"
+                                                               : "Todos los dispositivos cerraron la conexion");
+            break;
+        }
+        if (!entradaAbierta) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        } else if (hayEntradaConsola(100)) {
+            std::string linea;
+            if (std::getline(std::cin, linea)) break;
+            // Sin entrada estándar (por ejemplo, redirigida desde /dev/null) solo detiene Ctrl+C
+            std::cin.clear();
+            entradaAbierta = false;
         }
-        
-        Sleep(100);
     }
+    ingesta.detener();
+    Bitacora::vaciar();
     
-    CloseHandle(hSerial);
+    for (std::size_t i = 0; i < abiertas.size(); i++) abiertas[i]->cerrar();
     std::cout << "----------------------------------------" << std::endl;
-    std::cout << "Tiempo de lectura completado (30 segundos)" << std::endl;
-    std::cout << "Total de lecturas registradas: " << lecturasRegistradas << std::endl;
+    std::cout << "Lectura finalizada" << std::endl;
+    imprimirResumenIngesta(ingesta, enrutador);
     std::cout << "Conexion serial cerrada" << std::endl;
 }
 
+/**
+ * @brief Reproduce una captura de líneas del ESP32 y mide la ingesta
+ * @param lista Referencia a la lista general de sensores
+ * @param config Captura a reproducir, ritmo y baudios supuestos
+ * @param retencion Historial de los sensores que se creen durante la reproducción
+ * @param diario Diario abierto donde anotar cada lectura registrada (nullptr = sin diario)
+ * @return 0 si se reprodujo la captura, 1 si no se pudo abrir
+ *
+ * Usa la misma IngestaESP32 que leerDatosESP32, con una FuenteArchivo en
+ * lugar del puerto, y corre hasta el final del archivo. La latencia es
+ * el tiempo desde que el hilo lector recibe una línea hasta que el
+ * consumidor la aplica a su sensor.
+ */
+int reproducirCaptura(ListaGeneral& lista, const ConfiguracionSerial& config, const PoliticaRetencion& retencion,
+                      DiarioLecturas* diario) {
+    FuenteArchivo fuente(config.captura, config.ritmo, config.baudios);
+    if (!fuente.abrir()) {
+        imprimirMensaje("Error", "No se pudo abrir la captura (no existe o esta vacia)");
+        return 1;
+    }
+    std::cout << "\n=== REPRODUCCION DE " << config.captura << " (" << fuente.obtenerTamanio() << " bytes, "
+              << (config.ritmo ? "a ritmo grabado" : "sin pausas") << ") ===" << std::endl;
+
+    EnrutadorESP32 enrutador(lista, retencion);
+    IngestaESP32 ingesta(fuente, enrutador, 16384, diario);
+    // Sin ritmo se mide cuánto procesa el consumidor, así que no se descarta nada;
+    // a ritmo grabado la cola se comporta como con el puerto
+    ingesta.esperarSiColaLlena(!config.ritmo);
+    auto inicio = std::chrono::steady_clock::now();
+    ingesta.iniciar();
+    while (!ingesta.lecturaTerminada()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ingesta.detener();
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    Bitacora::vaciar();
+    fuente.cerrar();
+
+    const ContadoresIngesta& contadores = ingesta.obtenerContadores();
+    const HistogramaLatencia& latencias = ingesta.obtenerLatencias();
+    std::cout << "----------------------------------------" << std::endl;
+    imprimirResumenIngesta(ingesta, enrutador);
+    std::cout << "Duracion: " << segundos << " s" << std::endl;
+    std::cout << "Lineas/s: " << static_cast<long long>(contadores.lineas / segundos)
+              << "  Lecturas/s: " << static_cast<long long>(contadores.registradas / segundos) << std::endl;
+    std::cout << "Latencia (us): p50 " << latencias.percentil(0.50) / 1000.0
+              << "  p90 " << latencias.percentil(0.90) / 1000.0
+              << "  p99 " << latencias.percentil(0.99) / 1000.0
+              << "  p99.9 " << latencias.percentil(0.999) / 1000.0
+              << "  max " << latencias.maximo() / 1000.0 << std::endl;
+    std::cout << "Memoria maxima: " << memoriaMaximaKiB() << " KiB" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Imprime los contadores de una ingesta terminada
+ * @param ingesta Ingesta ya detenida
+ * @param enrutador Enrutador que usó la ingesta
+ */
+void imprimirResumenIngesta(const IngestaESP32& ingesta, const EnrutadorESP32& enrutador) {
+    const ContadoresIngesta& contadores = ingesta.obtenerContadores();
+    std::cout << "Total de lecturas registradas: " << contadores.registradas << std::endl;
+    std::cout << "Sensores distintos recibidos: " << enrutador.obtenerTamanio() << std::endl;
+    std::cout << "Lineas recibidas: " << contadores.lineas
+              << "  Errores de formato: " << contadores.erroresParseo
+              << "  Rechazadas: " << contadores.rechazadas << std::endl;
+    std::cout << "Cola: " << contadores.lotes << " lotes, profundidad maxima " << contadores.profundidadMaxima
+              << ", descartadas por cola llena " << contadores.descartadas << std::endl;
+    if (ingesta.obtenerPuertos() < 2) return;
+    for (std::size_t i = 0; i < ingesta.obtenerPuertos(); i++) {
+        const ContadoresPuerto& puerto = ingesta.obtenerContadoresPuerto(i);
+        std::cout << "  " << ingesta.obtenerRutaPuerto(i) << ": " << puerto.bytes << " bytes, " << puerto.lineas
+                  << " lineas, " << puerto.errores << " errores" << (puerto.cerrado ? " (cerrado)" : "") << std::endl;
+    }
+}
+
+/**
+ * @brief Procesa todos los sensores con el pool e informa los tiempos
+ * @param lista Lista general de sensores
+ * @param pool Hilos de procesamiento
+ *
+ * Después de la salida de cada sensor (en el orden de la lista) muestra
+ * el tiempo total, la suma de los tiempos por sensor (lo que habría
+ * tardado un solo hilo) y el sensor más lento.
+ */
+void procesarEnParalelo(ListaGeneral& lista, PoolTrabajo& pool) {
+    std::vector<long long> tiempos;
+    long robosAntes = pool.obtenerRobos();
+    auto inicio = std::chrono::steady_clock::now();
+    lista.procesarTodos(pool, &tiempos);
+    double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+
+    long long suma = 0;
+    std::size_t lento = 0;
+    for (std::size_t i = 0; i < tiempos.size(); i++) {
+        suma += tiempos[i];
+        if (tiempos[i] > tiempos[lento]) lento = i;
+    }
+    std::cout << "----------------------------------------" << std::endl;
+    std::cout << tiempos.size() << " sensores en " << total << " ms con " << pool.obtenerParticipantes()
+              << " hilos (" << pool.obtenerRobos() - robosAntes << " robos); suma por sensor "
+              << suma / 1e6 << " ms" << std::endl;
+    if (!tiempos.empty()) {
+        ListaGeneral::iterator sensor = lista.begin();
+        std::advance(sensor, lento);
+        std::cout << "Sensor mas lento: " << (*sensor)->obtenerNombre() << " (" << tiempos[lento] / 1e6 << " ms)" << std::endl;
+    }
+}
+
+/**
+ * @brief Cierra el diario y guarda la instantánea, si se pidió
+ * @param lista Lista general de sensores
+ * @param persistencia Instantánea y diario configurados
+ * @param diario Diario a cerrar
+ * @post Si la instantánea se guardó, el diario queda vacío
+ */
+void guardarAlSalir(ListaGeneral& lista, const ConfiguracionPersistencia& persistencia, DiarioLecturas& diario) {
+    diario.cerrar();
+    if (persistencia.instantanea == nullptr) return;
+    if (guardarInstantanea(lista, persistencia.instantanea)) {
+        std::cout << "Sensores guardados en " << persistencia.instantanea << std::endl;
+        // La instantánea ya contiene todo lo anotado en el diario
+        if (persistencia.diario != nullptr) descartarDiario(persistencia.diario);
+    } else {
+        imprimirMensaje("Error", "No se pudo guardar la instantanea");
+    }
+}
+
 /**
  * @brief Función principal del programa
- * @return 0 si el programa termina correctamente
+ * @param argc Número de argumentos
+ * @param argv Argumentos (ver uso al inicio del archivo)
+ * @return 0 si el programa termina correctamente, 1 si los argumentos son inválidos
+ *         o no se pudo abrir la captura a reproducir
  * 
  * Inicializa el sistema, muestra el menú principal y gestiona el flujo
  * del programa mediante un ciclo que permite crear sensores, leer datos
  * desde ESP32 y procesar información
  */
-int main() {
+int main(int argc, char* argv[]) {
+    ConfiguracionSerial config = { std::vector<const char*>(), 9600, nullptr, false };
+    ConfiguracionBitacora bitacora = { BITACORA_DEPURACION, false };
+    ConfiguracionProcesamiento procesamiento = { 1 };
+    PoliticaRetencion retencion;
+    ConfiguracionPersistencia persistencia = { nullptr, nullptr, 10 };
+    if (!leerArgumentos(argc, argv, config, bitacora, retencion, persistencia, procesamiento)) {
+        std::cout << "Uso: " << argv[0] << " [--puerto RUTA]... [--baudios N] [--bitacora NIVEL] [--bitacora-asincrona]"
+                  << " [--retencion N] [--ventana SEGUNDOS] [--serie-temporal] [--horizonte SEGUNDOS]"
+                  << " [--comprimido] [--indexado] [--instantanea ARCHIVO] [--diario DIRECTORIO] [--diario-intervalo MS]"
+                  << " [--reproducir CAPTURA [--ritmo]] [--hilos N]" << std::endl;
+        std::cout << "NIVEL: depuracion, info, advertencia, error o apagada" << std::endl;
+        return 1;
+    }
+    if (config.puertos.empty()) config.puertos.push_back(puertoSerialPorDefecto());
+
+    // El sumidero se declara antes que la lista para que siga vivo
+    // mientras la lista registra la liberación de los sensores
+    Bitacora::establecerNivel(bitacora.nivel);
+    std::unique_ptr<SumideroAsincrono> sumideroAsincrono;
+    if (bitacora.asincrona) {
+        sumideroAsincrono.reset(new SumideroAsincrono());
+    }
+    SumideroInstalado instalacion(sumideroAsincrono.get());
+
     ListaGeneral listaSensores;
+    std::unique_ptr<PoolTrabajo> pool;
+    if (procesamiento.hilos > 1) {
+        pool.reset(new PoolTrabajo(static_cast<unsigned>(procesamiento.hilos)));
+    }
     int opcion = 0;
     
     std::cout << "=== SISTEMA IoT DE MONITOREO POLIMORFICO ===" << std::endl;
+    if (persistencia.instantanea != nullptr) {
+        auto inicioCarga = std::chrono::steady_clock::now();
+        int cargados = 0;
+        if (cargarInstantanea(persistencia.instantanea, listaSensores, cargados)) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicioCarga).count();
+            std::cout << "Instantanea " << persistencia.instantanea << ": " << cargados << " sensores cargados en "
+                      << ms << " ms" << std::endl;
+        }
+    }
+    DiarioLecturas diario;
+    if (persistencia.diario != nullptr) {
+        EnrutadorESP32 enrutador(listaSensores, retencion);
+        long reproducidas = reproducirDiario(persistencia.diario, enrutador);
+        if (reproducidas > 0) {
+            std::cout << "Diario " << persistencia.diario << ": " << reproducidas << " lecturas recuperadas" << std::endl;
+        }
+        ModoDiario modo = persistencia.intervaloDiarioMs > 0 ? DIARIO_AGRUPADO : DIARIO_POR_REGISTRO;
+        if (!diario.abrir(persistencia.diario, modo, persistencia.intervaloDiarioMs)) {
+            imprimirMensaje("Error", "No se pudo abrir el diario; las lecturas no se anotaran");
+        }
+    }
+    if (config.captura != nullptr) {
+        int resultado = reproducirCaptura(listaSensores, config, retencion, persistencia.diario != nullptr ? &diario : nullptr);
+        if (resultado == 0) guardarAlSalir(listaSensores, persistencia, diario);
+        return resultado;
+    }
     
     do {
-        opcion = mostrarMenu();
+        opcion = mostrarMenu(config);
         
         if (!esEntradaValida()) {
             imprimirMensaje("Advertencia", "Ingrese un numero valido");
@@ -199,21 +451,26 @@ int main() {
         
         switch(opcion) {
             case 1:
-                crearSensorTemperatura(listaSensores);
+                crearSensorTemperatura(listaSensores, retencion);
                 break;
             case 2:
-                crearSensorPresion(listaSensores);
+                crearSensorPresion(listaSensores, retencion);
                 break;
             case 3:
-                leerDatosESP32(listaSensores);
+                leerDatosESP32(listaSensores, config, retencion, persistencia.diario != nullptr ? &diario : nullptr);
                 break;
             case 4:
                 listaSensores.mostrarTodos();
                 break;
             case 5:
-                listaSensores.procesarTodos();
+                if (pool) {
+                    procesarEnParalelo(listaSensores, *pool);
+                } else {
+                    listaSensores.procesarTodos();
+                }
                 break;
             case 6:
+                guardarAlSalir(listaSensores, persistencia, diario);
                 imprimirMensaje("Info", "Saliendo y liberando memoria...");
                 break;
             default:
@@ -227,18 +484,105 @@ int main() {
     return 0;
 }
 
+/**
+ * @brief Interpreta los argumentos de línea de comandos
+ * @param argc Número de argumentos
+ * @param argv Argumentos recibidos
+ * @param config Configuración serial a completar
+ * @param bitacora Configuración de la bitácora a completar
+ * @param retencion Política de retención a completar
+ * @param persistencia Instantánea y diario a completar
+ * @param procesamiento Hilos del procesamiento a completar
+ * @return true si todos los argumentos son válidos
+ */
+bool leerArgumentos(int argc, char* argv[], ConfiguracionSerial& config, ConfiguracionBitacora& bitacora,
+                    PoliticaRetencion& retencion, ConfiguracionPersistencia& persistencia,
+                    ConfiguracionProcesamiento& procesamiento) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--puerto") == 0 && i + 1 < argc) {
+            config.puertos.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--baudios") == 0 && i + 1 < argc) {
+            config.baudios = std::atoi(argv[++i]);
+            if (config.baudios <= 0) return false;
+        } else if (std::strcmp(argv[i], "--bitacora") == 0 && i + 1 < argc) {
+            if (!leerNivelBitacora(argv[++i], bitacora.nivel)) return false;
+        } else if (std::strcmp(argv[i], "--bitacora-asincrona") == 0) {
+            bitacora.asincrona = true;
+        } else if (std::strcmp(argv[i], "--retencion") == 0 && i + 1 < argc) {
+            retencion.capacidad = std::atoi(argv[++i]);
+            if (retencion.capacidad <= 0) return false;
+        } else if (std::strcmp(argv[i], "--ventana") == 0 && i + 1 < argc) {
+            retencion.ventanaSegundos = std::atof(argv[++i]);
+            if (retencion.ventanaSegundos <= 0.0) return false;
+        } else if (std::strcmp(argv[i], "--serie-temporal") == 0) {
+            retencion.serieTemporal = true;
+        } else if (std::strcmp(argv[i], "--horizonte") == 0 && i + 1 < argc) {
+            retencion.serieTemporal = true;
+            retencion.horizonteSegundos = std::atof(argv[++i]);
+            if (retencion.horizonteSegundos <= 0.0) return false;
+        } else if (std::strcmp(argv[i], "--comprimido") == 0) {
+            retencion.comprimido = true;
+        } else if (std::strcmp(argv[i], "--indexado") == 0) {
+            retencion.indexado = true;
+        } else if (std::strcmp(argv[i], "--instantanea") == 0 && i + 1 < argc) {
+            persistencia.instantanea = argv[++i];
+        } else if (std::strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            persistencia.diario = argv[++i];
+        } else if (std::strcmp(argv[i], "--diario-intervalo") == 0 && i + 1 < argc) {
+            persistencia.intervaloDiarioMs = std::atoi(argv[++i]);
+            if (persistencia.intervaloDiarioMs < 0) return false;
+        } else if (std::strcmp(argv[i], "--reproducir") == 0 && i + 1 < argc) {
+            config.captura = argv[++i];
+        } else if (std::strcmp(argv[i], "--ritmo") == 0) {
+            config.ritmo = true;
+        } else if (std::strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            procesamiento.hilos = std::atoi(argv[++i]);
+            if (procesamiento.hilos <= 0) return false;
+        } else {
+            return false;
+        }
+    }
+    // --comprimido con --serie-temporal es un solo historial (comprimido con marcas), sin compactación
+    bool serieComprimida = retencion.comprimido && retencion.serieTemporal;
+    int historiales = (retencion.acotada() ? 1 : 0) + (retencion.serieTemporal && !serieComprimida ? 1 : 0) +
+                      (retencion.comprimido ? 1 : 0) + (retencion.indexado ? 1 : 0);
+    if (serieComprimida && retencion.horizonteSegundos > 0.0) return false;
+    return historiales <= 1 && (!config.ritmo || config.captura != nullptr);
+}
+
+/**
+ * @brief Convierte el nombre de un nivel de bitácora
+ * @param texto Nombre del nivel
+ * @param nivel Nivel resultante
+ * @return true si el nombre es válido
+ */
+bool leerNivelBitacora(const char* texto, NivelBitacora& nivel) {
+    const char* nombres[] = { "depuracion", "info", "advertencia", "error", "apagada" };
+    for (int i = 0; i < 5; i++) {
+        if (std::strcmp(texto, nombres[i]) == 0) {
+            nivel = static_cast<NivelBitacora>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Muestra el menú principal y obtiene la opción del usuario
+ * @param config Configuración serial (se muestra el puerto en la opción 3)
  * @return Opción seleccionada por el usuario
  * 
  * Presenta las opciones disponibles del sistema y lee la selección
  */
-int mostrarMenu() {
+int mostrarMenu(const ConfiguracionSerial& config) {
     int opcion;
+    Bitacora::vaciar(); // que los mensajes pendientes salgan antes del menú
     std::cout << "\n--- MENU PRINCIPAL ---" << std::endl;
     std::cout << "1. Crear Sensor de Temperatura" << std::endl;
     std::cout << "2. Crear Sensor de Presion" << std::endl;
-    std::cout << "3. Leer Datos desde ESP32 (COM6)" << std::endl;
+    std::cout << "3. Leer Datos desde ESP32 (";
+    mostrarPuertos(config);
+    std::cout << ")" << std::endl;
     std::cout << "4. Mostrar Informacion de Sensores" << std::endl;
     std::cout << "5. Procesar Todas las Lecturas" << std::endl;
     std::cout << "6. Salir y Liberar Memoria" << std::endl;
@@ -250,27 +594,37 @@ int mostrarMenu() {
 /**
  * @brief Crea un nuevo sensor de temperatura y lo agrega a la lista
  * @param lista Referencia a la lista general de sensores
+ * @param retencion Historial del sensor (lista sin límite o circular)
  * @post Crea un sensor de temperatura con el nombre especificado por el usuario
  */
-void crearSensorTemperatura(ListaGeneral& lista) {
+void crearSensorTemperatura(ListaGeneral& lista, const PoliticaRetencion& retencion) {
     char nombre[50];
     std::cout << "Ingrese nombre del sensor temperatura: ";
     std::cin >> nombre;
-    SensorTemperatura* tempSensor = new SensorTemperatura(nombre);
-    lista.insertarSensor(tempSensor);
+    crearSensorTemperaturaEn(lista, nombre, retencion);
 }
 
 /**
  * @brief Crea un nuevo sensor de presión y lo agrega a la lista
  * @param lista Referencia a la lista general de sensores
+ * @param retencion Historial del sensor (lista sin límite o circular)
  * @post Crea un sensor de presión con el nombre especificado por el usuario
  */
-void crearSensorPresion(ListaGeneral& lista) {
+void crearSensorPresion(ListaGeneral& lista, const PoliticaRetencion& retencion) {
     char nombre[50];
     std::cout << "Ingrese nombre del sensor presion: ";
     std::cin >> nombre;
-    SensorPresion* presSensor = new SensorPresion(nombre);
-    lista.insertarSensor(presSensor);
+    crearSensorPresionEn(lista, nombre, retencion);
+}
+
+/**
+ * @brief Muestra el primer puerto configurado y cuántos más hay
+ * @param config Configuración serial
+ */
+void mostrarPuertos(const ConfiguracionSerial& config) {
+    std::cout << config.puertos[0];
+    std::size_t otros = config.puertos.size() - 1;
+    if (otros > 0) std::cout << " y " << otros << (otros == 1 ? " puerto mas" : " puertos mas");
 }
 
 /**